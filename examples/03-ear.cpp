@@ -4,9 +4,11 @@
 #include <gmt/vec.hpp>
 #include <gmt/polygon.hpp>
 #include <gmt/algorithm.hpp>
+#include <gmt/algorithm/ear-clipping.hpp>
 
 class ear : public gmt::plotter {
 	gmt::polygon2d poly;
+	bool show_triangles = false;
 public:
 
 	ear ()
@@ -29,6 +31,9 @@ public:
 			case GLFW_KEY_C:
 				poly.clear();
 				break;
+			case GLFW_KEY_T:
+				show_triangles = !show_triangles;
+				break;
 			}
 		}
 	}
@@ -55,6 +60,18 @@ public:
 	{
 		clear();
 
+		if(show_triangles){
+			auto mesh = gmt::ear_clipping_triangulation(poly);
+
+			color(plotter::gray);
+			for(std::size_t i=0; i<mesh.size(); i++){
+				begin(GL_LINE_LOOP);
+				for(const auto& p : mesh.corners(i))
+					plot(p);
+				end();
+			}
+		}
+
 		begin(GL_LINE_LOOP);
 		for(std::size_t i=0; i<poly.size(); i++){
 			if(gmt::is_ear(poly, i))
@@ -125,7 +125,7 @@ public:
 			mpos.y() = (mpos.y() < 0)? 0.0 : mpos.y();
 			mpos.y() = (mpos.y() > winsiz.height)? winsiz.height : mpos.y();
 
-			gmt::polygon2d visibility = gmt::polygon_visibility(
+			gmt::polygon2d visibility = gmt::polygon_visibility_sweep(
 					mpos,
 					poly_list);
 
@@ -5,12 +5,12 @@
 #include <gmt/graphics/ui_component/exit_component.hpp>
 #include <gmt/graphics/ui_component/pan_component.hpp>
 #include <gmt/graphics/ui_component/zoom_component.hpp>
-#include <gmt/algorithm/convex-hull.hpp>
+#include <gmt/algorithm/dynamic-hull.hpp>
 
 class convex_hull : public gmt::composable_ui{
 protected:
 	std::list<gmt::point2d> points;
-	gmt::polygon2d ch;
+	gmt::dynamic_hull2d ch;
 
 public:
 	convex_hull()
@@ -49,7 +49,7 @@ public:
 			gmt::point2d m = get_mouse_point();
 			points.push_back(m);
 
-			ch = gmt::merge_hull(points);
+			ch.insert(m);
 		}
 	}
 
@@ -62,8 +62,7 @@ public:
 			auto p = get_random_point();
 			points.push_back(p);
 
-			if(points.size() >= 3)
-				ch = gmt::merge_hull(points);
+			ch.insert(p);
 		}
 	}
 
@@ -71,13 +70,13 @@ public:
 	{
 		clear();
 
-		if(ch.size()){
+		if(ch.n_vertices()){
 			color(blue);
-			plot(ch, GL_LINE_LOOP);
+			plot(ch.hull(), GL_LINE_LOOP);
 			color(white);
 			plot(points, GL_POINTS);
 			color(green);
-			plot(ch, GL_POINTS);
+			plot(ch.hull(), GL_POINTS);
 		}else{
 			color(white);
 			plot(points, GL_POINTS);
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gmt/algorithm/convex-hull.hpp>
+
+/*
+ * seconds taken by the best of `runs` calls of `f`
+ */
+template<typename function>
+double best_of(size_t runs, const function& f)
+{
+	double best = 0.0;
+
+	for(size_t i=0; i<runs; i++){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<double> t =
+			std::chrono::steady_clock::now() - start;
+
+		if(i == 0 || t.count() < best)
+			best = t.count();
+	}
+
+	return best;
+}
+
+/*
+ * checks whether `a` and `b` have the same vertices in the same cyclic
+ * order
+ */
+bool same_polygon(const gmt::polygon2d& a, const gmt::polygon2d& b)
+{
+	if(a.size() != b.size())
+		return false;
+
+	if(a.empty())
+		return true;
+
+	for(size_t shift=0; shift<b.size(); shift++){
+		bool equal = true;
+
+		for(size_t i=0; i<a.size() && equal; i++)
+			equal = a[i] == b[(i + shift)%b.size()];
+
+		if(equal)
+			return true;
+	}
+
+	return false;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t max_points = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+	const size_t runs = 3;
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+	std::cout << "points\tdivide_and_conquer_hull\tmonotone_chain_hull"
+		<< "\tparallel_hull (" << gmt::default_thread_pool().size()
+		<< " threads)\tchan_hull\tspeedup\n";
+
+	for(size_t n=1000; n<=max_points; n *= 10){
+		std::vector<gmt::point2d> points(n);
+		for(auto& p : points)
+			p = gmt::point2d{ uniform(rng), uniform(rng) };
+
+		gmt::polygon2d a, b, c, d;
+
+		double t_dc = best_of(runs, [&]{
+			a = gmt::divide_and_conquer_hull(points);
+		});
+
+		double t_mc = best_of(runs, [&]{
+			b = gmt::monotone_chain_hull(points);
+		});
+
+		double t_p = best_of(runs, [&]{
+			c = gmt::parallel_hull(points);
+		});
+
+		double t_chan = best_of(runs, [&]{
+			d = gmt::chan_hull(points);
+		});
+
+		if(!same_polygon(a, b) || b != c || b != d){
+			std::cerr << "the hulls of " << n << " points differ\n";
+			return EXIT_FAILURE;
+		}
+
+		std::cout << n << '\t' << t_dc << '\t' << t_mc << '\t' << t_p
+			<< '\t' << t_chan << '\t'
+			<< t_dc/std::min({ t_mc, t_p, t_chan }) << '\n';
+	}
+
+	return EXIT_SUCCESS;
+}
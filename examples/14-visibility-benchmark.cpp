@@ -0,0 +1,127 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gmt/pi.hpp>
+#include <gmt/algorithm/polygon-visibility.hpp>
+
+/*
+ * seconds taken by the best of `runs` calls of `f`
+ */
+template<typename function>
+double best_of(size_t runs, const function& f)
+{
+	double best = 0.0;
+
+	for(size_t i=0; i<runs; i++){
+		auto start = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<double> t =
+			std::chrono::steady_clock::now() - start;
+
+		if(i == 0 || t.count() < best)
+			best = t.count();
+	}
+
+	return best;
+}
+
+/*
+ * a square room of `cells` by `cells` cells, each one with a noisy star
+ * of `n` vertices around its center
+ */
+std::vector<gmt::polygon2d> scene(std::mt19937& rng, size_t cells, size_t n)
+{
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	const double w = double(cells);
+
+	std::vector<gmt::polygon2d> rings{
+		gmt::polygon2d{
+			gmt::point2d{ -0.1, -0.1 }, gmt::point2d{ w + 0.1, -0.1 },
+			gmt::point2d{ w + 0.1, w + 0.1 }, gmt::point2d{ -0.1, w + 0.1 } } };
+
+	for(size_t i=0; i<cells; i++){
+		for(size_t j=0; j<cells; j++){
+			gmt::polygon2d star;
+
+			for(size_t k=0; k<n; k++){
+				double a = 2.0*gmt::pi*(double(k) + 0.3*uniform(rng))/double(n);
+				double r = 0.35*(1.0 - 0.6*uniform(rng));
+				star.push_back(gmt::point2d{ i + 0.5 + r*std::cos(a), j + 0.5 + r*std::sin(a) });
+			}
+
+			rings.push_back(star);
+		}
+	}
+
+	return rings;
+}
+
+int main(int argc, char* argv[])
+{
+	size_t max_vertices = (argc > 1) ? std::stoul(argv[1]) : 100000;
+	const size_t star_size = 32;
+	const size_t n_queries = 20;
+	const size_t runs = 3;
+
+	/*
+	 * the ray casting of `polygon_visibility` is quadratic, it is only
+	 * timed up to this size and for the first queries
+	 */
+	const size_t max_ray_casting = 20000;
+	const size_t n_ray_queries = 3;
+
+	std::mt19937 rng(42);
+
+	std::cout << "vertices\tpolygon_visibility (ms)\tvisibility_sweep (ms)\tspeedup\n";
+
+	for(size_t target=1000; target<=max_vertices; target *= 10){
+		size_t cells = size_t(std::ceil(std::sqrt(double(target)/double(star_size))));
+		std::vector<gmt::polygon2d> rings = scene(rng, cells, star_size);
+
+		size_t n = 0;
+		for(const auto& ring : rings)
+			n += ring.size();
+
+		/*
+		 * corners of the cells, out of their stars
+		 */
+		std::vector<gmt::point2d> points;
+		for(size_t q=0; q<n_queries; q++)
+			points.push_back(gmt::point2d{
+				double(rng()%cells) + 0.5 + ((rng()%2) ? 0.49 : -0.49),
+				double(rng()%cells) + 0.5 + ((rng()%2) ? 0.49 : -0.49) });
+
+		gmt::visibility_sweep<double> sweep;
+		gmt::polygon2d visibility;
+
+		double t_sweep = best_of(runs, [&]{
+			for(const auto& p : points)
+				sweep.compute(p, rings, visibility);
+		})/double(n_queries);
+
+		if(visibility.size() < 3){
+			std::cerr << "the visibility polygon of " << n << " vertices is empty\n";
+			return EXIT_FAILURE;
+		}
+
+		std::cout << n << '\t';
+
+		if(n <= max_ray_casting){
+			double t_rays = best_of(1, [&]{
+				for(size_t q=0; q<n_ray_queries; q++)
+					visibility = gmt::polygon_visibility(points[q], rings);
+			})/double(n_ray_queries);
+
+			std::cout << 1e3*t_rays << '\t' << 1e3*t_sweep << '\t' << t_rays/t_sweep << '\n';
+		}else{
+			std::cout << "-\t" << 1e3*t_sweep << "\t-\n";
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -7,9 +7,13 @@
 
 #include <gmt/algorithm/misc.hpp>
 #include <gmt/algorithm/direction.hpp>
+#include <gmt/algorithm/batch-direction.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
 #include <gmt/algorithm/intersection.hpp>
 #include <gmt/algorithm/distance.hpp>
 #include <gmt/algorithm/linear-algebra.hpp>
 #include <gmt/algorithm/polygon-visibility.hpp>
 #include <gmt/algorithm/point-in-polygon.hpp>
+#include <gmt/algorithm/point-locator.hpp>
+#include <gmt/algorithm/batch-point-in-polygon.hpp>
 #include <gmt/algorithm/polygon-refolding.hpp>
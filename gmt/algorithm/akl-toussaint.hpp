@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/point-buffer.hpp>
+
+namespace gmt {
+
+/**
+  * number of points from which the convex hulls discard the points
+  * inside the Akl-Toussaint octagon before sorting, by default
+  */
+constexpr size_t akl_toussaint_cutoff = size_t(1) << 10;
+
+/**
+  * Octagon of the extreme points of a set in the directions of the axes
+  * and of the diagonals, for the Akl-Toussaint heuristic: a point
+  * strictly inside the octagon is strictly inside the convex hull of the
+  * set, so it is not a vertex of the hull and can be discarded before
+  * the hull is computed.
+  *
+  * The vertices are points of the set, in counterclockwise order. The
+  * test of a point is branchless, with a fixed number of edges, and it
+  * errs only to the side of keeping a point: the directions are
+  * computed in floating-point and a point is inside only when it is
+  * farther from every edge than the rounding error bound of the edge.
+  */
+class akl_toussaint_octagon {
+public:
+	static constexpr size_t n_edges = 8;
+
+	/**
+	  * octagon of the points `(x(i), y(i))`, for `i` in `[0, n)`, found in
+	  * one pass
+	  */
+	template<typename x_axis, typename y_axis>
+	static akl_toussaint_octagon of(
+		size_t n,
+		const x_axis& x,
+		const y_axis& y)
+	{
+		akl_toussaint_octagon o;
+		if(n == 0)
+			return o;
+
+		/*
+		 * the extremes in counterclockwise order of their directions:
+		 * -x, -x-y, -y, x-y, x, x+y, y, y-x
+		 */
+		size_t arg[n_edges] = {};
+		double best[n_edges];
+
+		const double x0 = double(x(0));
+		const double y0 = double(y(0));
+		best[0] = -x0; best[1] = -x0 - y0; best[2] = -y0; best[3] = x0 - y0;
+		best[4] = x0; best[5] = x0 + y0; best[6] = y0; best[7] = y0 - x0;
+
+		for(size_t i=1; i<n; i++){
+			const double px = double(x(i));
+			const double py = double(y(i));
+			const double value[n_edges] = {
+				-px, -px - py, -py, px - py, px, px + py, py, py - px
+			};
+
+			for(size_t k=0; k<n_edges; k++){
+				if(value[k] > best[k]){
+					best[k] = value[k];
+					arg[k] = i;
+				}
+			}
+		}
+
+		/*
+		 * every point is in the box of the extremes, the sides of the box
+		 * bound the differences between a point and a vertex
+		 */
+		const double width = best[4] + best[0];
+		const double height = best[6] + best[2];
+
+		double vx[n_edges], vy[n_edges];
+		size_t m = 0;
+
+		for(size_t k=0; k<n_edges; k++){
+			const double px = double(x(arg[k]));
+			const double py = double(y(arg[k]));
+
+			if(m && vx[m - 1] == px && vy[m - 1] == py)
+				continue;
+
+			vx[m] = px;
+			vy[m] = py;
+			m++;
+		}
+
+		while(m > 1 && vx[m - 1] == vx[0] && vy[m - 1] == vy[0])
+			m--;
+
+		if(m < 3)
+			return o;
+
+		/*
+		 * the same bound of the floating-point filter of the orientation,
+		 * with a margin
+		 */
+		const double epsilon = 8*std::numeric_limits<double>::epsilon();
+
+		for(size_t k=0; k<m; k++){
+			const size_t next = (k + 1 == m) ? 0 : k + 1;
+
+			o.m_x[k] = vx[k];
+			o.m_y[k] = vy[k];
+			o.m_dx[k] = vx[next] - vx[k];
+			o.m_dy[k] = vy[next] - vy[k];
+			o.m_bound[k] = epsilon*(std::fabs(o.m_dx[k])*height + std::fabs(o.m_dy[k])*width);
+		}
+
+		o.m_size = m;
+		return o;
+	}
+
+	/**
+	  * number of distinct vertices, the octagon discards nothing when it
+	  * has less than three
+	  */
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	/**
+	  * whether `(x, y)` is strictly inside the octagon and farther than
+	  * the rounding errors from its edges
+	  */
+	bool inside(double x, double y) const noexcept
+	{
+		bool in = true;
+
+		for(size_t k=0; k<n_edges; k++)
+			in &= m_dx[k]*(y - m_y[k]) - m_dy[k]*(x - m_x[k]) > m_bound[k];
+
+		return in;
+	}
+
+private:
+	/*
+	 * the edges after the last vertex have no length and a negative
+	 * bound, every point passes them
+	 */
+	double m_x[n_edges] = {};
+	double m_y[n_edges] = {};
+	double m_dx[n_edges] = {};
+	double m_dy[n_edges] = {};
+	double m_bound[n_edges] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+	size_t m_size = 0;
+};
+
+/**
+  * Akl-Toussaint filter in place: the points of `[points, points + n)`
+  * that are strictly inside the octagon of their extremes are discarded
+  * and the others are moved to the front, in their order. The convex
+  * hull of the points that remain is the same of all the points.
+  *
+  * @return the number of points that remain
+  */
+template<typename T>
+size_t akl_toussaint_filter(point<T, 2>* points, size_t n)
+{
+	auto o = akl_toussaint_octagon::of(
+		n,
+		[points](size_t i){ return points[i].x(); },
+		[points](size_t i){ return points[i].y(); }
+	);
+
+	if(o.size() < 3)
+		return n;
+
+	size_t kept = 0;
+	for(size_t i=0; i<n; i++){
+		bool in = o.inside(double(points[i].x()), double(points[i].y()));
+
+		points[kept] = points[i];
+		kept += !in;
+	}
+
+	return kept;
+}
+
+/**
+  * points of the collection `points` that are not strictly inside the
+  * octagon of their extremes
+  *
+  * @see akl_toussaint_filter
+  */
+template<typename list_container>
+auto akl_toussaint_filter(const list_container& points)
+	-> std::vector<point<typename list_container::value_type::value_type, 2>>
+{
+	typedef typename list_container::value_type::value_type T;
+
+	std::vector<point<T, 2>> kept(points.begin(), points.end());
+	kept.resize(akl_toussaint_filter(kept.data(), kept.size()));
+
+	return kept;
+}
+
+/*
+ * calls `f(i)` for every point `i` of the columns `x` and `y` that is not
+ * strictly inside the octagon of the points. The points are tested in
+ * blocks, in a loop without branches over the columns, and the kept ones
+ * are visited after each block.
+ */
+template<typename visitor>
+void akl_toussaint_visit(
+	const double* x,
+	const double* y,
+	size_t n,
+	const visitor& f)
+{
+	auto o = akl_toussaint_octagon::of(
+		n,
+		[x](size_t i){ return x[i]; },
+		[y](size_t i){ return y[i]; }
+	);
+
+	if(o.size() < 3){
+		for(size_t i=0; i<n; i++)
+			f(i);
+		return;
+	}
+
+	constexpr size_t block = 256;
+	bool in[block];
+
+	for(size_t first=0; first<n; first += block){
+		const size_t count = std::min(block, n - first);
+
+		for(size_t k=0; k<count; k++)
+			in[k] = o.inside(x[first + k], y[first + k]);
+
+		for(size_t k=0; k<count; k++)
+			if(!in[k])
+				f(first + k);
+	}
+}
+
+/**
+  * points of the buffer that are not strictly inside the octagon of
+  * their extremes, read from the columns
+  *
+  * @see akl_toussaint_filter
+  */
+inline point_buffer2d akl_toussaint_filter(const point_buffer2d& points)
+{
+	const double* x = points.x();
+	const double* y = points.y();
+
+	point_buffer2d kept;
+	akl_toussaint_visit(x, y, points.size(), [&](size_t i){
+		kept.push_back(point2d{ x[i], y[i] });
+	});
+
+	return kept;
+}
+
+}
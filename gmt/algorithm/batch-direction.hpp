@@ -0,0 +1,649 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+
+#include <gmt/point.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/algorithm/direction-type.hpp>
+
+/*
+ * the vectorized kernels are only built for x86 with a GCC compatible
+ * compiler, defining GMT_NO_SIMD forces the scalar kernel everywhere
+ */
+#if !defined(GMT_NO_SIMD) \
+	&& (defined(__x86_64__) || defined(__i386__)) \
+	&& (defined(__GNUC__) || defined(__clang__))
+#define GMT_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace gmt {
+
+/**
+  * direction packed in one byte, it holds the values of `direction`, i.e.,
+  * LEFT, RIGHT or ON
+  */
+typedef std::uint8_t packed_direction;
+
+/**
+  * number of points the batch functions that read array-of-structures
+  * input convert to columns at a time
+  */
+constexpr std::size_t direction_block = 256;
+
+/**
+  * instruction sets the batch direction kernel can run with
+  */
+typedef enum simd_isa {
+	SCALAR,
+	SSE2,
+	AVX2,
+	AVX512
+} simd_isa;
+
+namespace simd {
+
+/*
+ * one of the three points of the direction test: either a column of
+ * coordinates or a single point broadcast to every lane
+ */
+typedef struct direction_operand {
+	const double* x;
+	const double* y;
+	bool broadcast;
+} direction_operand;
+
+/*
+ * computes the direction of c[i] in reference of the segment of a[i] and
+ * b[i] for i in [0, n), a lane is ON when the absolute value of the cross
+ * product is not greater than e + r*(|v0x*v1y| + |v0y*v1x|)
+ */
+typedef void (*direction_kernel)(
+	direction_operand a,
+	direction_operand b,
+	direction_operand c,
+	std::size_t n,
+	double e,
+	double r,
+	packed_direction* out);
+
+inline packed_direction pack_direction(double cross, double e)
+{
+	if(std::fabs(cross) <= e)
+		return ON;
+	else if(cross < 0.0)
+		return RIGHT;
+	else
+		return LEFT;
+}
+
+inline void direction_kernel_scalar(
+	direction_operand a,
+	direction_operand b,
+	direction_operand c,
+	std::size_t n,
+	double e,
+	double r,
+	packed_direction* out)
+{
+	const std::size_t sa = a.broadcast ? 0 : 1;
+	const std::size_t sb = b.broadcast ? 0 : 1;
+	const std::size_t sc = c.broadcast ? 0 : 1;
+
+	for(std::size_t i=0; i<n; i++){
+		double ax = a.x[i*sa], ay = a.y[i*sa];
+		double v0x = b.x[i*sb] - ax;
+		double v0y = b.y[i*sb] - ay;
+		double v1x = c.x[i*sc] - ax;
+		double v1y = c.y[i*sc] - ay;
+
+		double m0 = v0x*v1y;
+		double m1 = v0y*v1x;
+
+		out[i] = pack_direction(
+			m0 - m1,
+			e + r*(std::fabs(m0) + std::fabs(m1)));
+	}
+}
+
+/*
+ * the bits of a byte spread to the lowest bits of the bytes of a word,
+ * e.g., 0b101 is 0x010001
+ */
+struct lane_bytes {
+	std::uint64_t word[256];
+};
+
+constexpr lane_bytes make_lane_bytes()
+{
+	lane_bytes t{};
+	for(unsigned m=0; m<256; m++)
+		for(unsigned k=0; k<8; k++)
+			if((m >> k) & 1u)
+				t.word[m] |= std::uint64_t(1) << (8*k);
+	return t;
+}
+
+inline constexpr lane_bytes lane_bytes_table = make_lane_bytes();
+
+/*
+ * directions of the up to 8 lanes given the bit masks of the lanes whose
+ * cross product is ON and negative, the bytes are built in one word so
+ * the unpredictable signs of the lanes cost no branches. Only the x86
+ * kernels call it, the word is stored little-endian.
+ */
+inline void unpack_masks(
+	unsigned on,
+	unsigned negative,
+	std::size_t lanes,
+	packed_direction* out)
+{
+	static_assert(LEFT == 0 && RIGHT == 1 && ON == 2,
+		"unpack_masks builds the directions from the bits");
+
+	std::uint64_t o = lane_bytes_table.word[on & 0xffu];
+	std::uint64_t r = lane_bytes_table.word[negative & 0xffu];
+	std::uint64_t w = (o << 1) | (r & ~o);
+
+	std::memcpy(out, &w, lanes);
+}
+
+#ifdef GMT_SIMD_X86
+
+inline __m128d load_sse2(const direction_operand& o, const double* p)
+{
+	return o.broadcast ? _mm_set1_pd(*p) : _mm_loadu_pd(p);
+}
+
+inline void direction_kernel_sse2(
+	direction_operand a,
+	direction_operand b,
+	direction_operand c,
+	std::size_t n,
+	double e,
+	double r,
+	packed_direction* out)
+{
+	const __m128d sign = _mm_set1_pd(-0.0);
+	const __m128d eps = _mm_set1_pd(e);
+	const __m128d rel = _mm_set1_pd(r);
+	const __m128d zero = _mm_setzero_pd();
+
+	const std::size_t sa = a.broadcast ? 0 : 1;
+	const std::size_t sb = b.broadcast ? 0 : 1;
+	const std::size_t sc = c.broadcast ? 0 : 1;
+
+	std::size_t i = 0;
+	for(; i + 2 <= n; i += 2){
+		__m128d ax = load_sse2(a, a.x + i*sa);
+		__m128d ay = load_sse2(a, a.y + i*sa);
+		__m128d v0x = _mm_sub_pd(load_sse2(b, b.x + i*sb), ax);
+		__m128d v0y = _mm_sub_pd(load_sse2(b, b.y + i*sb), ay);
+		__m128d v1x = _mm_sub_pd(load_sse2(c, c.x + i*sc), ax);
+		__m128d v1y = _mm_sub_pd(load_sse2(c, c.y + i*sc), ay);
+
+		__m128d m0 = _mm_mul_pd(v0x, v1y);
+		__m128d m1 = _mm_mul_pd(v0y, v1x);
+		__m128d cross = _mm_sub_pd(m0, m1);
+		__m128d bound = _mm_add_pd(eps, _mm_mul_pd(rel, _mm_add_pd(
+			_mm_andnot_pd(sign, m0),
+			_mm_andnot_pd(sign, m1))));
+
+		unsigned on = _mm_movemask_pd(
+			_mm_cmple_pd(_mm_andnot_pd(sign, cross), bound));
+		unsigned negative = _mm_movemask_pd(_mm_cmplt_pd(cross, zero));
+
+		unpack_masks(on, negative, 2, out + i);
+	}
+
+	if(i < n){
+		direction_operand ta = a, tb = b, tc = c;
+		ta.x += i*sa; ta.y += i*sa;
+		tb.x += i*sb; tb.y += i*sb;
+		tc.x += i*sc; tc.y += i*sc;
+		direction_kernel_scalar(ta, tb, tc, n - i, e, r, out + i);
+	}
+}
+
+__attribute__((target("avx2")))
+inline __m256d load_avx2(const direction_operand& o, const double* p)
+{
+	return o.broadcast ? _mm256_set1_pd(*p) : _mm256_loadu_pd(p);
+}
+
+__attribute__((target("avx2")))
+inline void direction_kernel_avx2(
+	direction_operand a,
+	direction_operand b,
+	direction_operand c,
+	std::size_t n,
+	double e,
+	double r,
+	packed_direction* out)
+{
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	const __m256d eps = _mm256_set1_pd(e);
+	const __m256d rel = _mm256_set1_pd(r);
+	const __m256d zero = _mm256_setzero_pd();
+
+	const std::size_t sa = a.broadcast ? 0 : 1;
+	const std::size_t sb = b.broadcast ? 0 : 1;
+	const std::size_t sc = c.broadcast ? 0 : 1;
+
+	std::size_t i = 0;
+	for(; i + 4 <= n; i += 4){
+		__m256d ax = load_avx2(a, a.x + i*sa);
+		__m256d ay = load_avx2(a, a.y + i*sa);
+		__m256d v0x = _mm256_sub_pd(load_avx2(b, b.x + i*sb), ax);
+		__m256d v0y = _mm256_sub_pd(load_avx2(b, b.y + i*sb), ay);
+		__m256d v1x = _mm256_sub_pd(load_avx2(c, c.x + i*sc), ax);
+		__m256d v1y = _mm256_sub_pd(load_avx2(c, c.y + i*sc), ay);
+
+		__m256d m0 = _mm256_mul_pd(v0x, v1y);
+		__m256d m1 = _mm256_mul_pd(v0y, v1x);
+		__m256d cross = _mm256_sub_pd(m0, m1);
+		__m256d bound = _mm256_add_pd(eps, _mm256_mul_pd(rel,
+			_mm256_add_pd(
+				_mm256_andnot_pd(sign, m0),
+				_mm256_andnot_pd(sign, m1))));
+
+		unsigned on = _mm256_movemask_pd(_mm256_cmp_pd(
+			_mm256_andnot_pd(sign, cross), bound, _CMP_LE_OQ));
+		unsigned negative = _mm256_movemask_pd(
+			_mm256_cmp_pd(cross, zero, _CMP_LT_OQ));
+
+		unpack_masks(on, negative, 4, out + i);
+	}
+
+	if(i < n){
+		direction_operand ta = a, tb = b, tc = c;
+		ta.x += i*sa; ta.y += i*sa;
+		tb.x += i*sb; tb.y += i*sb;
+		tc.x += i*sc; tc.y += i*sc;
+		direction_kernel_sse2(ta, tb, tc, n - i, e, r, out + i);
+	}
+}
+
+__attribute__((target("avx512f")))
+inline __m512d load_avx512(const direction_operand& o, const double* p)
+{
+	return o.broadcast ? _mm512_set1_pd(*p) : _mm512_loadu_pd(p);
+}
+
+__attribute__((target("avx512f")))
+inline void direction_kernel_avx512(
+	direction_operand a,
+	direction_operand b,
+	direction_operand c,
+	std::size_t n,
+	double e,
+	double r,
+	packed_direction* out)
+{
+	const __m512d eps = _mm512_set1_pd(e);
+	const __m512d rel = _mm512_set1_pd(r);
+	const __m512d zero = _mm512_setzero_pd();
+
+	const std::size_t sa = a.broadcast ? 0 : 1;
+	const std::size_t sb = b.broadcast ? 0 : 1;
+	const std::size_t sc = c.broadcast ? 0 : 1;
+
+	std::size_t i = 0;
+	for(; i + 8 <= n; i += 8){
+		__m512d ax = load_avx512(a, a.x + i*sa);
+		__m512d ay = load_avx512(a, a.y + i*sa);
+		__m512d v0x = _mm512_sub_pd(load_avx512(b, b.x + i*sb), ax);
+		__m512d v0y = _mm512_sub_pd(load_avx512(b, b.y + i*sb), ay);
+		__m512d v1x = _mm512_sub_pd(load_avx512(c, c.x + i*sc), ax);
+		__m512d v1y = _mm512_sub_pd(load_avx512(c, c.y + i*sc), ay);
+
+		/*
+		 * avx512f implies fma, the empty asm keeps the compiler from
+		 * fusing the products, so the lanes round like direction_in
+		 */
+		__m512d m0 = _mm512_mul_pd(v0x, v1y);
+		__m512d m1 = _mm512_mul_pd(v0y, v1x);
+		__asm__("" : "+v"(m0), "+v"(m1));
+
+		__m512d cross = _mm512_sub_pd(m0, m1);
+		__m512d bound = _mm512_add_pd(eps, _mm512_mul_pd(rel,
+			_mm512_add_pd(_mm512_abs_pd(m0), _mm512_abs_pd(m1))));
+
+		unsigned on = _mm512_cmp_pd_mask(
+			_mm512_abs_pd(cross), bound, _CMP_LE_OQ);
+		unsigned negative = _mm512_cmp_pd_mask(
+			cross, zero, _CMP_LT_OQ);
+
+		unpack_masks(on, negative, 8, out + i);
+	}
+
+	if(i < n){
+		direction_operand ta = a, tb = b, tc = c;
+		ta.x += i*sa; ta.y += i*sa;
+		tb.x += i*sb; tb.y += i*sb;
+		tc.x += i*sc; tc.y += i*sc;
+		direction_kernel_sse2(ta, tb, tc, n - i, e, r, out + i);
+	}
+}
+
+#endif
+
+/*
+ * widest instruction set supported by the processor
+ */
+inline simd_isa detect_isa()
+{
+#ifdef GMT_SIMD_X86
+	__builtin_cpu_init();
+
+	if(__builtin_cpu_supports("avx512f"))
+		return AVX512;
+	if(__builtin_cpu_supports("avx2"))
+		return AVX2;
+	return SSE2;
+#else
+	return SCALAR;
+#endif
+}
+
+inline direction_kernel kernel_for(simd_isa isa)
+{
+	switch(isa){
+#ifdef GMT_SIMD_X86
+	case AVX512:
+		return direction_kernel_avx512;
+	case AVX2:
+		return direction_kernel_avx2;
+	case SSE2:
+		return direction_kernel_sse2;
+#endif
+	default:
+		return direction_kernel_scalar;
+	}
+}
+
+/*
+ * the kernel is chosen on the first use, it is atomic because it may be
+ * changed by `set_direction_batch_isa` while other threads run batches;
+ * a kernel keeps no state, so the relaxed order is enough
+ */
+inline std::atomic<simd_isa>& active_isa()
+{
+	static std::atomic<simd_isa> isa{ detect_isa() };
+	return isa;
+}
+
+inline std::atomic<direction_kernel>& active_kernel()
+{
+	static std::atomic<direction_kernel> kernel{
+		kernel_for(active_isa().load(std::memory_order_relaxed))
+	};
+	return kernel;
+}
+
+inline direction_kernel current_kernel()
+{
+	return active_kernel().load(std::memory_order_relaxed);
+}
+
+inline direction_operand column_operand(const double* x, const double* y)
+{
+	return direction_operand{ x, y, false };
+}
+
+inline direction_operand point_operand(const point2d& p)
+{
+	return direction_operand{ &p.x(), &p.y(), true };
+}
+
+}
+
+/**
+  * @return the instruction set used by the batch direction functions
+  */
+inline simd_isa direction_batch_isa()
+{
+	return simd::active_isa().load(std::memory_order_relaxed);
+}
+
+/**
+  * Forces the instruction set of the batch direction functions, e.g., to
+  * compare the kernels. The request is lowered to the widest instruction
+  * set the processor supports. It may be called while other threads run
+  * batches, a batch already running finishes with the kernel it started.
+  *
+  * @return the instruction set that will be used
+  */
+inline simd_isa set_direction_batch_isa(simd_isa isa)
+{
+	isa = std::min(isa, simd::detect_isa());
+
+	simd::active_kernel().store(simd::kernel_for(isa), std::memory_order_relaxed);
+	simd::active_isa().store(isa, std::memory_order_relaxed);
+
+	return isa;
+}
+
+/**
+  * Calculates the direction of the points `(x[i], y[i])` in reference of
+  * the segment of `p0` and `p1`, i.e., `direction_in(p0, p1, p_i, e)`,
+  * for `i` in `[0, n)`. The results are written in `out`.
+  *
+  * The results are the same of `direction_in` as long as the compiler does
+  * not contract the products of the scalar code into fused multiply-adds.
+  *
+  * A point is ON when the absolute value of the cross product is not
+  * greater than `e + relative*(|v0x*v1y| + |v0y*v1x|)`. With a `relative`
+  * tolerance of `ccw_error_bound` ON means "undecided by the floating-point
+  * filter", this is how `robust_predicates` vectorizes its fast path.
+  */
+inline void direction_batch(
+	const point2d& p0,
+	const point2d& p1,
+	const double* x,
+	const double* y,
+	std::size_t n,
+	packed_direction* out,
+	double e = 0.0,
+	double relative = 0.0)
+{
+	simd::current_kernel()(
+		simd::point_operand(p0),
+		simd::point_operand(p1),
+		simd::column_operand(x, y),
+		n,
+		e,
+		relative,
+		out);
+}
+
+/**
+  * direction of every point of the buffer in reference of the segment of
+  * `p0` and `p1`
+  *
+  * @see direction_batch
+  */
+inline void direction_batch(
+	const point2d& p0,
+	const point2d& p1,
+	const point_buffer2d& points,
+	packed_direction* out,
+	double e = 0.0,
+	double relative = 0.0)
+{
+	direction_batch(
+		p0,
+		p1,
+		points.x(),
+		points.y(),
+		points.size(),
+		out,
+		e,
+		relative);
+}
+
+/**
+  * direction of every point of the array `points` in reference of the
+  * segment of `p0` and `p1`, the points are converted to columns
+  * `direction_block` points at a time
+  *
+  * @see direction_batch
+  */
+inline void direction_batch(
+	const point2d& p0,
+	const point2d& p1,
+	const point2d* points,
+	std::size_t n,
+	packed_direction* out,
+	double e = 0.0,
+	double relative = 0.0)
+{
+	alignas(point_buffer2d::alignment) double x[direction_block];
+	alignas(point_buffer2d::alignment) double y[direction_block];
+
+	for(std::size_t first=0; first<n; first += direction_block){
+		std::size_t count = std::min(direction_block, n - first);
+
+		for(std::size_t i=0; i<count; i++){
+			x[i] = points[first + i].x();
+			y[i] = points[first + i].y();
+		}
+
+		direction_batch(p0, p1, x, y, count, out + first, e, relative);
+	}
+}
+
+/**
+  * direction of the triples of the buffers, i.e.,
+  * `direction_in(a[i], b[i], c[i], e)`
+  *
+  * @see direction_batch
+  */
+inline void direction_batch(
+	const point_buffer2d& a,
+	const point_buffer2d& b,
+	const point_buffer2d& c,
+	packed_direction* out,
+	double e = 0.0,
+	double relative = 0.0)
+{
+	std::size_t n = std::min(a.size(), std::min(b.size(), c.size()));
+
+	simd::current_kernel()(
+		simd::column_operand(a.x(), a.y()),
+		simd::column_operand(b.x(), b.y()),
+		simd::column_operand(c.x(), c.y()),
+		n,
+		e,
+		relative,
+		out);
+}
+
+/**
+  * Calculates the direction of the point `p` in reference of the edges
+  * `first` to `first + count - 1` of the closed polygonal chain `ring`
+  * of `n` vertices, i.e., `direction_in(ring[i], ring[(i+1)%n], p, e)`.
+  * `count` must not be greater than `direction_block`.
+  *
+  * @see direction_batch
+  */
+inline void ring_direction_batch(
+	const point2d* ring,
+	std::size_t n,
+	std::size_t first,
+	std::size_t count,
+	const point2d& p,
+	packed_direction* out,
+	double e = 0.0,
+	double relative = 0.0)
+{
+	alignas(point_buffer2d::alignment) double x[direction_block + 1];
+	alignas(point_buffer2d::alignment) double y[direction_block + 1];
+
+	for(std::size_t i=0; i<=count; i++){
+		std::size_t j = first + i;
+		if(j >= n)
+			j -= n;
+
+		x[i] = ring[j].x();
+		y[i] = ring[j].y();
+	}
+
+	simd::current_kernel()(
+		simd::column_operand(x, y),
+		simd::column_operand(x + 1, y + 1),
+		simd::point_operand(p),
+		count,
+		e,
+		relative,
+		out);
+}
+
+/**
+  * Calculates the direction of the point `p` in reference of the edges
+  * `first` to `first + count - 1` of the polygon whose vertices are the
+  * points of `ring`, reading the columns in place.
+  *
+  * @see ring_direction_batch
+  */
+inline void ring_direction_batch(
+	const point_buffer2d& ring,
+	std::size_t first,
+	std::size_t count,
+	const point2d& p,
+	packed_direction* out,
+	double e = 0.0,
+	double relative = 0.0)
+{
+	const std::size_t n = ring.size();
+	const double* x = ring.x();
+	const double* y = ring.y();
+
+	/*
+	 * the edges that do not wrap around read the columns shifted by one
+	 */
+	std::size_t direct = (first + count < n) ? count : n - 1 - first;
+
+	simd::current_kernel()(
+		simd::column_operand(x + first, y + first),
+		simd::column_operand(x + first + 1, y + first + 1),
+		simd::point_operand(p),
+		direct,
+		e,
+		relative,
+		out);
+
+	/*
+	 * closing edge, from the last vertex to the first, and the edges
+	 * after it when the window wraps around
+	 */
+	if(direct < count){
+		point2d a{ x[n - 1], y[n - 1] };
+		point2d b{ x[0], y[0] };
+
+		simd::current_kernel()(
+			simd::point_operand(a),
+			simd::point_operand(b),
+			simd::point_operand(p),
+			1,
+			e,
+			relative,
+			out + direct);
+
+		simd::current_kernel()(
+			simd::column_operand(x, y),
+			simd::column_operand(x + 1, y + 1),
+			simd::point_operand(p),
+			count - direct - 1,
+			e,
+			relative,
+			out + direct + 1);
+	}
+}
+
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/polygon-set.hpp>
+#include <gmt/thread-pool.hpp>
+#include <gmt/algorithm/batch-direction.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+#include <gmt/algorithm/point-in-polygon.hpp>
+
+namespace gmt {
+
+/**
+  * number of pairs of edge and query point a thread of `side_of_batch`
+  * evaluates at a time, the batches with less than that run in the
+  * caller
+  */
+constexpr size_t side_of_batch_work = size_t(1) << 18;
+
+/*
+ * winding number test of the `count` points of the columns `x` and `y`
+ * in the ring `poly`, with the same rules of `winding_number_block`, one
+ * edge at a time. The points are sorted by height, so an edge only reads
+ * the points between the heights of its ends, the others neither cross
+ * it nor lie on it, and their directions in reference of the edge come
+ * from one batch call of `pred`. `count` must not be greater than
+ * `direction_block`.
+ */
+template<typename ring_type, typename predicates>
+void side_of_block(
+	const ring_type& poly,
+	const double* x,
+	const double* y,
+	size_t count,
+	side* out,
+	const predicates& pred)
+{
+	const size_t n = poly.size();
+
+	switch(n){
+	case 0:
+		std::fill(out, out + count, OUTSIDE);
+		return;
+	case 1:
+		for(size_t k=0; k<count; k++)
+			out[k] = (poly[0] == point2d{ x[k], y[k] }) ? INSIDE : OUTSIDE;
+		return;
+	}
+
+	std::uint16_t order[direction_block];
+	alignas(point_buffer2d::alignment) double xs[direction_block];
+	alignas(point_buffer2d::alignment) double ys[direction_block];
+
+	std::iota(order, order + count, 0);
+	std::sort(order, order + count, [y](std::uint16_t i, std::uint16_t j){
+		return y[i] < y[j];
+	});
+
+	for(size_t k=0; k<count; k++){
+		xs[k] = x[order[k]];
+		ys[k] = y[order[k]];
+	}
+
+	int wn[direction_block] = {};
+	bool on[direction_block] = {};
+	packed_direction d[direction_block];
+
+	for(size_t i=0; i<n; i++){
+		const point2d& a = poly[i];
+		const point2d& b = poly[(i + 1 == n) ? 0 : i + 1];
+
+		size_t lo = std::lower_bound(ys, ys + count, std::min(a.y(), b.y())) - ys;
+		size_t hi = std::upper_bound(ys + lo, ys + count, std::max(a.y(), b.y())) - ys;
+		if(lo == hi)
+			continue;
+
+		const size_t m = hi - lo;
+		pred.orientation_batch(a, b, xs + lo, ys + lo, m, d);
+
+		/*
+		 * the crossings are counted without branches, the directions
+		 * of the points are as unpredictable as the points themselves
+		 */
+		for(size_t k=0; k<m; k++){
+			const double py = ys[lo + k];
+			const int above_a = a.y() <= py;
+			const int above_b = b.y() <= py;
+
+			wn[lo + k] += (above_a & (above_b ^ 1) & (d[k] == gmt::LEFT))
+				- ((above_a ^ 1) & above_b & (d[k] == gmt::RIGHT));
+		}
+
+		/*
+		 * the points collinear with the edge are rare
+		 */
+		const packed_direction* last = d + m;
+		for(const packed_direction* c = std::find(static_cast<const packed_direction*>(d), last, gmt::ON);
+			c != last;
+			c = std::find(c + 1, last, gmt::ON)){
+			size_t k = lo + (c - d);
+
+			if(is_between(a, b, point2d{ xs[k], ys[k] }))
+				on[k] = true;
+		}
+	}
+
+	for(size_t k=0; k<count; k++){
+		if(on[k])
+			out[order[k]] = ON_BONDARY;
+		else if(wn[k] != 0)
+			out[order[k]] = INSIDE;
+		else
+			out[order[k]] = OUTSIDE;
+	}
+}
+
+/*
+ * number of query points of a chunk of `side_of_batch`, a multiple of
+ * `direction_block`
+ */
+inline size_t side_of_batch_grain(size_t n_edges)
+{
+	size_t blocks = side_of_batch_work/(direction_block*std::max<size_t>(n_edges, 1));
+	return std::max<size_t>(blocks, 1)*direction_block;
+}
+
+/**
+  * Side of every point of `points` in the polygon `poly`, written in
+  * `out`, with the same answers of `side_of(poly, points[i], pred)`. The
+  * points are split in chunks that run in the threads of `pool`.
+  */
+template<typename predicates>
+void side_of_batch(
+	const ring_view2d& poly,
+	const point_buffer2d& points,
+	side* out,
+	const predicates& pred,
+	thread_pool& pool)
+{
+	const double* x = points.x();
+	const double* y = points.y();
+
+	pool.parallel_for(points.size(), side_of_batch_grain(poly.size()),
+		[&](size_t begin, size_t end){
+			for(size_t first=begin; first<end; first += direction_block){
+				size_t count = std::min(direction_block, end - first);
+				side_of_block(poly, x + first, y + first, count, out + first, pred);
+			}
+		});
+}
+
+/**
+  * @see side_of_batch
+  */
+template<typename predicates>
+void side_of_batch(
+	const ring_view2d& poly,
+	const point2d* points,
+	size_t n,
+	side* out,
+	const predicates& pred,
+	thread_pool& pool)
+{
+	pool.parallel_for(n, side_of_batch_grain(poly.size()),
+		[&](size_t begin, size_t end){
+			alignas(point_buffer2d::alignment) double x[direction_block];
+			alignas(point_buffer2d::alignment) double y[direction_block];
+
+			for(size_t first=begin; first<end; first += direction_block){
+				size_t count = std::min(direction_block, end - first);
+
+				for(size_t k=0; k<count; k++){
+					x[k] = points[first + k].x();
+					y[k] = points[first + k].y();
+				}
+
+				side_of_block(poly, x, y, count, out + first, pred);
+			}
+		});
+}
+
+template<typename predicates>
+void side_of_batch(
+	const ring_view2d& poly,
+	const std::vector<point2d>& points,
+	side* out,
+	const predicates& pred,
+	thread_pool& pool)
+{
+	side_of_batch(poly, points.data(), points.size(), out, pred, pool);
+}
+
+/*
+ * the default side_of_batch decides the directions exactly and runs in
+ * the default thread pool
+ */
+inline void side_of_batch(
+	const ring_view2d& poly,
+	const point_buffer2d& points,
+	side* out)
+{
+	side_of_batch(
+		poly,
+		points,
+		out,
+		robust_predicates(GMT_PREDICATE_SITE("side_of_batch")),
+		default_thread_pool());
+}
+
+inline void side_of_batch(
+	const ring_view2d& poly,
+	const point2d* points,
+	size_t n,
+	side* out)
+{
+	side_of_batch(
+		poly,
+		points,
+		n,
+		out,
+		robust_predicates(GMT_PREDICATE_SITE("side_of_batch")),
+		default_thread_pool());
+}
+
+inline void side_of_batch(
+	const ring_view2d& poly,
+	const std::vector<point2d>& points,
+	side* out)
+{
+	side_of_batch(poly, points.data(), points.size(), out);
+}
+
+}
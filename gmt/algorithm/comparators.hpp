@@ -37,7 +37,7 @@ public:
 	{}
 
 	template<typename T>
-	bool operator()(const T& a, const T& b)
+	bool operator()(const T& a, const T& b) const
 	{
 
 		auto compare = asc
@@ -0,0 +1,462 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/triangle-mesh.hpp>
+#include <gmt/thread-pool.hpp>
+#include <gmt/algorithm/comparators.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+namespace gmt {
+
+/**
+  * number of points a thread of the parallel `quickhull` assigns to the
+  * faces of the first tetrahedron at a time
+  */
+constexpr size_t quickhull_grain = size_t(1) << 14;
+
+/**
+  * Quickhull in three dimensions. The hull is a mesh of triangles kept as
+  * half-edges: the half-edge `3*f + k` of the face `f` goes from its
+  * vertex `k` to the next one, and every face stores the half-edges of
+  * its neighbours in the opposite directions. The points outside a face
+  * form a list threaded through one array of all the points, so moving a
+  * point to another face allocates nothing, and the buffers of the
+  * search of the horizon are kept from a step to the next.
+  *
+  * Every decision of whether a point is outside a face is taken by the
+  * exact `orient3d`, so coplanar points and faces are handled exactly:
+  * a point in the plane of a face is not outside it.
+  */
+template<typename T>
+class quickhull_builder {
+public:
+	/**
+	  * @param points	container of the 3D points, they are read
+	  *			once and converted to `double`
+	  */
+	template<typename list_container>
+	explicit quickhull_builder(const list_container& points)
+	{
+		m_points.reserve(points.size());
+		for(const auto& p : points)
+			m_points.push_back(point3d{ double(p.x()), double(p.y()), double(p.z()) });
+	}
+
+	/**
+	  * computes the hull, the points are assigned to the first faces by
+	  * the threads of `pool` when it is given
+	  *
+	  * @return the triangles of the hull in counterclockwise order seen
+	  *	   from outside, with the vertices that are used only, or an
+	  *	   empty mesh if the points do not span a volume
+	  */
+	triangle_mesh<T, 3> build(thread_pool* pool = nullptr)
+	{
+		triangle_mesh<T, 3> mesh;
+
+		if(!initial_tetrahedron())
+			return mesh;
+
+		assign_initial(pool);
+
+		std::vector<size_t> pending = { 0, 1, 2, 3 };
+
+		while(!pending.empty()){
+			size_t f = pending.back();
+			pending.pop_back();
+
+			if(!m_faces[f].alive || m_faces[f].head == npos)
+				continue;
+
+			size_t first_new = m_faces.size();
+			add_point(f);
+
+			for(size_t g=first_new; g<m_faces.size(); g++)
+				if(m_faces[g].head != npos)
+					pending.push_back(g);
+		}
+
+		/*
+		 * only the vertices of the hull go to the mesh
+		 */
+		std::vector<size_t> index(m_points.size(), npos);
+
+		for(const auto& face : m_faces){
+			if(!face.alive)
+				continue;
+
+			typename triangle_mesh<T, 3>::triangle t;
+			for(size_t k=0; k<3; k++){
+				size_t v = face.v[k];
+
+				if(index[v] == npos){
+					index[v] = mesh.vertices.size();
+					const point3d& p = m_points[v];
+					mesh.vertices.push_back(
+						point<T, 3>{ T(p.x()), T(p.y()), T(p.z()) });
+				}
+
+				t[k] = index[v];
+			}
+
+			mesh.triangles.push_back(t);
+		}
+
+		return mesh;
+	}
+
+private:
+	static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+	/*
+	 * the points outside the face are the list from `head`, the farthest
+	 * of them is `farthest`. The volume given by `orient3d` is the
+	 * distance to the plane of the face times twice its area, so it
+	 * compares the distances of the points to the same face.
+	 */
+	struct face {
+		size_t v[3];
+		size_t twin[3];
+		size_t head = npos;
+		size_t farthest = npos;
+		double farthest_volume = 0.0;
+		size_t visit = 0;
+		bool visible = false;
+		bool alive = true;
+	};
+
+	std::vector<point3d> m_points;
+	std::vector<face> m_faces;
+
+	/*
+	 * the lists of the points outside the faces
+	 */
+	std::vector<size_t> m_next;
+
+	/*
+	 * buffers of `add_point`
+	 */
+	std::vector<size_t> m_stack;
+	std::vector<size_t> m_visible;
+	std::vector<size_t> m_horizon;
+	std::vector<size_t> m_face_from;
+	size_t m_visit = 0;
+
+	predicate_counter* m_site = GMT_PREDICATE_SITE("quickhull");
+
+	/*
+	 * volume of the tetrahedron of the face `f` and the point `i`,
+	 * negative if the point is outside the face
+	 */
+	double volume(size_t f, size_t i) const
+	{
+		const face& t = m_faces[f];
+		return orient3d(
+			m_points[t.v[0]],
+			m_points[t.v[1]],
+			m_points[t.v[2]],
+			m_points[i],
+			m_site);
+	}
+
+	void push_outside(size_t f, size_t i, double vol)
+	{
+		face& t = m_faces[f];
+
+		m_next[i] = t.head;
+		t.head = i;
+
+		if(t.farthest == npos || vol < t.farthest_volume){
+			t.farthest = i;
+			t.farthest_volume = vol;
+		}
+	}
+
+	size_t new_face(size_t a, size_t b, size_t c)
+	{
+		face t;
+		t.v[0] = a;
+		t.v[1] = b;
+		t.v[2] = c;
+		t.twin[0] = t.twin[1] = t.twin[2] = npos;
+
+		m_faces.push_back(t);
+		return m_faces.size() - 1;
+	}
+
+	/*
+	 * links the half-edge `h` to `g`, and `g` to `h`
+	 */
+	void link(size_t h, size_t g)
+	{
+		m_faces[h/3].twin[h%3] = g;
+		m_faces[g/3].twin[g%3] = h;
+	}
+
+	/*
+	 * the four faces of a tetrahedron of the points, the lowest and the
+	 * highest point in lexicographic order, the point farthest from
+	 * their line and the point farthest from the plane of the three
+	 */
+	bool initial_tetrahedron()
+	{
+		const size_t n = m_points.size();
+		if(n < 4)
+			return false;
+
+		axis_comparator less;
+		size_t a = 0, b = 0;
+
+		for(size_t i=1; i<n; i++){
+			if(less(m_points[i], m_points[a]))
+				a = i;
+			if(less(m_points[b], m_points[i]))
+				b = i;
+		}
+
+		if(m_points[a] == m_points[b])
+			return false;
+
+		/*
+		 * the line is found exactly by its projections on the planes of
+		 * the axes
+		 */
+		auto project = [](const point3d& p, size_t i, size_t j){
+			return point2d{ p[i], p[j] };
+		};
+
+		size_t c = npos;
+		double c_score = 0.0;
+
+		for(size_t i=0; i<n; i++){
+			double score = 0.0;
+
+			for(size_t axis=0; axis<3; axis++){
+				size_t i0 = (axis + 1)%3, i1 = (axis + 2)%3;
+				score += std::fabs(orient2d(
+					project(m_points[a], i0, i1),
+					project(m_points[b], i0, i1),
+					project(m_points[i], i0, i1),
+					m_site));
+			}
+
+			if(score > c_score){
+				c = i;
+				c_score = score;
+			}
+		}
+
+		if(c == npos)
+			return false;
+
+		size_t d = npos;
+		double d_volume = 0.0;
+
+		for(size_t i=0; i<n; i++){
+			double vol = orient3d(m_points[a], m_points[b], m_points[c], m_points[i], m_site);
+
+			if(std::fabs(vol) > std::fabs(d_volume)){
+				d = i;
+				d_volume = vol;
+			}
+		}
+
+		if(d == npos)
+			return false;
+
+		/*
+		 * `d` is below the counterclockwise side of `a`, `b` and `c`,
+		 * which is then the outer side
+		 */
+		if(d_volume < 0.0)
+			std::swap(b, c);
+
+		m_faces.reserve(4*n);
+
+		size_t abc = new_face(a, b, c);
+		size_t adb = new_face(a, d, b);
+		size_t bdc = new_face(b, d, c);
+		size_t cda = new_face(c, d, a);
+
+		link(3*abc + 0, 3*adb + 2);
+		link(3*abc + 1, 3*bdc + 2);
+		link(3*abc + 2, 3*cda + 2);
+		link(3*adb + 0, 3*cda + 1);
+		link(3*adb + 1, 3*bdc + 0);
+		link(3*bdc + 1, 3*cda + 0);
+
+		return true;
+	}
+
+	/*
+	 * each point goes to the first face of the tetrahedron that it is
+	 * outside of, the tests run in the threads of `pool`
+	 */
+	void assign_initial(thread_pool* pool)
+	{
+		const size_t n = m_points.size();
+
+		std::vector<unsigned char> owner(n);
+		std::vector<double> vol(n);
+
+		auto assign = [&](size_t begin, size_t end){
+			for(size_t i=begin; i<end; i++){
+				owner[i] = 4;
+
+				for(unsigned char f=0; f<4; f++){
+					double v = volume(f, i);
+
+					if(v < 0.0){
+						owner[i] = f;
+						vol[i] = v;
+						break;
+					}
+				}
+			}
+		};
+
+		if(pool)
+			pool->parallel_for(n, quickhull_grain, assign);
+		else
+			assign(0, n);
+
+		m_next.assign(n, npos);
+		m_face_from.assign(n, npos);
+
+		for(size_t i=n; i-- > 0;)
+			if(owner[i] < 4)
+				push_outside(owner[i], i, vol[i]);
+	}
+
+	/*
+	 * adds the farthest point outside the face `f` to the hull: the
+	 * faces it sees are removed, the horizon is the border between them
+	 * and the others, and a cone of new faces joins the point to the
+	 * horizon. The points outside the removed faces go to the new ones.
+	 */
+	void add_point(size_t f)
+	{
+		const size_t eye = m_faces[f].farthest;
+		const size_t visit = ++m_visit;
+
+		m_visible.clear();
+		m_horizon.clear();
+		m_stack.clear();
+
+		m_faces[f].visit = visit;
+		m_faces[f].visible = true;
+		m_stack.push_back(f);
+
+		while(!m_stack.empty()){
+			size_t g = m_stack.back();
+			m_stack.pop_back();
+			m_visible.push_back(g);
+
+			for(size_t k=0; k<3; k++){
+				size_t h = m_faces[g].twin[k];
+				face& neighbour = m_faces[h/3];
+
+				if(neighbour.visit != visit){
+					neighbour.visit = visit;
+					neighbour.visible = volume(h/3, eye) < 0.0;
+
+					if(neighbour.visible)
+						m_stack.push_back(h/3);
+				}
+
+				if(!neighbour.visible)
+					m_horizon.push_back(3*g + k);
+			}
+		}
+
+		/*
+		 * the cone, the new face of a half-edge of the horizon from `u`
+		 * to `w` is `u`, `w` and the eye, and it meets the new face of
+		 * the half-edge that leaves `w`
+		 */
+		const size_t first_new = m_faces.size();
+
+		for(size_t h : m_horizon){
+			size_t u = m_faces[h/3].v[h%3];
+			size_t w = m_faces[h/3].v[(h%3 + 1)%3];
+			size_t outer = m_faces[h/3].twin[h%3];
+
+			size_t g = new_face(u, w, eye);
+			link(3*g + 0, outer);
+			m_face_from[u] = g;
+		}
+
+		for(size_t g=first_new; g<m_faces.size(); g++)
+			link(3*g + 1, 3*m_face_from[m_faces[g].v[1]] + 2);
+
+		for(size_t g : m_visible){
+			m_faces[g].alive = false;
+
+			for(size_t i = m_faces[g].head; i != npos;){
+				size_t next = m_next[i];
+
+				if(i != eye){
+					for(size_t t=first_new; t<m_faces.size(); t++){
+						double v = volume(t, i);
+
+						if(v < 0.0){
+							push_outside(t, i, v);
+							break;
+						}
+					}
+				}
+
+				i = next;
+			}
+
+			m_faces[g].head = npos;
+		}
+	}
+};
+
+/**
+  * Quickhull algorithm to calculate the convex hull of a cloud of points
+  * in three dimensions, in O(n lg n) expected time. The faces of the hull
+  * are triangles, the coplanar ones included.
+  *
+  * The points may have floating-point or integer coordinates, the
+  * orientations are decided exactly in both cases. The coordinates are
+  * converted to `double`, so the integers must not exceed 2^53 in
+  * magnitude.
+  *
+  * @param points	container of 3D points
+  *
+  * @return	the mesh of the triangles of the hull, in counterclockwise
+  *		order seen from outside, whose vertices are the vertices of
+  *		the hull; empty if the points do not span a volume
+  */
+template<typename list_container>
+auto quickhull(const list_container& points)
+	-> triangle_mesh<typename list_container::value_type::value_type, 3>
+{
+	typedef typename list_container::value_type::value_type T;
+
+	return quickhull_builder<T>(points).build();
+}
+
+/**
+  * Quickhull whose first and largest pass, the assignment of every point
+  * to the faces of the first tetrahedron, runs in the threads of `pool`.
+  *
+  * @see quickhull
+  */
+template<typename list_container>
+auto quickhull(const list_container& points, thread_pool& pool)
+	-> triangle_mesh<typename list_container::value_type::value_type, 3>
+{
+	typedef typename list_container::value_type::value_type T;
+
+	return quickhull_builder<T>(points).build(&pool);
+}
+
+}
@@ -2,25 +2,33 @@
 
 #include <list>
 #include <algorithm>
+#include <optional>
 #include <set>
+#include <utility>
 
 #include <gmt/polygon.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/thread-pool.hpp>
+#include <gmt/algorithm/akl-toussaint.hpp>
 #include <gmt/algorithm/comparators.hpp>
 #include <gmt/algorithm/direction.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
 
 namespace gmt {
 
+template<typename T>
 using merge_hull_tangent = std::pair<
-	std::list<gmt::point2d>::iterator,
-	std::list<gmt::point2d>::iterator
+	typename std::list<point<T, 2>>::iterator,
+	typename std::list<point<T, 2>>::iterator
 >;
 
 /*
  * cyclic next iterator walk
  */
-std::list<gmt::point2d>::iterator merge_hull_next(
-	std::list<gmt::point2d>& l,
-	std::list<gmt::point2d>::iterator& i)
+template<typename T>
+typename std::list<point<T, 2>>::iterator merge_hull_next(
+	std::list<point<T, 2>>& l,
+	typename std::list<point<T, 2>>::iterator& i)
 {
 	if(std::next(i) == l.end()){
 		return l.begin();
@@ -32,9 +40,10 @@ std::list<gmt::point2d>::iterator merge_hull_next(
 /*
  * cyclic prev iterator walk
  */
-std::list<gmt::point2d>::iterator merge_hull_prev(
-	std::list<gmt::point2d>& l,
-	std::list<gmt::point2d>::iterator& i)
+template<typename T>
+typename std::list<point<T, 2>>::iterator merge_hull_prev(
+	std::list<point<T, 2>>& l,
+	typename std::list<point<T, 2>>::iterator& i)
 {
 	if(i == l.begin())
 		return std::prev(l.end());
@@ -49,17 +58,17 @@ std::list<gmt::point2d>::iterator merge_hull_prev(
  * (right_list, left_list, leftmost_from_right, rightmost_from_left)
  * the top tangent will be returned.
  */
-merge_hull_tangent get_tangent(
-	std::list<gmt::point2d>& first_list,
-	std::list<gmt::point2d>& second_list,
-	std::list<gmt::point2d>::iterator& first,
-	std::list<gmt::point2d>::iterator& second)
+template<typename T>
+merge_hull_tangent<T> get_tangent(
+	std::list<point<T, 2>>& first_list,
+	std::list<point<T, 2>>& second_list,
+	typename std::list<point<T, 2>>::iterator& first,
+	typename std::list<point<T, 2>>::iterator& second)
 {
-	merge_hull_tangent tangent(first, second);
-	merge_hull_tangent tangent_loop(first, second);
+	merge_hull_tangent<T> tangent(first, second);
 
 	bool first_t = false, second_t = false;
-	std::list<gmt::point2d>::iterator candidate;
+	typename std::list<point<T, 2>>::iterator candidate;
 	gmt::direction d;
 
 	while((first_t == false || second_t == false)){
@@ -76,10 +85,11 @@ merge_hull_tangent get_tangent(
 				tangent.second
 			);
 
-			d = direction_in(
+			d = robust_direction_in(
 				*tangent.first,
 				*tangent.second,
-				*candidate
+				*candidate,
+				GMT_PREDICATE_SITE("merge_hull")
 			);
 
 			switch(d){
@@ -113,10 +123,11 @@ merge_hull_tangent get_tangent(
 				tangent.first
 			);
 
-			d = direction_in(
+			d = robust_direction_in(
 				*tangent.first,
 				*tangent.second,
-				*candidate
+				*candidate,
+				GMT_PREDICATE_SITE("merge_hull")
 			);
 
 			switch(d){
@@ -155,11 +166,12 @@ merge_hull_tangent get_tangent(
   * @param left list of left points
   * @param right list of right points
   *
-  * @see merge_hull
+  * @see divide_and_conquer_hull
   */
-std::list<gmt::point2d> merge_hull_conquer(
-	std::list<gmt::point2d>& left,
-	std::list<gmt::point2d>& right)
+template<typename T>
+std::list<point<T, 2>> merge_hull_conquer(
+	std::list<point<T, 2>>& left,
+	std::list<point<T, 2>>& right)
 {
 
 	/*
@@ -242,14 +254,15 @@ std::list<gmt::point2d> merge_hull_conquer(
 /**
   * Merge hull auxiliar function.
   *
-  * @see merge_hull
+  * @see divide_and_conquer_hull
   */
-std::list<gmt::point2d> merge_hull_divide(
-	const std::vector<gmt::point2d>& sorted,
+template<typename T>
+std::list<point<T, 2>> merge_hull_divide(
+	const std::vector<point<T, 2>>& sorted,
 	size_t start,
 	size_t end)
 {
-	std::list<gmt::point2d> l;
+	std::list<point<T, 2>> l;
 
 	/*
 	 * treat the cases when the size is three, i.e., a triangle
@@ -260,10 +273,11 @@ std::list<gmt::point2d> merge_hull_divide(
 		size_t a = start;
 		size_t b = start+1;
 		size_t c = start+2;
-		switch(gmt::direction_in(
+		switch(gmt::robust_direction_in(
 				sorted[a],
 				sorted[b],
-				sorted[c])){
+				sorted[c],
+				GMT_PREDICATE_SITE("merge_hull"))){
 			case LEFT:
 				l.push_back(sorted[a]);
 				l.push_back(sorted[b]);
@@ -312,8 +326,8 @@ std::list<gmt::point2d> merge_hull_divide(
 	/*
 	 * divide and two subproblems
 	 */
-	std::list<gmt::point2d> left = merge_hull_divide(sorted, start, m);
-	std::list<gmt::point2d> right = merge_hull_divide(sorted, m, end);
+	std::list<point<T, 2>> left = merge_hull_divide(sorted, start, m);
+	std::list<point<T, 2>> right = merge_hull_divide(sorted, m, end);
 
 	/*
 	 * merge the responses from left and right
@@ -321,10 +335,141 @@ std::list<gmt::point2d> merge_hull_divide(
 	return merge_hull_conquer(left, right);
 }
 
+/*
+ * Andrew's monotone chain over the points of `ch`, which are sorted by
+ * `axis_comparator` and unique. The chain is built as a stack after the
+ * points, the lower hull from left to right and then the upper hull from
+ * right to left, and it is moved to the front of `ch` at the end, so the
+ * capacity of `ch` should be three times its size to not reallocate.
+ */
+template<typename T>
+void monotone_chain(polygon<T, 2>& ch)
+{
+	const size_t n = ch.size();
+	if(n < 2)
+		return;
+
+	predicate_counter* site = GMT_PREDICATE_SITE("monotone_chain_hull");
+
+	/*
+	 * each chain holds at most n points
+	 */
+	ch.resize(3*n);
+	size_t top = n;
+
+	/*
+	 * the collinear points are popped as well, only the turns to the
+	 * left stay
+	 */
+	for(size_t i=0; i<n; i++){
+		while(top >= n + 2
+			&& robust_direction_in(ch[top - 2], ch[top - 1], ch[i], site) != LEFT)
+			top--;
+
+		ch[top++] = ch[i];
+	}
+
+	const size_t lower = top;
+	for(size_t i=n-1; i-- > 0;){
+		while(top > lower
+			&& robust_direction_in(ch[top - 2], ch[top - 1], ch[i], site) != LEFT)
+			top--;
+
+		ch[top++] = ch[i];
+	}
+
+	/*
+	 * the upper chain ends at the first point
+	 */
+	top--;
+
+	std::move(ch.begin() + n, ch.begin() + top, ch.begin());
+	ch.resize(top - n);
+}
+
+/**
+  * Andrew's monotone chain algorithm to calculate the convex hull of a
+  * collection of points in O(n lg n). The points are copied to the
+  * polygon that is returned, sorted and deduplicated in place, and the
+  * hull is built in the same storage, so the only allocation is the one
+  * of the result.
+  *
+  * The points may have floating-point or integer coordinates, the
+  * directions are decided exactly in both cases.
+  *
+  * @param points		container of points
+  * @param filter_cutoff	number of points from which the points inside
+  *				the Akl-Toussaint octagon are discarded before
+  *				sorting
+  *
+  * @return	the convex polygon that contains all the points, in
+  *		counterclockwise order from the lowest of the leftmost points
+  *		and without collinear vertices
+  */
+template<typename list_container>
+auto monotone_chain_hull(
+	const list_container& points,
+	size_t filter_cutoff = akl_toussaint_cutoff)
+	-> polygon<typename list_container::value_type::value_type, 2>
+{
+	typedef typename list_container::value_type::value_type T;
+
+	polygon<T, 2> ch;
+	ch.reserve(3*points.size());
+	ch.assign(points.begin(), points.end());
+
+	if(ch.size() >= filter_cutoff)
+		ch.resize(akl_toussaint_filter(ch.data(), ch.size()));
+
+	std::sort(ch.begin(), ch.end(), axis_comparator());
+	ch.erase(std::unique(ch.begin(), ch.end()), ch.end());
+
+	monotone_chain(ch);
+	return ch;
+}
+
 /**
-  * Merge hull is a algorithm to calculate the convex hull of a collection
-  * of points. Merge hull is based on divide and conquer approach and it's
-  * complexity is O(n lg n).
+  * Monotone chain hull of the points in a structure-of-arrays buffer, the
+  * points are read from the columns straight into the result, and the
+  * ones inside the Akl-Toussaint octagon are not copied.
+  *
+  * @see monotone_chain_hull
+  */
+inline polygon2d monotone_chain_hull(
+	const point_buffer2d& points,
+	size_t filter_cutoff = akl_toussaint_cutoff)
+{
+	const double* x = points.x();
+	const double* y = points.y();
+	const size_t n = points.size();
+
+	polygon2d ch;
+	ch.reserve(3*n);
+
+	auto copy = [&](size_t i){ ch.push_back(point2d{ x[i], y[i] }); };
+
+	if(n >= filter_cutoff){
+		akl_toussaint_visit(x, y, n, copy);
+	}else{
+		for(size_t i=0; i<n; i++)
+			copy(i);
+	}
+
+	std::sort(ch.begin(), ch.end(), axis_comparator());
+	ch.erase(std::unique(ch.begin(), ch.end()), ch.end());
+
+	monotone_chain(ch);
+	return ch;
+}
+
+/**
+  * Divide and conquer algorithm to calculate the convex hull of a
+  * collection of points, the halves are merged by their tangents. It's
+  * complexity is O(n lg n), but it allocates a list node per point, see
+  * `monotone_chain_hull`.
+  *
+  * The points may have floating-point or integer coordinates, the
+  * directions are decided exactly in both cases.
   *
   * @param points	container of points
   *
@@ -333,12 +478,15 @@ std::list<gmt::point2d> merge_hull_divide(
   *
   */
 template<typename list_container>
-gmt::polygon2d merge_hull(const list_container& points)
+auto divide_and_conquer_hull(const list_container& points)
+	-> polygon<typename list_container::value_type::value_type, 2>
 {
+	typedef typename list_container::value_type::value_type T;
+
 	/*
 	 * create a set to sort and uniquely add a point
 	 */
-	std::set<point2d, axis_comparator> sorted_unique(
+	std::set<point<T, 2>, axis_comparator> sorted_unique(
 		points.begin(),
 		points.end(),
 		axis_comparator()
@@ -349,7 +497,7 @@ gmt::polygon2d merge_hull(const list_container& points)
 	 * list_container can be std::list which hasn't
 	 * random access to it's elements
 	 */
-	std::vector<gmt::point2d> sorted(
+	std::vector<point<T, 2>> sorted(
 		sorted_unique.begin(),
 		sorted_unique.end()
 	);
@@ -358,13 +506,13 @@ gmt::polygon2d merge_hull(const list_container& points)
 	 * call merge_hull_divide which returns a list of points
 	 * of the convex hull
 	 */
-	std::list<gmt::point2d> ch_list = merge_hull_divide(
+	std::list<point<T, 2>> ch_list = merge_hull_divide(
 		sorted,
 		0,
 		sorted.size()
 	);
 
-	polygon2d ch;
+	polygon<T, 2> ch;
 	ch.reserve(points.size());
 
 	/*
@@ -376,4 +524,617 @@ gmt::polygon2d merge_hull(const list_container& points)
 	return ch;
 }
 
+/**
+  * Divide and conquer hull of the points in a structure-of-arrays buffer.
+  * The points are read from the columns straight into the sorted vector
+  * used by the divide and conquer, without building an intermediate
+  * container.
+  *
+  * @see divide_and_conquer_hull
+  */
+inline gmt::polygon2d divide_and_conquer_hull(const point_buffer2d& points)
+{
+	const double* x = points.x();
+	const double* y = points.y();
+
+	std::vector<gmt::point2d> sorted;
+	sorted.reserve(points.size());
+
+	for(size_t i=0; i<points.size(); i++)
+		sorted.push_back(gmt::point2d{ x[i], y[i] });
+
+	std::sort(sorted.begin(), sorted.end(), axis_comparator());
+	sorted.erase(
+		std::unique(sorted.begin(), sorted.end()),
+		sorted.end());
+
+	std::list<gmt::point2d> ch_list = merge_hull_divide(
+		sorted,
+		0,
+		sorted.size()
+	);
+
+	polygon2d ch;
+	ch.reserve(ch_list.size());
+
+	for(auto& i : ch_list)
+		ch.push_back(i);
+
+	return ch;
+}
+
+/**
+  * number of points below which `parallel_hull` stops splitting the
+  * input, by default
+  */
+constexpr size_t parallel_hull_cutoff = size_t(1) << 16;
+
+/*
+ * parallel hull of the points of `ch`, which are replaced by the hull:
+ * the points are sorted in runs by the threads of `pool` and the runs are
+ * merged in a tree, then the slices of at most `cutoff` sorted points get
+ * their hulls by the monotone chain and the neighbouring hulls are merged
+ * by their tangents, with `merge_hull_conquer`, in a tree as well
+ */
+template<typename T>
+void parallel_hull_of(polygon<T, 2>& ch, thread_pool& pool, size_t cutoff)
+{
+	typedef std::list<point<T, 2>> hull_list;
+
+	cutoff = std::max<size_t>(cutoff, 3);
+
+	/*
+	 * runs of the sort, one per thread if there is enough work
+	 */
+	const size_t n = ch.size();
+	const size_t n_runs = std::max<size_t>(1, std::min(pool.size(), n/cutoff));
+
+	std::vector<size_t> runs(n_runs + 1);
+	for(size_t r=0; r<=n_runs; r++)
+		runs[r] = n*r/n_runs;
+
+	pool.parallel_for(n_runs, 1, [&](size_t begin, size_t end){
+		for(size_t r=begin; r<end; r++)
+			std::sort(ch.begin() + runs[r], ch.begin() + runs[r + 1], axis_comparator());
+	});
+
+	for(size_t width=1; width<n_runs; width *= 2){
+		const size_t n_pairs = (n_runs + 2*width - 1)/(2*width);
+
+		pool.parallel_for(n_pairs, 1, [&](size_t begin, size_t end){
+			for(size_t k=begin; k<end; k++){
+				size_t first = 2*width*k;
+				if(first + width >= n_runs)
+					continue;
+
+				std::inplace_merge(
+					ch.begin() + runs[first],
+					ch.begin() + runs[first + width],
+					ch.begin() + runs[std::min(first + 2*width, n_runs)],
+					axis_comparator());
+			}
+		});
+	}
+
+	ch.erase(std::unique(ch.begin(), ch.end()), ch.end());
+
+	const size_t m = ch.size();
+	if(m <= cutoff){
+		monotone_chain(ch);
+		return;
+	}
+
+	/*
+	 * hulls of the slices
+	 */
+	const size_t n_slices = (m + cutoff - 1)/cutoff;
+	std::vector<hull_list> hulls(n_slices);
+
+	pool.parallel_for(n_slices, 1, [&](size_t begin, size_t end){
+		polygon<T, 2> slice;
+		slice.reserve(3*cutoff);
+
+		for(size_t i=begin; i<end; i++){
+			slice.assign(
+				ch.begin() + m*i/n_slices,
+				ch.begin() + m*(i + 1)/n_slices);
+
+			monotone_chain(slice);
+			hulls[i].assign(slice.begin(), slice.end());
+		}
+	});
+
+	/*
+	 * reduction tree, the hull `i` absorbs the hull at its right
+	 */
+	for(size_t width=1; width<n_slices; width *= 2){
+		const size_t n_pairs = (n_slices + 2*width - 1)/(2*width);
+
+		pool.parallel_for(n_pairs, 1, [&](size_t begin, size_t end){
+			for(size_t k=begin; k<end; k++){
+				size_t left = 2*width*k;
+				if(left + width >= n_slices)
+					continue;
+
+				hulls[left] = merge_hull_conquer(hulls[left], hulls[left + width]);
+				hull_list().swap(hulls[left + width]);
+			}
+		});
+	}
+
+	/*
+	 * the hull starts at the lowest of the leftmost points, like the one
+	 * of `monotone_chain_hull`
+	 */
+	const point<T, 2> first = ch.front();
+
+	ch.assign(hulls.front().begin(), hulls.front().end());
+	std::rotate(ch.begin(), std::find(ch.begin(), ch.end(), first), ch.end());
+}
+
+/**
+  * Convex hull computed by the threads of `pool`, for very large
+  * collections of points. The points are sorted in parallel and cut in
+  * slices of at most `cutoff` points, the slices get their hulls
+  * concurrently by the monotone chain and the hulls are merged by their
+  * tangents in a parallel reduction tree. The result is the same of
+  * `monotone_chain_hull`.
+  *
+  * @param points		container of points
+  * @param pool			threads that compute the hull
+  * @param cutoff		maximum number of points of a slice solved
+  *				sequentially
+  * @param filter_cutoff	number of points from which the points inside
+  *				the Akl-Toussaint octagon are discarded before
+  *				sorting
+  */
+template<typename list_container>
+auto parallel_hull(
+	const list_container& points,
+	thread_pool& pool = default_thread_pool(),
+	size_t cutoff = parallel_hull_cutoff,
+	size_t filter_cutoff = akl_toussaint_cutoff)
+	-> polygon<typename list_container::value_type::value_type, 2>
+{
+	typedef typename list_container::value_type::value_type T;
+
+	polygon<T, 2> ch;
+	ch.reserve(3*points.size());
+	ch.assign(points.begin(), points.end());
+
+	if(ch.size() >= filter_cutoff)
+		ch.resize(akl_toussaint_filter(ch.data(), ch.size()));
+
+	parallel_hull_of(ch, pool, cutoff);
+	return ch;
+}
+
+/**
+  * @see parallel_hull
+  */
+inline polygon2d parallel_hull(
+	const point_buffer2d& points,
+	thread_pool& pool = default_thread_pool(),
+	size_t cutoff = parallel_hull_cutoff,
+	size_t filter_cutoff = akl_toussaint_cutoff)
+{
+	const double* x = points.x();
+	const double* y = points.y();
+	const size_t n = points.size();
+
+	polygon2d ch;
+	ch.reserve(3*n);
+
+	auto copy = [&](size_t i){ ch.push_back(point2d{ x[i], y[i] }); };
+
+	if(n >= filter_cutoff){
+		akl_toussaint_visit(x, y, n, copy);
+	}else{
+		for(size_t i=0; i<n; i++)
+			copy(i);
+	}
+
+	parallel_hull_of(ch, pool, cutoff);
+	return ch;
+}
+
+/*
+ * first index of `[0, n)` for which `before(i)` is false, `before` is true
+ * for a prefix of the indices
+ */
+template<typename predicate>
+size_t chan_search(size_t n, const predicate& before)
+{
+	size_t lo = 0, hi = n;
+
+	while(lo < hi){
+		size_t mid = lo + (hi - lo)/2;
+
+		if(before(mid))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/*
+ * edges of the upper chain `c[0, n)`, sorted by `axis_comparator` and
+ * turning to the right, that have `q` strictly to their left, as the
+ * range of the indices of their first vertices. It is the search of
+ * `dynamic_hull_chain::seen_from` over an array.
+ */
+template<typename T>
+std::pair<size_t, size_t> chain_seen_from(
+	const point<T, 2>* c,
+	size_t n,
+	const point<T, 2>& q,
+	predicate_counter* site)
+{
+	auto seen = [&](size_t i){
+		return i + 1 < n
+			&& robust_direction_in(c[i], c[i + 1], q, site) == LEFT;
+	};
+
+	auto before_q = [&](size_t i){
+		return i + 1 < n
+			&& (c[i].x() < q.x()
+				|| (c[i].x() == q.x() && c[i + 1].x() == q.x()));
+	};
+
+	size_t first = chan_search(n, [&](size_t i){
+		return before_q(i) && !seen(i);
+	});
+
+	size_t last = chan_search(n, [&](size_t i){
+		return before_q(i) || seen(i);
+	});
+
+	return std::make_pair(first, last);
+}
+
+/*
+ * hulls of the groups of points of Chan's algorithm, each one as the
+ * upper chain of the hull and the upper chain of the hull reflected
+ * through the origin, like the chains of `dynamic_hull`, so the vertex
+ * that follows a point outside a hull is found in O(lg m)
+ */
+template<typename T>
+class chan_groups {
+public:
+	typedef point<T, 2> point_type;
+
+	chan_groups()
+		: m_upper_offsets(1, 0), m_lower_offsets(1, 0)
+	{}
+
+	size_t size() const noexcept
+	{
+		return m_upper_offsets.size() - 1;
+	}
+
+	/*
+	 * adds the hull `ch` in the order of `monotone_chain`
+	 */
+	void add(const polygon<T, 2>& ch)
+	{
+		const size_t h = ch.size();
+		const size_t k = std::max_element(ch.begin(), ch.end(), axis_comparator()) - ch.begin();
+
+		m_upper.push_back(ch[0]);
+		for(size_t i=h-1; i>=k && i>0; i--)
+			m_upper.push_back(ch[i]);
+
+		for(size_t i=k+1; i-- > 0;)
+			m_lower.push_back(-ch[i]);
+
+		m_upper_offsets.push_back(m_upper.size());
+		m_lower_offsets.push_back(m_lower.size());
+	}
+
+	/*
+	 * calls `f` with the vertex of the hull of the group `g` that
+	 * follows `p` when the hull is wrapped from `p`, `p` being a vertex
+	 * of the hull of all the points. It is the end of the part of the
+	 * hull seen from `p`, or the vertex after `p` if `p` is a vertex of
+	 * the group, or any of the vertices if the group hull has no area.
+	 */
+	template<typename visitor>
+	void candidates(
+		size_t g,
+		const point_type& p,
+		predicate_counter* site,
+		const visitor& f) const
+	{
+		const point_type* u = m_upper.data() + m_upper_offsets[g];
+		const point_type* l = m_lower.data() + m_lower_offsets[g];
+		const size_t nu = m_upper_offsets[g + 1] - m_upper_offsets[g];
+		const size_t nl = m_lower_offsets[g + 1] - m_lower_offsets[g];
+
+		/*
+		 * a vertex is given by its chain and its position
+		 */
+		auto vertex = [&](bool upper, size_t i){
+			return upper ? u[i] : point_type(-l[i]);
+		};
+
+		auto next = [&](bool upper, size_t i) -> std::optional<point_type> {
+			if(i > 0)
+				return vertex(upper, i - 1);
+
+			size_t n = upper ? nl : nu;
+			if(n < 2)
+				return std::nullopt;
+
+			return vertex(!upper, n - 2);
+		};
+
+		auto su = chain_seen_from(u, nu, p, site);
+		auto sl = chain_seen_from(l, nl, point_type(-p), site);
+
+		bool seen_u = su.first != su.second;
+		bool seen_l = sl.first != sl.second;
+
+		if(seen_u || seen_l){
+			/*
+			 * the seen edges go around the leftmost or the rightmost
+			 * vertex when both chains have some, like in
+			 * `dynamic_hull::tangents`
+			 */
+			bool upper = seen_u && !(seen_l && u[su.first] == -l[sl.second]);
+			size_t i = upper ? su.first : sl.first;
+
+			point_type v = vertex(upper, i);
+			auto w = next(upper, i);
+
+			/*
+			 * the group has no collinear vertices, only the next one
+			 * can be farther in the same line
+			 */
+			if(w && robust_direction_in(p, v, *w, site) == ON && is_between(p, *w, v))
+				f(*w);
+			else
+				f(v);
+
+			return;
+		}
+
+		if(nu + nl <= 4){
+			f(u[0]);
+			f(u[nu - 1]);
+			return;
+		}
+
+		size_t i = chan_search(nu, [&](size_t j){
+			return axis_comparator()(u[j], p);
+		});
+
+		if(i < nu && u[i] == p){
+			if(auto w = next(true, i))
+				f(*w);
+			return;
+		}
+
+		const point_type r = -p;
+		i = chan_search(nl, [&](size_t j){
+			return axis_comparator()(l[j], r);
+		});
+
+		if(i < nl && l[i] == r){
+			if(auto w = next(false, i))
+				f(*w);
+		}
+	}
+
+private:
+	std::vector<point_type> m_upper, m_lower;
+	std::vector<size_t> m_upper_offsets, m_lower_offsets;
+};
+
+/*
+ * one round of Chan's algorithm: the points of `points` are cut in
+ * groups of `m`, the groups get their hulls by the monotone chain and the
+ * hull of all the points is wrapped from `start` with the vertices that
+ * the groups give. It fails if the hull has more than `m` vertices. Only
+ * the vertices of the hulls of the groups can be vertices of the hull,
+ * so they replace `points` for the next round.
+ */
+template<typename T>
+bool chan_round(
+	polygon<T, 2>& points,
+	const point<T, 2>& start,
+	size_t m,
+	polygon<T, 2>& hull,
+	predicate_counter* site)
+{
+	const size_t n = points.size();
+
+	chan_groups<T> groups;
+	polygon<T, 2> slice;
+	slice.reserve(3*m);
+
+	size_t kept = 0;
+	for(size_t first=0; first<n; first += m){
+		slice.assign(points.begin() + first, points.begin() + std::min(n, first + m));
+
+		std::sort(slice.begin(), slice.end(), axis_comparator());
+		slice.erase(std::unique(slice.begin(), slice.end()), slice.end());
+
+		monotone_chain(slice);
+		groups.add(slice);
+
+		kept = std::copy(slice.begin(), slice.end(), points.begin() + kept) - points.begin();
+	}
+
+	points.resize(kept);
+
+	hull.clear();
+	hull.push_back(start);
+
+	for(;;){
+		const point<T, 2> p = hull.back();
+		std::optional<point<T, 2>> best;
+
+		/*
+		 * the next vertex leaves every point to its left, the farthest
+		 * one wins among the collinear
+		 */
+		for(size_t g=0; g<groups.size(); g++){
+			groups.candidates(g, p, site, [&](const point<T, 2>& c){
+				if(c == p)
+					return;
+
+				if(!best){
+					best = c;
+					return;
+				}
+
+				direction d = robust_direction_in(p, *best, c, site);
+				if(d == RIGHT || (d == ON && is_between(p, c, *best)))
+					best = c;
+			});
+		}
+
+		if(!best || *best == start)
+			return true;
+
+		if(hull.size() == m)
+			return false;
+
+		hull.push_back(*best);
+	}
+}
+
+/*
+ * Chan's algorithm over the points of `ch`, which are replaced by the
+ * hull. The rounds start with groups of `hint` points, or 16, and square
+ * the size of the groups until it is not smaller than the hull. The
+ * wrapping does not pay off for groups larger than the cube root of the
+ * number of points, the points left then get their hull by the monotone
+ * chain, in O(n lg n) = O(n lg h) for such large hulls.
+ */
+template<typename T>
+void chan_hull_of(polygon<T, 2>& ch, size_t hint)
+{
+	if(ch.empty())
+		return;
+
+	predicate_counter* site = GMT_PREDICATE_SITE("chan_hull");
+
+	const point<T, 2> start = *std::min_element(ch.begin(), ch.end(), axis_comparator());
+
+	size_t m = std::max<size_t>(hint, 16);
+	polygon<T, 2> hull;
+
+	for(;;){
+		const size_t n = ch.size();
+
+		if(m > (size_t(1) << 20) || m*m*m > n)
+			break;
+
+		if(chan_round(ch, start, m, hull, site)){
+			ch = std::move(hull);
+			return;
+		}
+
+		m = m*m;
+	}
+
+	ch.reserve(3*ch.size());
+	std::sort(ch.begin(), ch.end(), axis_comparator());
+	ch.erase(std::unique(ch.begin(), ch.end()), ch.end());
+
+	monotone_chain(ch);
+}
+
+/**
+  * Chan's output-sensitive algorithm to calculate the convex hull of a
+  * collection of points in O(n lg h), for a hull of h vertices. The
+  * points are cut in groups whose hulls are computed by the monotone
+  * chain, and the hull of all the points is wrapped with a binary search
+  * in each group per vertex. The size of the groups is guessed in rounds,
+  * squared after each round that finds more than that many vertices.
+  *
+  * The result is the same of `monotone_chain_hull`, in counterclockwise
+  * order from the lowest of the leftmost points and without collinear
+  * vertices, with the directions decided exactly.
+  *
+  * @param points		container of points
+  * @param hint			expected number of vertices of the hull, the
+  *				first round uses groups of this size, so a
+  *				hint not smaller than the hull skips the
+  *				guesses
+  * @param filter_cutoff	number of points from which the points inside
+  *				the Akl-Toussaint octagon are discarded first
+  */
+template<typename list_container>
+auto chan_hull(
+	const list_container& points,
+	size_t hint = 0,
+	size_t filter_cutoff = akl_toussaint_cutoff)
+	-> polygon<typename list_container::value_type::value_type, 2>
+{
+	typedef typename list_container::value_type::value_type T;
+
+	polygon<T, 2> ch;
+	ch.assign(points.begin(), points.end());
+
+	if(ch.size() >= filter_cutoff)
+		ch.resize(akl_toussaint_filter(ch.data(), ch.size()));
+
+	chan_hull_of(ch, hint);
+	return ch;
+}
+
+/**
+  * @see chan_hull
+  */
+inline polygon2d chan_hull(
+	const point_buffer2d& points,
+	size_t hint = 0,
+	size_t filter_cutoff = akl_toussaint_cutoff)
+{
+	const double* x = points.x();
+	const double* y = points.y();
+	const size_t n = points.size();
+
+	polygon2d ch;
+	ch.reserve(n);
+
+	auto copy = [&](size_t i){ ch.push_back(point2d{ x[i], y[i] }); };
+
+	if(n >= filter_cutoff){
+		akl_toussaint_visit(x, y, n, copy);
+	}else{
+		for(size_t i=0; i<n; i++)
+			copy(i);
+	}
+
+	chan_hull_of(ch, hint);
+	return ch;
+}
+
+/**
+  * Convex hull of a collection of points in O(n lg n), it is computed by
+  * `monotone_chain_hull`, after the Akl-Toussaint filter for large inputs,
+  * the divide and conquer version is kept as `divide_and_conquer_hull`.
+  *
+  * @param points	container of points
+  *
+  * @return	a convex polygon that contains all the points in the `points`
+  * 		collection
+  */
+template<typename list_container>
+auto merge_hull(const list_container& points)
+	-> polygon<typename list_container::value_type::value_type, 2>
+{
+	return monotone_chain_hull(points);
+}
+
+inline polygon2d merge_hull(const point_buffer2d& points)
+{
+	return monotone_chain_hull(points);
+}
+
 }
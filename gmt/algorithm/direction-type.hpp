@@ -0,0 +1,14 @@
+#pragma once
+
+namespace gmt {
+
+/**
+  * direction of a point in reference of a segment
+  */
+typedef enum direction {
+	LEFT,
+	RIGHT,
+	ON
+} direction;
+
+}
@@ -1,18 +1,16 @@
 #pragma once
 
+#include <type_traits>
+
 #include <gmt/polygon.hpp>
 #include <gmt/vec.hpp>
 #include <gmt/algorithm/misc.hpp>
+#include <gmt/algorithm/direction-type.hpp>
+#include <gmt/algorithm/batch-direction.hpp>
 #include <gmt/pi.hpp>
 
 namespace gmt {
 
-typedef enum direction {
-	LEFT,
-	RIGHT,
-	ON
-} direction;
-
 typedef enum vertex_type {
 	REGULAR,
 	START,
@@ -21,6 +19,22 @@ typedef enum vertex_type {
 	MERGE
 } vertex_type;
 
+/*
+ * direction given the exact signed area of the integer kernel, the
+ * tolerance is truncated to an integer
+ */
+inline direction integer_direction(wide_int area, double e)
+{
+	wide_int tolerance = (e > 0.0) ? wide_int(e) : 0;
+
+	if(area == 0 || (area < 0 ? -area : area) <= tolerance)
+		return ON;
+	else if(area < 0)
+		return RIGHT;
+	else
+		return LEFT;
+}
+
 /** Calculates the direction of point `p2` in reference
   * of segment of `p0` and `p1`
   *
@@ -31,16 +45,25 @@ direction direction_in(
 	const vec<T, 2>& v1,
 	double e = 0.0)
 {
-	double tmp = signed_parallelogram_area(v0, v1);
-
-	if(is_equal(tmp, 0.0, e))
-		return ON;
-	else if(tmp < 0.0)
-		return RIGHT;
-	else
-		return LEFT;
+	if constexpr(std::is_integral<T>::value){
+		wide_int area = wide_int(v0.x())*v1.y() - wide_int(v0.y())*v1.x();
+		return integer_direction(area, e);
+	}else{
+		double tmp = signed_parallelogram_area(v0, v1);
+
+		if(is_equal(tmp, 0.0, e))
+			return ON;
+		else if(tmp < 0.0)
+			return RIGHT;
+		else
+			return LEFT;
+	}
 }
 
+/*
+ * integer coordinates use the exact integer kernel, the differences of
+ * the points are not computed in T, so they do not overflow
+ */
 template<typename T>
 direction direction_in(
 	const point<T, 2>& p0,
@@ -48,7 +71,12 @@ direction direction_in(
 	const point<T, 2>& p2,
 	double e = 0.0)
 {
-	return direction_in(vec<T, 2>(p0, p1), vec<T, 2>(p0, p2), e);
+	if constexpr(std::is_integral<T>::value)
+		return integer_direction(
+			exact_signed_parallelogram_area(p0, p1, p2),
+			e);
+	else
+		return direction_in(vec<T, 2>(p0, p1), vec<T, 2>(p0, p2), e);
 }
 
 template<typename T>
@@ -96,6 +124,47 @@ bool is_reflex(const polygon<T, n_dimension>& poly, std::size_t i)
 	return d == LEFT;
 }
 
+/** Checks whether some vertex of the polygon `poly` that is not a
+  * corner of the triangle (`a`, `b`, `c`) lies on the `side` of the three
+  * edges of the triangle. The vertices after `c` and before `a` are
+  * classified with the batch direction kernel, a block at a time.
+  */
+inline bool has_vertex_in_triangle(
+	const polygon<double, 2>& poly,
+	std::size_t a,
+	std::size_t b,
+	std::size_t c,
+	direction side)
+{
+	packed_direction d0[direction_block];
+	packed_direction d1[direction_block];
+	packed_direction d2[direction_block];
+
+	const std::size_t n = poly.size();
+	const std::size_t first = (c + 1)%n;
+	const std::size_t count = (a + n - first)%n;
+
+	for(std::size_t done = 0; done < count;){
+		std::size_t start = (first + done)%n;
+		std::size_t len = std::min(
+			direction_block,
+			std::min(count - done, n - start));
+
+		const point2d* points = poly.data() + start;
+		direction_batch(poly[a], poly[b], points, len, d0);
+		direction_batch(poly[b], poly[c], points, len, d1);
+		direction_batch(poly[c], poly[a], points, len, d2);
+
+		for(std::size_t k=0; k<len; k++)
+			if(d0[k] == side && d1[k] == side && d2[k] == side)
+				return true;
+
+		done += len;
+	}
+
+	return false;
+}
+
 /** Checks whether the vertex `index` of the polygon `poly` is
   * an ear
   *
@@ -114,6 +183,14 @@ bool is_ear(const polygon<T, n_dimension>& poly, std::size_t index)
 				? poly.size() - 1
 				: index - 1;
 
+	if constexpr(std::is_same<T, double>::value && n_dimension == 2)
+		return !has_vertex_in_triangle(
+			poly,
+			prev_index,
+			index,
+			next_index,
+			LEFT);
+
 	for(	std::size_t i = (next_index + 1)%poly.size();
 		i != prev_index;
 		i = (i+1)%poly.size())
@@ -149,6 +226,14 @@ bool is_mouth(const polygon<T, n_dimension>& poly, std::size_t index)
 				? poly.size() - 1
 				: index - 1;
 
+	if constexpr(std::is_same<T, double>::value && n_dimension == 2)
+		return !has_vertex_in_triangle(
+			poly,
+			prev_index,
+			index,
+			next_index,
+			RIGHT);
+
 	for(	std::size_t i = (next_index + 1)%poly.size();
 		i != prev_index;
 		i = (i+1)%poly.size())
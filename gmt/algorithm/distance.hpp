@@ -1,6 +1,7 @@
 #pragma once
 
 #include <gmt/point.hpp>
+#include <gmt/point-buffer.hpp>
 #include <gmt/vec.hpp>
 
 namespace gmt {
@@ -54,4 +55,87 @@ double distance(
 	return distance(p, point_near);
 }
 
+/**
+  * calculates the nearest point from a segment to every point of
+  * `points`, the result `i` is written in the position `i` of `nearest`
+  *
+  * @see nearest_point
+  */
+template<typename T, std::size_t n_dimension>
+void nearest_point(
+	const point_buffer<T, n_dimension>& points,
+	const segment<T, n_dimension>& seg,
+	point_buffer<T, n_dimension>& nearest)
+{
+	const size_t n = points.size();
+	nearest.resize(n);
+
+	gmt::vec<T, n_dimension> vseg(seg);
+	double norm_squared = vseg.norm_squared();
+
+	// s0 == s1
+	if(norm_squared == 0){
+		for(size_t a=0; a<n_dimension; a++){
+			T* out = nearest.column(a);
+			for(size_t i=0; i<n; i++)
+				out[i] = seg.from[a];
+		}
+
+		return;
+	}
+
+	for(size_t i=0; i<n; i++){
+		double dot_product = 0.0;
+		for(size_t a=0; a<n_dimension; a++)
+			dot_product += vseg[a]*(points.column(a)[i] - seg.from[a]);
+
+		double h = dot_product/norm_squared;
+		T nearest_projection = std::max(0.0, std::min(1.0, h));
+
+		for(size_t a=0; a<n_dimension; a++)
+			nearest.column(a)[i] =
+				seg.from[a] + vseg[a]*nearest_projection;
+	}
+}
+
+/**
+  * calculates the distance of every point of `points` to the segment
+  * `seg`, the distance of the point `i` is written in `out[i]`
+  */
+template<typename T, std::size_t n_dimension>
+void distance(
+	const point_buffer<T, n_dimension>& points,
+	const segment<T, n_dimension>& seg,
+	double* out)
+{
+	const size_t n = points.size();
+
+	gmt::vec<T, n_dimension> vseg(seg);
+	double norm_squared = vseg.norm_squared();
+
+	for(size_t i=0; i<n; i++){
+		double h = 0.0;
+
+		if(norm_squared != 0){
+			double dot_product = 0.0;
+			for(size_t a=0; a<n_dimension; a++)
+				dot_product += vseg[a]
+					*(points.column(a)[i] - seg.from[a]);
+
+			h = std::max(0.0, std::min(1.0, dot_product/norm_squared));
+		}
+
+		T nearest_projection = h;
+		double sum = 0.0;
+
+		for(size_t a=0; a<n_dimension; a++){
+			T near = seg.from[a] + vseg[a]*nearest_projection;
+			T d = near - points.column(a)[i];
+			sum += d*d;
+		}
+
+		out[i] = std::sqrt(sum);
+	}
+}
+
 }
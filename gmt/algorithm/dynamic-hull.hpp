@@ -0,0 +1,534 @@
+#pragma once
+
+#include <iterator>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/vec.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/algorithm/comparators.hpp>
+#include <gmt/algorithm/direction.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+namespace gmt {
+
+/**
+  * Upper chain of a set of points: the vertices sorted by their first
+  * axis and then by the second, with a strict turn to the right at each
+  * one. The chain starts in the lowest of the leftmost points and ends in
+  * the highest of the rightmost ones.
+  *
+  * Every vertex keeps a copy of the next one, so the searches that look
+  * at the edges run in O(lg n) over the `std::set`.
+  */
+template<typename T>
+class dynamic_hull_chain {
+public:
+	typedef point<T, 2> point_type;
+
+	struct vertex {
+		point_type p;
+		mutable point_type next;
+		mutable bool has_next;
+	};
+
+	/*
+	 * key of a binary search over the vertices, `before(v)` is true for
+	 * the vertices before the answer and false for the others
+	 */
+	template<typename predicate>
+	struct search {
+		predicate before;
+	};
+
+	struct order {
+		typedef void is_transparent;
+
+		static bool less(const point_type& a, const point_type& b)
+		{
+			return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
+		}
+
+		bool operator()(const vertex& a, const vertex& b) const
+		{
+			return less(a.p, b.p);
+		}
+
+		bool operator()(const vertex& a, const point_type& b) const
+		{
+			return less(a.p, b);
+		}
+
+		bool operator()(const point_type& a, const vertex& b) const
+		{
+			return less(a, b.p);
+		}
+
+		template<typename predicate>
+		bool operator()(const vertex& v, const search<predicate>& s) const
+		{
+			return s.before(v);
+		}
+
+		template<typename predicate>
+		bool operator()(const search<predicate>& s, const vertex& v) const
+		{
+			return !s.before(v);
+		}
+	};
+
+	typedef std::set<vertex, order> vertex_set;
+	typedef typename vertex_set::const_iterator iterator;
+
+	const vertex_set& vertices() const noexcept
+	{
+		return m_vertices;
+	}
+
+	size_t size() const noexcept
+	{
+		return m_vertices.size();
+	}
+
+	void clear() noexcept
+	{
+		m_vertices.clear();
+	}
+
+	/**
+	  * adds `p` to the set of points in O(lg n) amortized, each vertex
+	  * that stops being part of the chain is removed once
+	  *
+	  * @return whether the chain has changed
+	  */
+	bool insert(const point_type& p, predicate_counter* site)
+	{
+		auto right = m_vertices.lower_bound(p);
+
+		if(right != m_vertices.end()){
+			if(right->p == p)
+				return false;
+
+			/*
+			 * below or on the edge over it
+			 */
+			if(right != m_vertices.begin()
+				&& robust_direction_in(std::prev(right)->p, right->p, p, site) != LEFT)
+				return false;
+		}
+
+		auto it = m_vertices.insert(right, vertex{ p, p, false });
+
+		while(it != m_vertices.begin()){
+			auto q = std::prev(it);
+			if(q == m_vertices.begin()
+				|| robust_direction_in(std::prev(q)->p, q->p, p, site) == RIGHT)
+				break;
+
+			m_vertices.erase(q);
+		}
+
+		for(;;){
+			auto q = std::next(it);
+			if(q == m_vertices.end()
+				|| std::next(q) == m_vertices.end()
+				|| robust_direction_in(p, q->p, std::next(q)->p, site) == RIGHT)
+				break;
+
+			m_vertices.erase(q);
+		}
+
+		link(it);
+		if(it != m_vertices.begin())
+			link(std::prev(it));
+
+		return true;
+	}
+
+	/**
+	  * removes `p` of the set of points. If it is a vertex, the part of
+	  * the chain between its neighbours is built again from the points
+	  * between them, given by `points_between(lo, hi)` in the order of
+	  * the chain, from `*lo` to `*hi` or from the first or up to the last
+	  * point when they are `nullptr`. The cost is O(k + lg n) for the k
+	  * points between the neighbours.
+	  *
+	  * @return whether the chain has changed
+	  */
+	template<typename source>
+	bool erase(
+		const point_type& p,
+		const source& points_between,
+		predicate_counter* site)
+	{
+		auto it = m_vertices.find(p);
+		if(it == m_vertices.end())
+			return false;
+
+		std::optional<point_type> lo, hi;
+		if(it != m_vertices.begin())
+			lo = std::prev(it)->p;
+		if(std::next(it) != m_vertices.end())
+			hi = std::next(it)->p;
+
+		auto right = m_vertices.erase(it);
+
+		std::vector<point_type> points = points_between(
+			lo ? &*lo : nullptr,
+			hi ? &*hi : nullptr
+		);
+
+		/*
+		 * the same stack of the monotone chain, with the turns to the
+		 * right
+		 */
+		size_t top = 0;
+		for(size_t i=0; i<points.size(); i++){
+			while(top >= 2
+				&& robust_direction_in(points[top - 2], points[top - 1], points[i], site) != RIGHT)
+				top--;
+
+			points[top++] = points[i];
+		}
+
+		/*
+		 * the neighbours are part of the new chain already
+		 */
+		size_t first = lo ? 1 : 0;
+		size_t last = hi ? top - 1 : top;
+
+		for(size_t i=first; i<last; i++)
+			m_vertices.insert(right, vertex{ points[i], points[i], false });
+
+		auto end = (right == m_vertices.end()) ? right : std::next(right);
+		auto begin = m_vertices.begin();
+		if(lo)
+			begin = m_vertices.find(*lo);
+
+		for(auto v = begin; v != end; ++v)
+			link(v);
+
+		return true;
+	}
+
+	/**
+	  * vertex that maximizes the dot product with `u`, where the second
+	  * axis of `u` is positive, or zero and the first is positive. The
+	  * dot products are computed in floating-point, the answer may be a
+	  * neighbour of the exact one when they tie up to rounding.
+	  */
+	template<typename S>
+	iterator extreme(const vec<S, 2>& u) const
+	{
+		auto ascends = [&u](const vertex& v){
+			if(!v.has_next)
+				return false;
+
+			double dx = double(v.next.x()) - double(v.p.x());
+			double dy = double(v.next.y()) - double(v.p.y());
+			return double(u.x())*dx + double(u.y())*dy > 0.0;
+		};
+
+		return m_vertices.lower_bound(make_search(ascends));
+	}
+
+	/**
+	  * edges of the chain that `q` sees, i.e., the edges that have `q`
+	  * strictly to their left, as the range of vertices `[first, last)`
+	  * whose edges to the next vertices are seen, so the seen part of the
+	  * chain goes from `first` to `last`. The range is empty if `q` sees
+	  * none.
+	  *
+	  * The lines of the edges before `q` cross the vertical of `q` lower
+	  * and lower, and the ones after it higher and higher, so the seen
+	  * edges are a suffix of the first ones and a prefix of the others.
+	  */
+	std::pair<iterator, iterator> seen_from(
+		const point_type& q,
+		predicate_counter* site) const
+	{
+		auto seen = [&q, site](const vertex& v){
+			return v.has_next
+				&& robust_direction_in(v.p, v.next, q, site) == LEFT;
+		};
+
+		/*
+		 * a vertical edge only starts the chain, it goes with the edges
+		 * before `q` when it is on the vertical of `q`. The last vertex
+		 * starts no edge and goes after `q`.
+		 */
+		auto before_q = [&q](const vertex& v){
+			return v.has_next
+				&& (v.p.x() < q.x()
+					|| (v.p.x() == q.x() && v.next.x() == q.x()));
+		};
+
+		auto first = m_vertices.lower_bound(make_search(
+			[&](const vertex& v){ return before_q(v) && !seen(v); }
+		));
+
+		auto last = m_vertices.lower_bound(make_search(
+			[&](const vertex& v){ return before_q(v) || seen(v); }
+		));
+
+		return std::make_pair(first, last);
+	}
+
+private:
+	vertex_set m_vertices;
+
+	template<typename predicate>
+	static search<predicate> make_search(const predicate& before)
+	{
+		return search<predicate>{ before };
+	}
+
+	void link(iterator it)
+	{
+		auto next = std::next(it);
+
+		it->has_next = next != m_vertices.end();
+		if(it->has_next)
+			it->next = next->p;
+	}
+};
+
+/**
+  * Convex hull of a set of points that changes one point at a time. The
+  * hull is kept as its upper and lower chains, the lower one as the
+  * upper chain of the points reflected through the origin, so the
+  * insertions take O(lg n) amortized and the queries O(lg n) without
+  * building the hull again.
+  *
+  * The removals of points inside the hull take O(lg n) as well. The
+  * removal of a vertex builds the chains again between its neighbours
+  * from the points between them, which takes time proportional to the
+  * number of those points, see `dynamic_hull_chain::erase`.
+  *
+  * The points may have floating-point or integer coordinates, the
+  * directions are decided exactly in both cases.
+  */
+template<typename T>
+class dynamic_hull {
+public:
+	typedef point<T, 2> point_type;
+
+	dynamic_hull()
+		: m_site(GMT_PREDICATE_SITE("dynamic_hull"))
+	{}
+
+	template<typename list_container>
+	explicit dynamic_hull(const list_container& points)
+		: dynamic_hull()
+	{
+		for(const auto& p : points)
+			insert(p);
+	}
+
+	/**
+	  * number of points, with the repeated ones
+	  */
+	size_t size() const noexcept
+	{
+		return m_points.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return m_points.empty();
+	}
+
+	void clear() noexcept
+	{
+		m_points.clear();
+		m_upper.clear();
+		m_lower.clear();
+		m_changed = true;
+	}
+
+	/**
+	  * adds a point, O(lg n) amortized
+	  */
+	void insert(const point_type& p)
+	{
+		m_points.insert(p);
+
+		bool upper = m_upper.insert(p, m_site);
+		bool lower = m_lower.insert(-p, m_site);
+
+		m_changed = m_changed || upper || lower;
+	}
+
+	/**
+	  * removes one copy of the point `p`
+	  *
+	  * @return false if `p` is not one of the points
+	  */
+	bool erase(const point_type& p)
+	{
+		auto it = m_points.find(p);
+		if(it == m_points.end())
+			return false;
+
+		m_points.erase(it);
+		if(m_points.count(p))
+			return true;
+
+		auto upper_between = [this](const point_type* lo, const point_type* hi){
+			auto first = lo ? m_points.lower_bound(*lo) : m_points.begin();
+			auto last = hi ? m_points.upper_bound(*hi) : m_points.end();
+
+			std::vector<point_type> points;
+			for(auto i = first; i != last; ++i)
+				if(points.empty() || points.back() != *i)
+					points.push_back(*i);
+
+			return points;
+		};
+
+		/*
+		 * the lower chain is in the reflected points, its order is the
+		 * reverse one
+		 */
+		auto lower_between = [this](const point_type* lo, const point_type* hi){
+			auto first = hi ? m_points.lower_bound(-*hi) : m_points.begin();
+			auto last = lo ? m_points.upper_bound(-*lo) : m_points.end();
+
+			std::vector<point_type> points;
+			for(auto i = last; i != first;){
+				point_type r = -*--i;
+				if(points.empty() || points.back() != r)
+					points.push_back(r);
+			}
+
+			return points;
+		};
+
+		bool upper = m_upper.erase(p, upper_between, m_site);
+		bool lower = m_lower.erase(-p, lower_between, m_site);
+
+		m_changed = m_changed || upper || lower;
+		return true;
+	}
+
+	/**
+	  * number of vertices of the hull
+	  */
+	size_t n_vertices() const noexcept
+	{
+		size_t n = m_upper.size() + m_lower.size();
+		return (n > 2) ? n - 2 : n/2;
+	}
+
+	/**
+	  * the hull in counterclockwise order from the lowest of the leftmost
+	  * points and without collinear vertices, the same polygon of
+	  * `monotone_chain_hull` of the points. It is kept between the calls
+	  * and only copied again from the chains after the hull changes.
+	  */
+	const polygon<T, 2>& hull() const
+	{
+		if(!m_changed)
+			return m_hull;
+
+		m_hull.clear();
+		m_hull.reserve(n_vertices());
+
+		const auto& lower = m_lower.vertices();
+		for(auto it = lower.rbegin(); it != lower.rend(); ++it)
+			m_hull.push_back(-it->p);
+
+		const auto& upper = m_upper.vertices();
+		if(upper.size() > 2)
+			for(auto it = std::next(upper.rbegin()); it != std::prev(upper.rend()); ++it)
+				m_hull.push_back(it->p);
+
+		m_changed = false;
+		return m_hull;
+	}
+
+	/**
+	  * vertex of the hull that is the farthest in the direction `u`, in
+	  * O(lg n)
+	  *
+	  * @return the vertex, or std::nullopt if there are no points
+	  */
+	template<typename S>
+	std::optional<point_type> extreme(const vec<S, 2>& u) const
+	{
+		if(empty())
+			return std::nullopt;
+
+		if(u.y() > 0 || (u.y() == 0 && u.x() > 0))
+			return m_upper.extreme(u)->p;
+
+		return -m_lower.extreme(vec<S, 2>(-u))->p;
+	}
+
+	/**
+	  * vertices where the lines through `q` touch the hull, in O(lg n).
+	  * The hull is to the right of the line from `q` to the first one and
+	  * to the left of the line from `q` to the second one, the edges
+	  * between them in counterclockwise order are the ones seen from `q`.
+	  *
+	  * @return the pair of vertices, or std::nullopt if `q` sees no edge
+	  *	    of the hull: it is inside or on the hull, or the hull has
+	  *	    no area and `q` is on its line
+	  */
+	std::optional<std::pair<point_type, point_type>> tangents(
+		const point_type& q) const
+	{
+		if(empty())
+			return std::nullopt;
+
+		/*
+		 * the chains are seen in clockwise order, from the start of the
+		 * range to its end, and the lower one in the reflected points
+		 */
+		auto upper = m_upper.seen_from(q, m_site);
+		auto lower = m_lower.seen_from(-q, m_site);
+
+		bool sees_upper = upper.first != upper.second;
+		bool sees_lower = lower.first != lower.second;
+
+		if(!sees_upper && !sees_lower)
+			return std::nullopt;
+
+		std::pair<point_type, point_type> upper_ccw, lower_ccw;
+		if(sees_upper)
+			upper_ccw = std::make_pair(upper.second->p, upper.first->p);
+		if(sees_lower)
+			lower_ccw = std::make_pair(-lower.second->p, -lower.first->p);
+
+		if(!sees_lower)
+			return upper_ccw;
+		if(!sees_upper)
+			return lower_ccw;
+
+		/*
+		 * the seen edges go around the leftmost or the rightmost vertex
+		 */
+		if(upper_ccw.second == lower_ccw.first)
+			return std::make_pair(upper_ccw.first, lower_ccw.second);
+
+		return std::make_pair(lower_ccw.first, upper_ccw.second);
+	}
+
+private:
+	predicate_counter* m_site;
+
+	std::multiset<point_type, axis_comparator> m_points;
+	dynamic_hull_chain<T> m_upper;
+	dynamic_hull_chain<T> m_lower;
+
+	mutable polygon<T, 2> m_hull;
+	mutable bool m_changed = true;
+};
+
+typedef dynamic_hull<double>	dynamic_hull2d;
+typedef dynamic_hull<int>	dynamic_hull2i;
+
+}
@@ -0,0 +1,777 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/triangle-mesh.hpp>
+#include <gmt/algorithm/monotone-partition.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+namespace gmt {
+
+/**
+  * Triangulation of a simple polygon by ear clipping. The polygon is a
+  * ring of indices, doubly linked over the array of its vertices, and a
+  * queue holds the vertices that may be ears: only the neighbours of a
+  * clipped ear change, so only they are tested again. They go to the end
+  * of the queue, so every pass around the ring clips about every other
+  * vertex and the triangles stay small, instead of growing a fan.
+  *
+  * An ear is blocked only by a reflex vertex inside its triangle. The
+  * vertices are sorted once in z-order, and the test of an ear walks the
+  * z-order range of the box of its triangle from the place of the ear,
+  * jumping over the runs out of the box and testing the reflex vertices
+  * only. A clipped ear never makes a vertex reflex, so the vertices that
+  * become convex are only marked. A vertex that is not an ear waits in a
+  * list of the reflex vertex that blocked it, and goes back to the queue
+  * when that vertex becomes convex or is clipped.
+  *
+  * The orientations are decided by `robust_direction_in`, exactly. The
+  * buffers are kept from a polygon to the next one.
+  *
+  * The search alone is not bounded: the triangles of a polygon with many
+  * reflex vertices near its boundary, a noisy circle or a star, become
+  * long slivers whose boxes hold a share of the vertices that grows with
+  * `n`. So the work of the searches is counted, a place walked in the
+  * order or a test at a time, and past a budget of O(n lg n) the ring
+  * left, which is still simple, is triangulated by the
+  * `monotone_partitioner`: the whole takes O(n lg n) time.
+  */
+template<typename T>
+class ear_clipper {
+public:
+	typedef std::array<std::size_t, 3> triangle;
+
+	/**
+	  * @param work	the budget of the searches for the ears, per
+	  *		clipped vertex and per level of `lg n`, before the ring
+	  *		left is given to the `monotone_partitioner`
+	  */
+	explicit ear_clipper(std::size_t work = 2)
+	 : m_work_factor(work)
+	{
+	}
+
+	/**
+	  * triangulates the polygon of the `n` vertices from `points`, in
+	  * clockwise or counterclockwise order
+	  *
+	  * @param triangles	the triangles are appended to it, in
+	  *			counterclockwise order, as the positions of
+	  *			their vertices in `points`
+	  *
+	  * @return	the number of triangles appended, `n - 2` if no three
+	  *		consecutive vertices are collinear: collinear vertices
+	  *		are dropped from the ring, they lie on the side of a
+	  *		triangle
+	  */
+	std::size_t triangulate(
+		const point<T, 2>* points,
+		std::size_t n,
+		std::vector<triangle>& triangles)
+	{
+		const std::size_t first = triangles.size();
+
+		if(n < 3)
+			return 0;
+
+		m_points = points;
+		link(n);
+		drop_collinear(n);
+
+		if(m_alive >= 3){
+			build_order(n);
+			clip(triangles);
+		}
+
+		return triangles.size() - first;
+	}
+
+private:
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	const point<T, 2>* m_points = nullptr;
+	predicate_counter* m_site = GMT_PREDICATE_SITE("ear_clipper");
+
+	/*
+	 * the ring
+	 */
+	std::vector<std::size_t> m_prev;
+	std::vector<std::size_t> m_next;
+	std::vector<unsigned char> m_removed;
+	std::size_t m_alive = 0;
+	std::size_t m_head = 0;
+
+	/*
+	 * the vertices sorted by the z-order of their coordinates, which
+	 * are quantized to 16 bits in the box of the polygon, and the place
+	 * of each vertex in the order. The clipped vertices stay in the
+	 * order until they are more than the half of it.
+	 */
+	std::vector<unsigned char> m_reflex;
+	std::vector<std::uint32_t> m_keys;
+	std::vector<std::size_t> m_order;
+	std::vector<std::size_t> m_place;
+	std::vector<std::pair<std::uint32_t, std::size_t>> m_sorted;
+	std::vector<std::pair<std::uint32_t, std::size_t>> m_buffer;
+	std::size_t m_in_order = 0;
+	double m_min_x = 0.0, m_min_y = 0.0;
+	double m_scale_x = 0.0, m_scale_y = 0.0;
+
+	/*
+	 * the queue of the vertices to test, and the lists of the vertices
+	 * that wait for a reflex vertex
+	 */
+	struct queued {
+		std::size_t vertex;
+		std::size_t stamp;
+	};
+
+	std::vector<queued> m_queue;
+	std::size_t m_queue_head = 0;
+	std::vector<std::size_t> m_stamp;
+	std::vector<std::size_t> m_blocker;
+	std::vector<std::size_t> m_wait_head;
+	std::vector<std::size_t> m_wait_prev;
+	std::vector<std::size_t> m_wait_next;
+	std::vector<std::size_t> m_check;
+
+	/*
+	 * the work of the searches, and the ring left when it goes over
+	 * its budget with the vertex of each of its places
+	 */
+	std::size_t m_work_factor;
+	std::size_t m_work = 0;
+	monotone_partitioner<T> m_fallback;
+	polygon<T, 2> m_rest;
+	std::vector<std::size_t> m_rest_vertex;
+	std::vector<triangle> m_rest_triangles;
+
+	direction turn(std::size_t a, std::size_t b, std::size_t c) const
+	{
+		return robust_direction_in(m_points[a], m_points[b], m_points[c], m_site);
+	}
+
+	direction turn_at(std::size_t v) const
+	{
+		return turn(m_prev[v], v, m_next[v]);
+	}
+
+	/*
+	 * links the ring counterclockwise, the vertices are walked backwards
+	 * when the signed area is negative
+	 */
+	void link(std::size_t n)
+	{
+		double area = 0.0;
+		for(std::size_t i=0, j=n - 1; i<n; j = i++)
+			area += (double(m_points[j].x()) - double(m_points[i].x()))
+				*(double(m_points[j].y()) + double(m_points[i].y()));
+
+		m_prev.resize(n);
+		m_next.resize(n);
+		m_removed.assign(n, false);
+		m_alive = n;
+		m_head = 0;
+
+		for(std::size_t i=0; i<n; i++){
+			std::size_t before = (i == 0) ? n - 1 : i - 1;
+			std::size_t after = (i + 1 == n) ? 0 : i + 1;
+
+			if(area >= 0.0){
+				m_prev[i] = before;
+				m_next[i] = after;
+			}else{
+				m_prev[i] = after;
+				m_next[i] = before;
+			}
+		}
+	}
+
+	void unlink(std::size_t v)
+	{
+		if(m_head == v)
+			m_head = m_next[v];
+
+		m_next[m_prev[v]] = m_next[v];
+		m_prev[m_next[v]] = m_prev[v];
+		m_removed[v] = true;
+		m_alive--;
+	}
+
+	/*
+	 * drops the vertices that make no turn, and then their neighbours if
+	 * they make no turn anymore
+	 */
+	void drop_collinear(std::size_t n)
+	{
+		m_check.clear();
+
+		for(std::size_t i=0; i<n; i++){
+			m_check.push_back(i);
+
+			while(!m_check.empty() && m_alive >= 3){
+				std::size_t v = m_check.back();
+				m_check.pop_back();
+
+				if(m_removed[v] || turn_at(v) != ON)
+					continue;
+
+				m_check.push_back(m_prev[v]);
+				m_check.push_back(m_next[v]);
+				unlink(v);
+			}
+		}
+
+		m_check.clear();
+	}
+
+	/*
+	 * quantized coordinates, monotonic, so the points in a box are
+	 * between the quantized corners of the box
+	 */
+	std::uint32_t quantize_x(double x) const
+	{
+		return std::uint32_t(std::min(65535.0, std::max(0.0, (x - m_min_x)*m_scale_x)));
+	}
+
+	std::uint32_t quantize_y(double y) const
+	{
+		return std::uint32_t(std::min(65535.0, std::max(0.0, (y - m_min_y)*m_scale_y)));
+	}
+
+	/*
+	 * the bits of `x` in the even positions and the ones of `y` in the
+	 * odd positions
+	 */
+	static std::uint32_t interleave(std::uint32_t x, std::uint32_t y)
+	{
+		auto spread = [](std::uint32_t v){
+			v = (v | (v << 8)) & 0x00ff00ffu;
+			v = (v | (v << 4)) & 0x0f0f0f0fu;
+			v = (v | (v << 2)) & 0x33333333u;
+			v = (v | (v << 1)) & 0x55555555u;
+			return v;
+		};
+
+		return spread(x) | (spread(y) << 1);
+	}
+
+	/*
+	 * whether the z-order `key` is in the box of the corners `lo` and
+	 * `hi`, the coordinates are compared in their interleaved bits
+	 */
+	static bool in_box(std::uint32_t key, std::uint32_t lo, std::uint32_t hi)
+	{
+		constexpr std::uint32_t even = 0x55555555u;
+		constexpr std::uint32_t odd = 0xaaaaaaaau;
+
+		return (key & even) >= (lo & even) && (key & even) <= (hi & even)
+			&& (key & odd) >= (lo & odd) && (key & odd) <= (hi & odd);
+	}
+
+	/*
+	 * the least z-order greater than `key` in the box of the corners
+	 * `lo` and `hi`, for a `key` outside of the box, by Tropf and
+	 * Herzog's BIGMIN
+	 */
+	static std::uint32_t bigmin(std::uint32_t key, std::uint32_t lo, std::uint32_t hi)
+	{
+		std::uint32_t result = 0;
+
+		/*
+		 * the bits above the first one where the corners differ are the
+		 * same in the three keys
+		 */
+		int top = 31;
+		while(top > 0 && !(((lo ^ hi) >> top) & 1))
+			top--;
+
+		for(int bit=top; bit>=0; bit--){
+			const std::uint32_t mask = std::uint32_t(1) << bit;
+			const std::uint32_t lower = ((bit & 1) ? 0xaaaaaaaau : 0x55555555u) & (mask - 1);
+
+			const bool k = key & mask;
+			const bool l = lo & mask;
+			const bool h = hi & mask;
+
+			if(!k && !l && h){
+				result = (lo & ~(lower | mask)) | mask;
+				hi = (hi & ~mask) | lower;
+			}else if(!k && l && h){
+				return lo;
+			}else if(k && !l && !h){
+				return result;
+			}else if(k && !l && h){
+				lo = (lo & ~(lower | mask)) | mask;
+			}
+		}
+
+		return result;
+	}
+
+	std::uint32_t key_of(std::size_t v) const
+	{
+		return interleave(
+			quantize_x(double(m_points[v].x())),
+			quantize_y(double(m_points[v].y())));
+	}
+
+	/*
+	 * the vertices in z-order, and which of them are reflex
+	 */
+	void build_order(std::size_t n)
+	{
+		m_reflex.assign(n, false);
+
+		double max_x = 0.0, max_y = 0.0;
+		bool first = true;
+
+		for(std::size_t v=0; v<n; v++){
+			if(m_removed[v])
+				continue;
+
+			m_reflex[v] = turn_at(v) == RIGHT;
+
+			double x = double(m_points[v].x());
+			double y = double(m_points[v].y());
+
+			if(first){
+				m_min_x = max_x = x;
+				m_min_y = max_y = y;
+				first = false;
+			}else{
+				m_min_x = std::min(m_min_x, x);
+				m_min_y = std::min(m_min_y, y);
+				max_x = std::max(max_x, x);
+				max_y = std::max(max_y, y);
+			}
+		}
+
+		m_scale_x = (max_x > m_min_x) ? 65535.0/(max_x - m_min_x) : 0.0;
+		m_scale_y = (max_y > m_min_y) ? 65535.0/(max_y - m_min_y) : 0.0;
+
+		m_sorted.clear();
+		for(std::size_t v=0; v<n; v++)
+			if(!m_removed[v])
+				m_sorted.emplace_back(interleave(
+					quantize_x(double(m_points[v].x())),
+					quantize_y(double(m_points[v].y()))), v);
+
+		radix_sort();
+
+		m_keys.resize(m_sorted.size());
+		m_order.resize(m_sorted.size());
+		m_place.resize(n);
+
+		for(std::size_t i=0; i<m_sorted.size(); i++){
+			m_keys[i] = m_sorted[i].first;
+			m_order[i] = m_sorted[i].second;
+			m_place[m_order[i]] = i;
+		}
+
+		m_in_order = m_sorted.size();
+	}
+
+	/*
+	 * sorts `m_sorted` by the keys, a byte at a time from the lowest
+	 */
+	void radix_sort()
+	{
+		m_buffer.resize(m_sorted.size());
+
+		for(unsigned shift=0; shift<32; shift += 8){
+			std::size_t count[257] = {};
+
+			for(const auto& e : m_sorted)
+				count[((e.first >> shift) & 0xff) + 1]++;
+
+			for(std::size_t k=0; k<256; k++)
+				count[k + 1] += count[k];
+
+			for(const auto& e : m_sorted)
+				m_buffer[count[(e.first >> shift) & 0xff]++] = e;
+
+			m_sorted.swap(m_buffer);
+		}
+	}
+
+	/*
+	 * drops the clipped vertices from the order
+	 */
+	void compact_order()
+	{
+		std::size_t kept = 0;
+
+		for(std::size_t i=0; i<m_order.size(); i++){
+			std::size_t v = m_order[i];
+
+			if(!m_removed[v]){
+				m_order[kept] = v;
+				m_keys[kept] = m_keys[i];
+				m_place[v] = kept;
+				kept++;
+			}
+		}
+
+		m_order.resize(kept);
+		m_keys.resize(kept);
+	}
+
+	/*
+	 * the first place from `i` on whose key is not less than `key`, by
+	 * steps that double
+	 */
+	std::size_t gallop_up(std::size_t i, std::uint32_t key) const
+	{
+		const std::size_t m = m_keys.size();
+		std::size_t lo = i, hi = i, step = 1;
+
+		while(hi < m && m_keys[hi] < key){
+			lo = hi;
+			hi = std::min(m, hi + step);
+			step <<= 1;
+		}
+
+		return std::lower_bound(m_keys.begin() + lo, m_keys.begin() + hi, key) - m_keys.begin();
+	}
+
+	/*
+	 * the first place whose key is not less than `key`, searched from
+	 * the place `i`, whose key is not less than it, downwards
+	 */
+	std::size_t gallop_down(std::size_t i, std::uint32_t key) const
+	{
+		std::size_t lo = i, hi = i, step = 1;
+
+		while(lo > 0 && m_keys[lo - 1] >= key){
+			hi = lo - 1;
+			lo = (hi > step) ? hi - step : 0;
+			step <<= 1;
+		}
+
+		return std::lower_bound(m_keys.begin() + lo, m_keys.begin() + hi, key) - m_keys.begin();
+	}
+
+	/*
+	 * whether the reflex vertex `r` blocks the ear of `a`, `b` and `c`,
+	 * in their triangle or on its sides
+	 */
+	bool blocks(std::size_t r, std::size_t a, std::size_t b, std::size_t c) const
+	{
+		if(r == a || r == b || r == c)
+			return false;
+
+		return turn(a, b, r) != RIGHT
+			&& turn(b, c, r) != RIGHT
+			&& turn(c, a, r) != RIGHT;
+	}
+
+	/*
+	 * the reflex vertex that blocks the ear of `b`, or `npos` if it is
+	 * an ear. The last blocker of `b` is tried first.
+	 */
+	std::size_t blocker_of(std::size_t b)
+	{
+		m_work++;
+
+		const std::size_t a = m_prev[b];
+		const std::size_t c = m_next[b];
+
+		std::size_t last = m_blocker[b];
+		if(last != npos && m_reflex[last] && blocks(last, a, b, c))
+			return last;
+
+		const point<T, 2>& pa = m_points[a];
+		const point<T, 2>& pb = m_points[b];
+		const point<T, 2>& pc = m_points[c];
+
+		const double x0 = double(std::min({ pa.x(), pb.x(), pc.x() }));
+		const double y0 = double(std::min({ pa.y(), pb.y(), pc.y() }));
+		const double x1 = double(std::max({ pa.x(), pb.x(), pc.x() }));
+		const double y1 = double(std::max({ pa.y(), pb.y(), pc.y() }));
+
+		const std::uint32_t lo = interleave(quantize_x(x0), quantize_y(y0));
+		const std::uint32_t hi = interleave(quantize_x(x1), quantize_y(y1));
+
+		/*
+		 * the keys between the corners are walked from the first one,
+		 * found from the place of `b`, which is in the box, and the runs
+		 * out of the box are jumped over
+		 */
+		const std::size_t m = m_keys.size();
+
+		std::size_t misses = 0;
+
+		for(std::size_t i = gallop_down(m_place[b], lo); i < m && m_keys[i] <= hi;){
+			m_work++;
+
+			if(!in_box(m_keys[i], lo, hi)){
+				if(++misses < 4)
+					i++;
+				else
+					i = gallop_up(i + 1, bigmin(m_keys[i], lo, hi));
+				continue;
+			}
+
+			misses = 0;
+
+			std::size_t r = m_order[i++];
+
+			if(!m_reflex[r])
+				continue;
+
+			double x = double(m_points[r].x());
+			double y = double(m_points[r].y());
+
+			if(x < x0 || x > x1 || y < y0 || y > y1)
+				continue;
+
+			if(blocks(r, a, b, c))
+				return r;
+		}
+
+		return npos;
+	}
+
+	/*
+	 * queues `v` at the end, its earlier places in the queue are stale
+	 */
+	void push(std::size_t v)
+	{
+		m_queue.push_back(queued{ v, ++m_stamp[v] });
+	}
+
+	void stop_waiting(std::size_t v)
+	{
+		std::size_t r = m_blocker[v];
+		if(r == npos)
+			return;
+
+		if(m_wait_prev[v] != npos)
+			m_wait_next[m_wait_prev[v]] = m_wait_next[v];
+		else
+			m_wait_head[r] = m_wait_next[v];
+
+		if(m_wait_next[v] != npos)
+			m_wait_prev[m_wait_next[v]] = m_wait_prev[v];
+
+		m_blocker[v] = npos;
+	}
+
+	void wait_for(std::size_t v, std::size_t r)
+	{
+		if(m_blocker[v] == r)
+			return;
+
+		stop_waiting(v);
+
+		m_blocker[v] = r;
+		m_wait_prev[v] = npos;
+		m_wait_next[v] = m_wait_head[r];
+
+		if(m_wait_head[r] != npos)
+			m_wait_prev[m_wait_head[r]] = v;
+		m_wait_head[r] = v;
+	}
+
+	/*
+	 * the reflex vertex `r` became convex or was clipped, the vertices
+	 * it blocked are tested again
+	 */
+	void release(std::size_t r)
+	{
+		m_reflex[r] = false;
+
+		for(std::size_t v = m_wait_head[r]; v != npos;){
+			std::size_t next = m_wait_next[v];
+
+			m_blocker[v] = npos;
+			push(v);
+
+			v = next;
+		}
+
+		m_wait_head[r] = npos;
+	}
+
+	/*
+	 * removes `v` from the ring, every vertex waiting for it is released
+	 */
+	void remove(std::size_t v)
+	{
+		stop_waiting(v);
+
+		if(m_reflex[v])
+			release(v);
+
+		unlink(v);
+
+		if(--m_in_order < m_order.size()/2)
+			compact_order();
+	}
+
+	/*
+	 * the vertices of `m_check` lost a neighbour: a vertex is dropped if
+	 * it makes no turn, and its neighbours are checked, it is released if
+	 * it is not reflex anymore and queued if it is convex
+	 */
+	void update()
+	{
+		while(!m_check.empty()){
+			std::size_t v = m_check.back();
+			m_check.pop_back();
+
+			if(m_removed[v] || m_alive <= 3)
+				continue;
+
+			direction d = turn_at(v);
+
+			if(d == ON){
+				m_check.push_back(m_prev[v]);
+				m_check.push_back(m_next[v]);
+				remove(v);
+			}else if(d == LEFT){
+				if(m_reflex[v])
+					release(v);
+				push(v);
+			}
+		}
+	}
+
+	void clip_ear(std::size_t v, std::vector<triangle>& triangles)
+	{
+		triangles.push_back(triangle{ m_prev[v], v, m_next[v] });
+
+		m_check.push_back(m_prev[v]);
+		m_check.push_back(m_next[v]);
+		remove(v);
+		update();
+	}
+
+	void clip(std::vector<triangle>& triangles)
+	{
+		const std::size_t n = m_prev.size();
+
+		m_queue.clear();
+		m_queue_head = 0;
+		m_stamp.assign(n, 0);
+		m_blocker.assign(n, npos);
+		m_wait_head.assign(n, npos);
+		m_wait_prev.resize(n);
+		m_wait_next.resize(n);
+
+		triangles.reserve(triangles.size() + m_alive - 2);
+
+		for(std::size_t v=0; v<n; v++)
+			if(!m_removed[v] && !m_reflex[v])
+				push(v);
+
+		std::size_t lg = 1;
+		for(std::size_t k=m_alive; k>1; k >>= 1)
+			lg++;
+
+		/*
+		 * the budget grows with the clipped vertices, from an eighth of
+		 * the ring, so the rings whose ears cost too much leave early
+		 */
+		const std::size_t start = m_alive;
+		m_work = 0;
+
+		while(m_alive > 3){
+			if(m_work > m_work_factor*lg*(start - m_alive + start/8)){
+				clip_rest(triangles);
+				return;
+			}
+
+			if(m_queue_head == m_queue.size()){
+				/*
+				 * a simple polygon always has an ear, with no queued
+				 * vertex the polygon is not simple and the first
+				 * convex vertex is clipped anyway
+				 */
+				std::size_t v = m_head;
+				while(turn_at(v) != LEFT && m_next[v] != m_head)
+					v = m_next[v];
+
+				clip_ear(v, triangles);
+				continue;
+			}
+
+			queued e = m_queue[m_queue_head++];
+			std::size_t v = e.vertex;
+
+			if(m_queue_head == m_queue.size()){
+				m_queue.clear();
+				m_queue_head = 0;
+			}
+
+			if(e.stamp != m_stamp[v] || m_removed[v] || m_reflex[v])
+				continue;
+
+			std::size_t r = blocker_of(v);
+			if(r != npos)
+				wait_for(v, r);
+			else
+				clip_ear(v, triangles);
+		}
+
+		if(turn_at(m_head) != ON)
+			triangles.push_back(triangle{ m_prev[m_head], m_head, m_next[m_head] });
+	}
+
+	/*
+	 * triangulates the ring left, counterclockwise and with no vertex
+	 * that makes no turn, by the monotone partition
+	 */
+	void clip_rest(std::vector<triangle>& triangles)
+	{
+		m_rest.clear();
+		m_rest_vertex.clear();
+
+		std::size_t v = m_head;
+		do{
+			m_rest.push_back(m_points[v]);
+			m_rest_vertex.push_back(v);
+			v = m_next[v];
+		}while(v != m_head);
+
+		m_rest_triangles.clear();
+		m_fallback.partition(m_rest);
+		m_fallback.triangulate(m_rest_triangles);
+
+		for(const auto& t : m_rest_triangles)
+			triangles.push_back(triangle{ m_rest_vertex[t[0]], m_rest_vertex[t[1]], m_rest_vertex[t[2]] });
+	}
+};
+
+/**
+  * Triangulation of the simple polygon `poly` by ear clipping, in
+  * O(n lg n) time. It is fast when few reflex vertices fall in the boxes
+  * of the ears; the polygons with many reflex vertices along their
+  * boundary go over the budget of the search, and the rest of them is
+  * triangulated as by `monotone_triangulation`.
+  *
+  * @return	the triangles in counterclockwise order, whose vertices are
+  *		the vertices of the polygon in its order
+  *
+  * @see ear_clipper
+  */
+template<typename T>
+triangle_mesh<T, 2> ear_clipping_triangulation(const polygon<T, 2>& poly)
+{
+	triangle_mesh<T, 2> mesh;
+	mesh.vertices.assign(poly.begin(), poly.end());
+
+	ear_clipper<T>().triangulate(poly.data(), poly.size(), mesh.triangles);
+
+	return mesh;
+}
+
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cmath>
+#include <optional>
+#include <type_traits>
+
 #include <gmt/polygon.hpp>
 #include <gmt/algorithm/direction.hpp>
 #include <gmt/line.hpp>
@@ -13,6 +17,168 @@ typedef enum type {
 	PROPER,
 	IMPROPER
 } type;
+
+/*
+ * relative position of two lines
+ */
+typedef enum relation {
+	CROSSING,
+	PARALLEL,
+	COLLINEAR,
+	SKEW
+} relation;
+}
+
+/**
+  * Result of the intersection of the lines `l0 = shift0 + s*sense0` and
+  * `l1 = shift1 + t*sense1`. The scalars are only meaningful when the
+  * relation is `intersection::CROSSING`, or `intersection::SKEW` in 3D,
+  * where they locate the closest points of the two lines.
+  *
+  * The scalars of integer lines are `double`.
+  */
+template<typename T>
+struct line_scalars {
+	typedef typename std::conditional<
+		std::is_floating_point<T>::value,
+		T,
+		double
+	>::type scalar_type;
+
+	intersection::relation relation;
+	scalar_type s;
+	scalar_type t;
+};
+
+/**
+  * Resolves the scalars `s` and `t` where the 2D lines `l0` and `l1`
+  * intersect with Cramer's rule. It does not allocate nor throw, parallel
+  * and collinear lines are reported in the relation.
+  */
+template<typename T>
+line_scalars<T> intersect_scalars(
+	const line<T, 2>& l0,
+	const line<T, 2>& l1) noexcept
+{
+	typedef typename line_scalars<T>::scalar_type S;
+
+	S v0x = l0.sense.x(), v0y = l0.sense.y();
+	S v1x = l1.sense.x(), v1y = l1.sense.y();
+	S dx = S(l1.shift.x()) - S(l0.shift.x());
+	S dy = S(l1.shift.y()) - S(l0.shift.y());
+
+	/*
+	 * s*v0 - t*v1 = d
+	 */
+	S det = v0x*v1y - v0y*v1x;
+	S ds = dx*v1y - dy*v1x;
+	S dt = dx*v0y - dy*v0x;
+
+	if(det == 0){
+		if(ds == 0 && dt == 0)
+			return { intersection::COLLINEAR, 0, 0 };
+		return { intersection::PARALLEL, 0, 0 };
+	}
+
+	return { intersection::CROSSING, ds/det, dt/det };
+}
+
+/**
+  * Resolves the scalars `s` and `t` of the closest points of the 3D lines
+  * `l0` and `l1`. The lines are `intersection::CROSSING` when their
+  * distance is not greater than `e` plus `relative` times the distance
+  * of their shifts, otherwise they are `intersection::SKEW`.
+  *
+  * Two floating-point lines through a common point are rarely crossing
+  * in exact arithmetic, so the default `relative` tolerance absorbs the
+  * rounding of their coordinates; a `relative` of zero tests exactly.
+  */
+template<typename T>
+line_scalars<T> intersect_scalars(
+	const line<T, 3>& l0,
+	const line<T, 3>& l1,
+	double e = 0.0,
+	double relative = 1e-9) noexcept
+{
+	typedef typename line_scalars<T>::scalar_type S;
+
+	S v0[3], v1[3], d[3];
+	for(std::size_t i=0; i<3; i++){
+		v0[i] = l0.sense[i];
+		v1[i] = l1.sense[i];
+		d[i] = S(l1.shift[i]) - S(l0.shift[i]);
+	}
+
+	auto cross = [](const S* a, const S* b, S* c){
+		c[0] = a[1]*b[2] - a[2]*b[1];
+		c[1] = a[2]*b[0] - a[0]*b[2];
+		c[2] = a[0]*b[1] - a[1]*b[0];
+	};
+
+	auto dot = [](const S* a, const S* b){
+		return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+	};
+
+	S n[3], dv0[3], dv1[3];
+	cross(v0, v1, n);
+	cross(d, v0, dv0);
+	cross(d, v1, dv1);
+
+	S nn = dot(n, n);
+
+	if(nn == 0){
+		if(dot(dv0, dv0) == 0)
+			return { intersection::COLLINEAR, 0, 0 };
+		return { intersection::PARALLEL, 0, 0 };
+	}
+
+	S s = dot(dv1, n)/nn;
+	S t = dot(dv0, n)/nn;
+
+	/*
+	 * the distance of the lines is |d.n|/|n|
+	 */
+	S dn = std::abs(dot(d, n));
+	S tolerance = S(e) + S(relative)*std::sqrt(dot(d, d));
+	if(dn > tolerance*std::sqrt(nn))
+		return { intersection::SKEW, s, t };
+
+	return { intersection::CROSSING, s, t };
+}
+
+/**
+  * Point where the lines `l0` and `l1` cross, or nothing if they are
+  * parallel, collinear or skew.
+  */
+template<typename T, std::size_t n_dimension>
+std::optional<point<T, n_dimension>> intersect_lines(
+	const line<T, n_dimension>& l0,
+	const line<T, n_dimension>& l1) noexcept
+{
+	line_scalars<T> x = intersect_scalars(l0, l1);
+
+	if(x.relation != intersection::CROSSING)
+		return std::nullopt;
+
+	return l0.point_on_line_at(x.s);
+}
+
+/**
+  * Point where the line `l` crosses the segment `seg`, or nothing if they
+  * do not cross. A segment collinear to the line has no single point of
+  * intersection, so nothing is returned.
+  */
+template<typename T, std::size_t n_dimension>
+std::optional<point<T, n_dimension>> intersect_line_segment(
+	const line<T, n_dimension>& l,
+	const segment<T, n_dimension>& seg) noexcept
+{
+	line_scalars<T> x = intersect_scalars(l, line<T, n_dimension>(seg));
+
+	if(x.relation != intersection::CROSSING || x.t < 0 || x.t > 1)
+		return std::nullopt;
+
+	return l.point_on_line_at(x.s);
 }
 
 /**
@@ -110,31 +276,71 @@ intersection::type intersect(
 	return intersection::NONE;
 }
 
+/*
+ * coefficient matrix and independent terms of the system of the lines
+ * l0 = v0 + s*v1 and l1 = v2 + t*v3
+ */
+template<typename T, std::size_t n_dimension>
+void line_system(
+	const line<T, n_dimension>& l0,
+	const line<T, n_dimension>& l1,
+	mat<T, n_dimension, 2>& m,
+	mat<T, n_dimension, 1>& b)
+{
+	for(size_t i=0; i<m.rows(); i++){
+		m[i][0] = l0.sense[i];
+		m[i][1] = -(l1.sense[i]);
+		b[i][0] = l1.shift[i] - l0.shift[i];
+	}
+}
+
 template<typename T, std::size_t n_dimension>
 intersection::type intersect(
 	const line<T, n_dimension>& l,
 	const segment<T, n_dimension>& seg)
-try{
-	line<T, n_dimension> line_segment(seg);
-	mat<T, n_dimension, 1> x = resolve_scalars(l, line_segment);
+{
+	if constexpr(n_dimension == 2 || n_dimension == 3){
+		line_scalars<T> x = intersect_scalars(
+			l,
+			line<T, n_dimension>(seg));
 
-	T s = x[1][0];
+		if(x.relation != intersection::CROSSING)
+			return intersection::NONE;
 
-	if(s < 0.0 || s > 1.0)
-		return intersection::NONE;
+		if(x.t < 0.0 || x.t > 1.0)
+			return intersection::NONE;
 
-	if(s == 0.0 || s == 1.0)
-		return intersection::IMPROPER;
+		if(x.t == 0.0 || x.t == 1.0)
+			return intersection::IMPROPER;
 
-	return intersection::PROPER;
-}catch(system_has_no_solution<T, n_dimension, 2>& e){
-	return intersection::NONE;
-}
+		return intersection::PROPER;
+	}else{
+		mat<T, n_dimension, 2> m;
+		mat<T, n_dimension, 1> b;
+		line_system(l, line<T, n_dimension>(seg), m, b);
+
+		std::optional<mat<T, n_dimension, 1>> x = try_resolve(m, b);
+		if(!x)
+			return intersection::NONE;
+
+		T s = (*x)[1][0];
 
+		if(s < 0.0 || s > 1.0)
+			return intersection::NONE;
+
+		if(s == 0.0 || s == 1.0)
+			return intersection::IMPROPER;
+
+		return intersection::PROPER;
+	}
+}
 
 /*
  * resolve the scalars s and t where the lines l0 and l1
  * intersects where l0 = v0 + s*v1 and l1 = v2 + t*v3
+ *
+ * 2D lines are resolved by `intersect_scalars`, the others by gaussian
+ * elimination
  */
 template<typename T, std::size_t n_dimension>
 mat<T, n_dimension, 1> resolve_scalars(
@@ -144,16 +350,25 @@ mat<T, n_dimension, 1> resolve_scalars(
 	mat<T, n_dimension, 2> m;
 	mat<T, n_dimension, 1> b;
 
-	/*
-	 * builds the coefficient matrix
-	 */
-	for(size_t i=0; i<m.rows(); i++){
-		m[i][0] = l0.sense[i];
-		m[i][1] = -(l1.sense[i]);
-		b[i][0] = l1.shift[i] - l0.shift[i];
-	}
+	if constexpr(n_dimension == 2){
+		line_scalars<T> x = intersect_scalars(l0, l1);
+
+		if(x.relation == intersection::CROSSING){
+			b[0][0] = x.s;
+			b[1][0] = x.t;
+			return b;
+		}
+
+		line_system(l0, l1, m, b);
+		GMT_THROW((system_has_no_solution<T, n_dimension, 2>(m, b)));
+	}else{
+		/*
+		 * builds the coefficient matrix
+		 */
+		line_system(l0, l1, m, b);
 
-	return resolve(m, b);
+		return resolve(m, b);
+	}
 }
 
 /*
@@ -164,18 +379,13 @@ template<typename T, std::size_t n_dimension>
 point<T, n_dimension> point_of_intersection(
 	const line<T, n_dimension>& l,
 	const segment<T, n_dimension>& seg)
-try{
-	line<T, n_dimension> line_segment(seg);
-	mat<T, n_dimension, 1> x = resolve_scalars(l, line_segment);
-
-	T s = x[1][0];
+{
+	std::optional<point<T, n_dimension>> p = intersect_line_segment(l, seg);
 
-	if(s < 0.0 || s > 1.0)
-		throw line_does_not_intersect_segment();
+	if(!p)
+		GMT_THROW(line_does_not_intersect_segment());
 
-	return l.point_on_line_at(x[0][0]);
-}catch(system_has_no_solution<T, n_dimension, 2>& e){
-	throw line_does_not_intersect_segment();
+	return *p;
 }
 
 /*
@@ -186,9 +396,22 @@ point<T, n_dimension> point_of_intersection(
 	const line<T, n_dimension>& l0,
 	const line<T, n_dimension>& l1)
 {
-	mat<T, n_dimension, 1> x = resolve_scalars(l0, l1);
+	if constexpr(n_dimension == 2){
+		std::optional<point<T, n_dimension>> p = intersect_lines(l0, l1);
+
+		if(!p){
+			mat<T, n_dimension, 2> m;
+			mat<T, n_dimension, 1> b;
+			line_system(l0, l1, m, b);
+			GMT_THROW((system_has_no_solution<T, n_dimension, 2>(m, b)));
+		}
+
+		return *p;
+	}else{
+		mat<T, n_dimension, 1> x = resolve_scalars(l0, l1);
 
-	return l0.point_on_line_at(x[0][0]);
+		return l0.point_on_line_at(x[0][0]);
+	}
 }
 
 /**
@@ -3,15 +3,23 @@
 #include <cmath>
 #include <assert.h>
 
-#include <list>
+#include <optional>
 
 #include <gmt/mat.hpp>
 #include <gmt/exception.hpp>
 
 namespace gmt {
 
+/**
+  * resolves the system `a*x = b` by gaussian elimination with partial
+  * pivoting
+  *
+  * @return x, or nothing if the system has no solution
+  */
 template<typename T, std::size_t l, std::size_t c>
-mat<T, l, 1> gaussian_elimination(const mat<T, l, c>& a, const mat<T, l, 1>& b)
+std::optional<mat<T, l, 1>> try_gaussian_elimination(
+	const mat<T, l, c>& a,
+	const mat<T, l, 1>& b) noexcept
 {
 	assert(a.rows() > 1 && a.columns() > 1);
 	assert(b.rows() == a.rows() && b.columns() == 1);
@@ -19,7 +27,6 @@ mat<T, l, 1> gaussian_elimination(const mat<T, l, c>& a, const mat<T, l, 1>& b)
 	mat<T, l, c> A = a.copy();
 	mat<T, l, 1> B = b.copy();
 	mat<T, l, 1> x;
-	std::list<std::pair<int, int>> swaped_row;
 
 	for(std::size_t i=0; i<A.rows(); i++){
 
@@ -43,7 +50,7 @@ mat<T, l, 1> gaussian_elimination(const mat<T, l, c>& a, const mat<T, l, 1>& b)
 		 */
 		if(A[max_row][i] == 0){
 			if(max_row <= (A.columns()-1))
-				throw system_has_no_solution<T, l, c>(a, b);
+				return std::nullopt;
 			else
 				break; // overdetermined
 		}
@@ -54,7 +61,6 @@ mat<T, l, 1> gaussian_elimination(const mat<T, l, c>& a, const mat<T, l, 1>& b)
 		if(i != max_row){
 			A.swap_rows(i, max_row);
 			B.swap_rows(i, max_row);
-			swaped_row.push_front(std::pair<int, int>(i, max_row));
 		}
 
 		/*
@@ -95,6 +101,17 @@ mat<T, l, 1> gaussian_elimination(const mat<T, l, c>& a, const mat<T, l, 1>& b)
 	return x;
 }
 
+template<typename T, std::size_t l, std::size_t c>
+mat<T, l, 1> gaussian_elimination(const mat<T, l, c>& a, const mat<T, l, 1>& b)
+{
+	std::optional<mat<T, l, 1>> x = try_gaussian_elimination(a, b);
+
+	if(!x)
+		GMT_THROW((system_has_no_solution<T, l, c>(a, b)));
+
+	return *x;
+}
+
 /**
  * resolves the system `a`, no format A*x = b
  */
@@ -104,4 +121,17 @@ mat<T, l, 1> resolve(const mat<T, l, c>& a, const mat<T, l, 1>& b)
 	return gaussian_elimination(a, b);
 }
 
+/**
+ * resolves the system `a`, no format A*x = b, without throwing
+ *
+ * @return x, or nothing if the system has no solution
+ */
+template<typename T, std::size_t l, std::size_t c>
+std::optional<mat<T, l, 1>> try_resolve(
+	const mat<T, l, c>& a,
+	const mat<T, l, 1>& b) noexcept
+{
+	return try_gaussian_elimination(a, b);
+}
+
 };
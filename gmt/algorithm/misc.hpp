@@ -1,14 +1,33 @@
 #pragma once
 
+#include <type_traits>
+
 #include <gmt/point.hpp>
 #include <gmt/vec.hpp>
 
 namespace gmt {
 
+/**
+  * integer type of the intermediate values of the integer kernel. With
+  * `__int128` the cross products of coordinates of up to 62 bits are
+  * exact, otherwise the coordinates must fit in 30 bits.
+  */
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 wide_int;
+#else
+typedef long long wide_int;
+#endif
+
 template<typename T>
 bool is_equal(const T& a, const T& b, const T& e)
 {
-	return (e == 0.0 && a == b) || fabs(a - b) <= e;
+	/*
+	 * integers are compared without leaving the integers
+	 */
+	if constexpr(std::is_integral<T>::value)
+		return a == b || (a > b ? wide_int(a) - b : wide_int(b) - a) <= e;
+	else
+		return (e == 0.0 && a == b) || fabs(a - b) <= e;
 }
 
 /** calculates whether the point c is between
@@ -54,6 +73,30 @@ double signed_parallelogram_area(const vec<T, 2>& a, const vec<T, 2>& b)
 	return a.x()*b.y() - a.y()*b.x();
 }
 
+/**
+  * calculates exactly the signed area of the parallelogram of `p1 - p0`
+  * and `p2 - p0` for integer coordinates. The differences and the
+  * products are computed in `wide_int`, so they never overflow or round.
+  *
+  * @see signed_parallelogram_area
+  */
+template<typename T>
+wide_int exact_signed_parallelogram_area(
+	const point<T, 2>& p0,
+	const point<T, 2>& p1,
+	const point<T, 2>& p2)
+{
+	static_assert(std::is_integral<T>::value,
+		"the exact area is only defined for integer coordinates");
+
+	wide_int v0x = wide_int(p1.x()) - p0.x();
+	wide_int v0y = wide_int(p1.y()) - p0.y();
+	wide_int v1x = wide_int(p2.x()) - p0.x();
+	wide_int v1y = wide_int(p2.y()) - p0.y();
+
+	return v0x*v1y - v0y*v1x;
+}
+
 /**
   * calculates the area of the parallelogram.
   *
@@ -0,0 +1,687 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-with-holes.hpp>
+#include <gmt/sweep-tree.hpp>
+#include <gmt/triangle-mesh.hpp>
+#include <gmt/dcel/dcelp.hpp>
+#include <gmt/algorithm/direction.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+namespace gmt {
+
+/**
+  * Partition of a polygon with holes in y-monotone pieces by the sweep
+  * of de Berg et al., driven by the types of the vertices given by
+  * `classify`, and triangulation of the pieces in linear time. Both take
+  * O(n lg n) time for any simple input, with no adversarial cases.
+  *
+  * The vertices are numbered as they are given: the ones of the
+  * boundary, and then the ones of each hole in order. The boundary is
+  * walked counterclockwise and the holes clockwise, so the polygon is to
+  * the left of every edge, whatever the order of the input.
+  *
+  * The status of the sweep holds the edges that have the polygon to
+  * their right in a `sweep_tree`, whose nodes are pooled. All the
+  * buffers are kept from a polygon to the next one.
+  */
+template<typename T>
+class monotone_partitioner {
+public:
+	typedef std::array<std::size_t, 3> triangle;
+	typedef std::pair<std::size_t, std::size_t> diagonal;
+
+	/**
+	  * computes the diagonals that split the polygon in monotone pieces
+	  */
+	void partition(const polygon_with_holes<T, 2>& poly)
+	{
+		m_points.clear();
+		m_next.clear();
+		m_prev.clear();
+		m_type.clear();
+		m_diagonals.clear();
+
+		add_ring(poly.boundary(), true);
+		for(const auto& hole : poly.holes())
+			add_ring(hole, false);
+
+		sweep();
+		link_pieces();
+	}
+
+	void partition(const polygon<T, 2>& poly)
+	{
+		m_points.clear();
+		m_next.clear();
+		m_prev.clear();
+		m_type.clear();
+		m_diagonals.clear();
+
+		add_ring(poly, true);
+
+		sweep();
+		link_pieces();
+	}
+
+	/** @brief the vertices of the last polygon, in their numbering
+	  */
+	const std::vector<point<T, 2>>& vertices() const noexcept
+	{
+		return m_points;
+	}
+
+	/** @brief the diagonals of the last partition
+	  */
+	const std::vector<diagonal>& diagonals() const noexcept
+	{
+		return m_diagonals;
+	}
+
+	/**
+	  * calls `f(first, last)` for each monotone piece of the last
+	  * partition, with the range of the numbers of its vertices in
+	  * counterclockwise order
+	  */
+	template<typename visitor>
+	void pieces(const visitor& f)
+	{
+		for(std::size_t k=0; k + 1<m_piece_start.size(); k++)
+			f(	m_piece_vertex.data() + m_piece_start[k],
+				m_piece_vertex.data() + m_piece_start[k + 1]);
+	}
+
+	/**
+	  * triangulates every monotone piece of the last partition
+	  *
+	  * @param triangles	the triangles are appended to it, in
+	  *			counterclockwise order
+	  */
+	void triangulate(std::vector<triangle>& triangles)
+	{
+		pieces([&](const std::size_t* first, const std::size_t* last){
+			triangulate_piece(first, std::size_t(last - first), triangles);
+		});
+	}
+
+	/**
+	  * the last partition in a dcel: the pieces are its faces, and the
+	  * vertices and the half-edges follow the numbering of the vertices
+	  */
+	std::unique_ptr<dcel2d> to_dcel() const
+	{
+		std::unique_ptr<dcel2d> d(new dcel2d);
+
+		const std::size_t n = m_points.size();
+		const std::size_t n_pieces = m_piece_start.empty() ? 0 : m_piece_start.size() - 1;
+
+		d->reset(n, 2*n + 2*m_diagonals.size(), n_pieces);
+
+		/*
+		 * the half-edge `2*v` goes from `v` to the next vertex of its
+		 * ring, inside the polygon, and `2*v + 1` is its twin; the
+		 * diagonal `k` is `2*n + 2*k` and `2*n + 2*k + 1`
+		 */
+		auto half_edge = [&](std::size_t h){
+			return d->edge_at((h < n) ? 2*h : h + n);
+		};
+
+		for(std::size_t v=0; v<n; v++){
+			auto* vertex = d->vertex_at(v);
+			vertex->data.p = point2d{ double(m_points[v].x()), double(m_points[v].y()) };
+			vertex->incident_edge = m_next[v] == npos ? nullptr : d->edge_at(2*m_prev[v]);
+		}
+
+		for(std::size_t v=0; v<n; v++){
+			if(m_next[v] == npos)
+				continue;
+
+			auto* inner = d->edge_at(2*v);
+			auto* outer = d->edge_at(2*v + 1);
+
+			inner->twin = outer;
+			outer->twin = inner;
+			inner->origin = outer->destination = d->vertex_at(v);
+			inner->destination = outer->origin = d->vertex_at(m_next[v]);
+
+			outer->next = d->edge_at(2*m_prev[v] + 1);
+			outer->prev = d->edge_at(2*m_next[v] + 1);
+			outer->incident_face = d->external_face();
+		}
+
+		for(std::size_t k=0; k<m_diagonals.size(); k++){
+			auto* ab = d->edge_at(2*n + 2*k);
+			auto* ba = d->edge_at(2*n + 2*k + 1);
+
+			ab->twin = ba;
+			ba->twin = ab;
+			ab->origin = ba->destination = d->vertex_at(m_diagonals[k].first);
+			ab->destination = ba->origin = d->vertex_at(m_diagonals[k].second);
+		}
+
+		for(std::size_t k=0; k<n_pieces; k++){
+			auto* face = d->face_at(k);
+
+			for(std::size_t i=m_piece_start[k]; i<m_piece_start[k + 1]; i++){
+				std::size_t h = m_piece_edge[i];
+				auto* e = half_edge(h);
+
+				e->next = half_edge(m_edge_next[h]);
+				e->next->prev = e;
+				e->incident_face = face;
+			}
+
+			face->incident_edge = half_edge(m_piece_edge[m_piece_start[k]]);
+		}
+
+		if(!m_points.empty() && m_next[0] != npos)
+			d->external_face()->incident_edge = d->edge_at(1);
+
+		return d;
+	}
+
+private:
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	predicate_counter* m_site = GMT_PREDICATE_SITE("monotone_partition");
+
+	/*
+	 * the rings, linked with the polygon to the left, a vertex of a
+	 * degenerate ring has no links
+	 */
+	std::vector<point<T, 2>> m_points;
+	std::vector<std::size_t> m_next;
+	std::vector<std::size_t> m_prev;
+	std::vector<vertex_type> m_type;
+	polygon<T, 2> m_reversed;
+
+	/*
+	 * the sweep: the edges of the status are named by their first
+	 * vertex, each one with its helper and its node
+	 */
+	std::vector<std::size_t> m_order;
+	sweep_tree<std::size_t> m_status;
+	std::vector<std::size_t> m_helper;
+	std::vector<typename sweep_tree<std::size_t>::handle> m_node;
+	std::vector<diagonal> m_diagonals;
+
+	/*
+	 * the half-edges inside the polygon: `v` goes from the vertex `v` to
+	 * the next one of its ring, `n + 2*k` and `n + 2*k + 1` are the
+	 * diagonal `k` in both directions. The half-edges that leave a
+	 * vertex are in counterclockwise order from the one of its ring.
+	 */
+	std::vector<std::size_t> m_out_start;
+	std::vector<std::size_t> m_out;
+	std::vector<std::size_t> m_out_place;
+	std::vector<std::size_t> m_edge_next;
+	std::vector<std::size_t> m_piece_start;
+	std::vector<std::size_t> m_piece_vertex;
+	std::vector<std::size_t> m_piece_edge;
+
+	/*
+	 * buffers of the triangulation of a piece
+	 */
+	std::vector<std::size_t> m_chain_order;
+	std::vector<unsigned char> m_on_left;
+	std::vector<std::size_t> m_stack;
+
+	direction turn(std::size_t a, std::size_t b, std::size_t c) const
+	{
+		return robust_direction_in(m_points[a], m_points[b], m_points[c], m_site);
+	}
+
+	/*
+	 * whether the vertex `a` comes before `b` in the sweep, from the top
+	 */
+	bool above(std::size_t a, std::size_t b) const
+	{
+		return is_below(m_points[b], m_points[a]);
+	}
+
+	std::size_t origin(std::size_t h) const
+	{
+		const std::size_t n = m_points.size();
+
+		if(h < n)
+			return h;
+
+		const diagonal& d = m_diagonals[(h - n)/2];
+		return ((h - n)%2) ? d.second : d.first;
+	}
+
+	std::size_t destination(std::size_t h) const
+	{
+		const std::size_t n = m_points.size();
+
+		if(h < n)
+			return m_next[h];
+
+		const diagonal& d = m_diagonals[(h - n)/2];
+		return ((h - n)%2) ? d.first : d.second;
+	}
+
+	/*
+	 * appends the ring, the boundary counterclockwise and a hole
+	 * clockwise; the types of its vertices are classified in that order
+	 */
+	void add_ring(const polygon<T, 2>& ring, bool boundary)
+	{
+		const std::size_t n = ring.size();
+		const std::size_t offset = m_points.size();
+
+		m_points.insert(m_points.end(), ring.begin(), ring.end());
+		m_next.resize(offset + n, npos);
+		m_prev.resize(offset + n, npos);
+		m_type.resize(offset + n, REGULAR);
+
+		if(n < 3)
+			return;
+
+		double area = 0.0;
+		for(std::size_t i=0, j=n - 1; i<n; j = i++)
+			area += (double(ring[j].x()) - double(ring[i].x()))
+				*(double(ring[j].y()) + double(ring[i].y()));
+
+		if(area == 0.0)
+			return;
+
+		const bool reverse = (area > 0.0) != boundary;
+
+		if(reverse){
+			m_reversed.assign(ring.rbegin(), ring.rend());
+
+			for(std::size_t k=0; k<n; k++)
+				m_type[offset + n - 1 - k] = classify(m_reversed, k);
+		}else{
+			for(std::size_t i=0; i<n; i++)
+				m_type[offset + i] = classify(ring, i);
+		}
+
+		for(std::size_t i=0; i<n; i++){
+			std::size_t before = offset + ((i == 0) ? n - 1 : i - 1);
+			std::size_t after = offset + ((i + 1 == n) ? 0 : i + 1);
+
+			m_next[offset + i] = reverse ? before : after;
+			m_prev[offset + i] = reverse ? after : before;
+		}
+	}
+
+	/*
+	 * the status edge directly to the left of the vertex `v`
+	 */
+	std::size_t left_of(std::size_t v) const
+	{
+		auto h = m_status.last_before([&](std::size_t e){
+			return turn(e, m_next[e], v) == LEFT;
+		});
+
+		return (h == m_status.npos) ? npos : m_status[h];
+	}
+
+	void insert_edge(std::size_t v)
+	{
+		m_helper[v] = v;
+		m_node[v] = m_status.insert(v, [&](std::size_t e){
+			direction d = turn(e, m_next[e], v);
+
+			if(d == ON)
+				d = turn(e, m_next[e], m_next[v]);
+
+			return d == RIGHT;
+		});
+	}
+
+	void erase_edge(std::size_t e)
+	{
+		if(m_node[e] != m_status.npos){
+			m_status.erase(m_node[e]);
+			m_node[e] = m_status.npos;
+		}
+	}
+
+	/*
+	 * the diagonal to the helper of the edge `e` when it is a merge
+	 * vertex
+	 */
+	void fix_up(std::size_t v, std::size_t e)
+	{
+		if(e != npos && m_helper[e] != npos && m_type[m_helper[e]] == MERGE)
+			m_diagonals.emplace_back(v, m_helper[e]);
+	}
+
+	void sweep()
+	{
+		const std::size_t n = m_points.size();
+
+		m_order.clear();
+		for(std::size_t v=0; v<n; v++)
+			if(m_next[v] != npos)
+				m_order.push_back(v);
+
+		std::sort(m_order.begin(), m_order.end(), [this](std::size_t a, std::size_t b){
+			return above(a, b);
+		});
+
+		m_status.clear();
+		m_helper.assign(n, npos);
+		m_node.assign(n, m_status.npos);
+
+		for(std::size_t v : m_order){
+			switch(m_type[v]){
+			case START:
+				insert_edge(v);
+				break;
+			case END:
+				fix_up(v, m_prev[v]);
+				erase_edge(m_prev[v]);
+				break;
+			case SPLIT:
+				if(std::size_t e = left_of(v); e != npos){
+					m_diagonals.emplace_back(v, m_helper[e]);
+					m_helper[e] = v;
+				}
+				insert_edge(v);
+				break;
+			case MERGE:
+				fix_up(v, m_prev[v]);
+				erase_edge(m_prev[v]);
+				if(std::size_t e = left_of(v); e != npos){
+					fix_up(v, e);
+					m_helper[e] = v;
+				}
+				break;
+			case REGULAR:
+				/*
+				 * the polygon is to the right of a vertex of a chain
+				 * that goes down
+				 */
+				if(above(v, m_next[v])){
+					fix_up(v, m_prev[v]);
+					erase_edge(m_prev[v]);
+					insert_edge(v);
+				}else if(std::size_t e = left_of(v); e != npos){
+					fix_up(v, e);
+					m_helper[e] = v;
+				}
+				break;
+			}
+		}
+	}
+
+	/*
+	 * whether the direction from `v` to `a` comes before the one to `b`
+	 * counterclockwise from the edge of the ring that leaves `v`
+	 */
+	bool counterclockwise_before(std::size_t v, std::size_t a, std::size_t b) const
+	{
+		auto half = [&](std::size_t p){
+			direction d = turn(v, m_next[v], p);
+			return (d == LEFT) ? 0 : (d == RIGHT) ? 2 : 1;
+		};
+
+		int ha = half(a), hb = half(b);
+		if(ha != hb)
+			return ha < hb;
+
+		return turn(v, a, b) == LEFT;
+	}
+
+	/*
+	 * links the half-edges inside the polygon and walks the pieces: the
+	 * next of a half-edge is the one that leaves its destination right
+	 * before its twin, clockwise
+	 */
+	void link_pieces()
+	{
+		const std::size_t n = m_points.size();
+		const std::size_t n_edges = n + 2*m_diagonals.size();
+
+		m_out_start.assign(n + 1, 0);
+		for(std::size_t v=0; v<n; v++)
+			if(m_next[v] != npos)
+				m_out_start[v + 1]++;
+		for(const auto& d : m_diagonals){
+			m_out_start[d.first + 1]++;
+			m_out_start[d.second + 1]++;
+		}
+		for(std::size_t v=0; v<n; v++)
+			m_out_start[v + 1] += m_out_start[v];
+
+		m_out.resize(m_out_start[n]);
+		m_out_place.assign(n_edges, npos);
+
+		std::vector<std::size_t>& fill = m_stack;
+		fill.assign(m_out_start.begin(), m_out_start.end() - 1);
+
+		for(std::size_t h=0; h<n_edges; h++)
+			if(h >= n || m_next[h] != npos)
+				m_out[fill[origin(h)]++] = h;
+
+		for(std::size_t v=0; v<n; v++){
+			auto first = m_out.begin() + m_out_start[v];
+			auto last = m_out.begin() + m_out_start[v + 1];
+
+			if(last - first > 2)
+				std::sort(first + 1, last, [&](std::size_t a, std::size_t b){
+					return counterclockwise_before(v, destination(a), destination(b));
+				});
+
+			for(auto i = first; i != last; i++)
+				m_out_place[*i] = i - m_out.begin();
+		}
+
+		m_edge_next.assign(n_edges, npos);
+		for(std::size_t h=0; h<n_edges; h++){
+			if(m_out_place[h] == npos)
+				continue;
+
+			std::size_t w = destination(h);
+			std::size_t twin = (h < n) ? npos : ((h - n)%2 ? h - 1 : h + 1);
+
+			m_edge_next[h] = (twin == npos)
+				? m_out[m_out_start[w + 1] - 1]
+				: m_out[m_out_place[twin] - 1];
+		}
+
+		/*
+		 * the pieces are the cycles of the half-edges
+		 */
+		m_piece_start.clear();
+		m_piece_vertex.clear();
+		m_piece_edge.clear();
+
+		std::vector<unsigned char>& visited = m_on_left;
+		visited.assign(n_edges, false);
+
+		for(std::size_t h=0; h<n_edges; h++){
+			if(visited[h] || m_out_place[h] == npos)
+				continue;
+
+			m_piece_start.push_back(m_piece_vertex.size());
+
+			for(std::size_t e = h; !visited[e]; e = m_edge_next[e]){
+				visited[e] = true;
+				m_piece_vertex.push_back(origin(e));
+				m_piece_edge.push_back(e);
+			}
+		}
+
+		m_piece_start.push_back(m_piece_vertex.size());
+	}
+
+	void emit(std::size_t a, std::size_t b, std::size_t c, std::vector<triangle>& triangles) const
+	{
+		switch(turn(a, b, c)){
+		case LEFT:
+			triangles.push_back(triangle{ a, b, c });
+			break;
+		case RIGHT:
+			triangles.push_back(triangle{ a, c, b });
+			break;
+		case ON:
+			break;
+		}
+	}
+
+	/*
+	 * triangulates the monotone piece of the `k` vertices from `piece`,
+	 * in counterclockwise order, with a stack of the vertices that are
+	 * left to be joined
+	 */
+	void triangulate_piece(
+		const std::size_t* piece,
+		std::size_t k,
+		std::vector<triangle>& triangles)
+	{
+		if(k < 3)
+			return;
+
+		std::size_t top = 0, bottom = 0;
+		for(std::size_t i=1; i<k; i++){
+			if(above(piece[i], piece[top]))
+				top = i;
+			if(above(piece[bottom], piece[i]))
+				bottom = i;
+		}
+
+		/*
+		 * the left chain goes from the top counterclockwise and the
+		 * right chain clockwise, both are merged from the top
+		 */
+		m_chain_order.clear();
+		m_on_left.clear();
+
+		std::size_t l = (top + 1)%k;
+		std::size_t r = (top + k - 1)%k;
+
+		m_chain_order.push_back(piece[top]);
+		m_on_left.push_back(true);
+
+		while(l != bottom || r != bottom){
+			bool take_left = (r == bottom)
+				|| (l != bottom && above(piece[l], piece[r]));
+
+			if(take_left){
+				m_chain_order.push_back(piece[l]);
+				m_on_left.push_back(true);
+				l = (l + 1)%k;
+			}else{
+				m_chain_order.push_back(piece[r]);
+				m_on_left.push_back(false);
+				r = (r + k - 1)%k;
+			}
+		}
+
+		m_chain_order.push_back(piece[bottom]);
+		m_on_left.push_back(false);
+
+		m_stack.clear();
+		m_stack.push_back(0);
+		m_stack.push_back(1);
+
+		for(std::size_t j=2; j + 1<k; j++){
+			const std::size_t u = m_chain_order[j];
+
+			if(m_on_left[j] != m_on_left[m_stack.back()]){
+				for(std::size_t i=0; i + 1<m_stack.size(); i++)
+					emit(u, m_chain_order[m_stack[i]], m_chain_order[m_stack[i + 1]], triangles);
+
+				m_stack.clear();
+				m_stack.push_back(j - 1);
+				m_stack.push_back(j);
+			}else{
+				std::size_t last = m_stack.back();
+				m_stack.pop_back();
+
+				const direction inside = m_on_left[j] ? LEFT : RIGHT;
+
+				while(!m_stack.empty()
+					&& turn(m_chain_order[m_stack.back()], m_chain_order[last], u) == inside){
+					emit(m_chain_order[m_stack.back()], m_chain_order[last], u, triangles);
+					last = m_stack.back();
+					m_stack.pop_back();
+				}
+
+				m_stack.push_back(last);
+				m_stack.push_back(j);
+			}
+		}
+
+		const std::size_t u = m_chain_order[k - 1];
+		for(std::size_t i=0; i + 1<m_stack.size(); i++)
+			emit(u, m_chain_order[m_stack[i]], m_chain_order[m_stack[i + 1]], triangles);
+	}
+};
+
+/**
+  * Partition of the polygon with holes `poly` in y-monotone pieces, by
+  * diagonals of a sweep line, in O(n lg n) time.
+  *
+  * @return	a dcel whose faces are the pieces, with the vertices of
+  *		the boundary and then the ones of each hole
+  *
+  * @see monotone_partitioner
+  */
+template<typename T>
+std::unique_ptr<dcel2d> monotone_partition(const polygon_with_holes<T, 2>& poly)
+{
+	monotone_partitioner<T> p;
+	p.partition(poly);
+
+	return p.to_dcel();
+}
+
+template<typename T>
+std::unique_ptr<dcel2d> monotone_partition(const polygon<T, 2>& poly)
+{
+	monotone_partitioner<T> p;
+	p.partition(poly);
+
+	return p.to_dcel();
+}
+
+/**
+  * Triangulation of the polygon with holes `poly` by its partition in
+  * monotone pieces, in O(n lg n) time for every simple polygon.
+  *
+  * @return	the triangles in counterclockwise order, whose vertices are
+  *		the ones of the boundary and then the ones of each hole
+  *
+  * @see monotone_partitioner
+  */
+template<typename T>
+triangle_mesh<T, 2> monotone_triangulation(const polygon_with_holes<T, 2>& poly)
+{
+	monotone_partitioner<T> p;
+	p.partition(poly);
+
+	triangle_mesh<T, 2> mesh;
+	mesh.vertices = p.vertices();
+	p.triangulate(mesh.triangles);
+
+	return mesh;
+}
+
+template<typename T>
+triangle_mesh<T, 2> monotone_triangulation(const polygon<T, 2>& poly)
+{
+	monotone_partitioner<T> p;
+	p.partition(poly);
+
+	triangle_mesh<T, 2> mesh;
+	mesh.vertices = p.vertices();
+	p.triangulate(mesh.triangles);
+
+	return mesh;
+}
+
+}
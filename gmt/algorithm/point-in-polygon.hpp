@@ -2,7 +2,12 @@
 
 #include <gmt/polygon.hpp>
 #include <gmt/polygon-with-holes.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/prepared-polygon.hpp>
+#include <gmt/polygon-set.hpp>
 #include <gmt/algorithm/direction.hpp>
+#include <gmt/algorithm/batch-direction.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
 #include <gmt/algorithm/intersection.hpp>
 #include <gmt/algorithm/misc.hpp>
 
@@ -14,11 +19,61 @@ typedef enum {
 	ON_BONDARY
 } side;
 
-side side_of(const polygon2d& poly, const point2d& p)
+/*
+ * accumulates in `wn` the winding number of the edges `first` to
+ * `first + count - 1` of a polygon around `p`, given the directions `d`
+ * of `p` in reference of those edges
+ *
+ * @return true if `p` is on one of the edges
+ */
+template<typename ring_type, typename T>
+bool winding_number_block(
+	const ring_type& poly,
+	size_t first,
+	size_t count,
+	const point<T, 2>& p,
+	const packed_direction* d,
+	int& wn)
+{
+	const size_t n = poly.size();
+
+	for(size_t k=0; k<count; k++){
+		size_t i = first + k;
+		point<T, 2> a = poly[i];
+		point<T, 2> b = poly[(i + 1 == n) ? 0 : i + 1];
+
+		/*
+		 * p == a and p == b are both collinear and between
+		 */
+		if(d[k] == gmt::ON && is_between(a, b, p))
+			return true;
+
+		if(a.y() <= p.y()){
+			if(b.y() > p.y() && d[k] == gmt::LEFT)
+				wn++;
+		}else{
+			if(b.y() <= p.y() && d[k] == gmt::RIGHT)
+				wn--;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * winding number test, the directions of `p` in reference of the edges
+ * are computed a block at a time by the batch functions of the predicate
+ * set `pred`, e.g., `robust_predicates` or `epsilon_predicates`. The
+ * points of the ring `poly` must be contiguous, e.g., a `polygon2d` or a
+ * `ring_view2d`.
+ */
+template<typename ring_type, typename predicates>
+side side_of_ring(const ring_type& poly, const point2d& p, const predicates& pred)
 {
 	int wn = 0;
+	const size_t n = poly.size();
 
-	switch(poly.size()){
+	switch(n){
 	case 0:
 		return OUTSIDE;
 		break;
@@ -29,31 +84,130 @@ side side_of(const polygon2d& poly, const point2d& p)
 		break;
 	}
 
-	for(size_t i=0; i<poly.size(); i++){
-		point2d a = poly[i];
-		point2d b = poly[(i+1)%poly.size()];
+	packed_direction d[direction_block];
+
+	for(size_t first=0; first<n; first += direction_block){
+		size_t count = std::min(direction_block, n - first);
 
-		if(p == a || p == b)
+		pred.ring_orientation_batch(poly.data(), n, first, count, p, d);
+
+		if(winding_number_block(poly, first, count, p, d, wn))
 			return ON_BONDARY;
+	}
+
+	if(wn != 0)
+		return INSIDE;
+
+	return OUTSIDE;
+}
+
+template<typename predicates>
+side side_of(const polygon2d& poly, const point2d& p, const predicates& pred)
+{
+	return side_of_ring(poly, p, pred);
+}
+
+template<typename predicates>
+side side_of(const ring_view2d& poly, const point2d& p, const predicates& pred)
+{
+	return side_of_ring(poly, p, pred);
+}
+
+/*
+ * side of `p` in the polygon whose vertices are the points of the
+ * buffer `poly`, the vertices are read directly from the columns
+ */
+template<typename predicates>
+side side_of(
+	const point_buffer2d& poly,
+	const point2d& p,
+	const predicates& pred)
+{
+	int wn = 0;
+	const size_t n = poly.size();
+
+	switch(n){
+	case 0:
+		return OUTSIDE;
+		break;
+	case 1:
+		if(poly[0] == p)
+			return INSIDE;
+		return OUTSIDE;
+		break;
+	}
 
-		if(is_collinear(a, b, p) && is_between(a, b, p))
+	packed_direction d[direction_block];
+
+	for(size_t first=0; first<n; first += direction_block){
+		size_t count = std::min(direction_block, n - first);
+
+		pred.ring_orientation_batch(poly, first, count, p, d);
+
+		if(winding_number_block(poly, first, count, p, d, wn))
 			return ON_BONDARY;
+	}
 
-		if(a.y() <= p.y()){
-			if(b.y() > p.y()){
-				gmt::direction d = direction_in(a, b, p);
-				if(d == gmt::LEFT)
-					wn++;
-			}
-		}else{
-			if(b.y() <= p.y()){
-				gmt::direction d = direction_in(a, b, p);
-				if(d == gmt::RIGHT)
-					wn--;
-			}
-				
+	if(wn != 0)
+		return INSIDE;
+
+	return OUTSIDE;
+}
+
+/*
+ * the default side_of decides the directions exactly
+ */
+inline side side_of(const polygon2d& poly, const point2d& p)
+{
+	return side_of(poly, p, robust_predicates(GMT_PREDICATE_SITE("side_of")));
+}
+
+inline side side_of(const point_buffer2d& poly, const point2d& p)
+{
+	return side_of(poly, p, robust_predicates(GMT_PREDICATE_SITE("side_of")));
+}
+
+inline side side_of(const ring_view2d& poly, const point2d& p)
+{
+	return side_of(poly, p, robust_predicates(GMT_PREDICATE_SITE("side_of")));
+}
+
+/*
+ * side of `p` in a polygon with integer coordinates, the directions come
+ * from the exact integer kernel of `direction_in`
+ */
+template<
+	typename T,
+	typename = typename std::enable_if<std::is_integral<T>::value>::type
+>
+side side_of(const polygon<T, 2>& poly, const point<T, 2>& p)
+{
+	int wn = 0;
+	const size_t n = poly.size();
+
+	switch(n){
+	case 0:
+		return OUTSIDE;
+		break;
+	case 1:
+		if(poly[0] == p)
+			return INSIDE;
+		return OUTSIDE;
+		break;
+	}
+
+	packed_direction d[direction_block];
+
+	for(size_t first=0; first<n; first += direction_block){
+		size_t count = std::min(direction_block, n - first);
+
+		for(size_t k=0; k<count; k++){
+			size_t i = first + k;
+			d[k] = direction_in(poly[i], poly[(i + 1 == n) ? 0 : i + 1], p);
 		}
 
+		if(winding_number_block(poly, first, count, p, d, wn))
+			return ON_BONDARY;
 	}
 
 	if(wn != 0)
@@ -62,11 +216,76 @@ side side_of(const polygon2d& poly, const point2d& p)
 	return OUTSIDE;
 }
 
+/*
+ * side of `p` in a strictly convex polygon by binary search in the fan of
+ * triangles of the vertex 0, `inner` is the direction of the interior in
+ * reference of the edges, i.e., the orientation of the polygon
+ */
+template<typename T>
+side side_of_convex(
+	const polygon<T, 2>& poly,
+	direction inner,
+	const point<T, 2>& p)
+{
+	predicate_counter* site = GMT_PREDICATE_SITE("side_of_convex");
+	const direction outer = (inner == LEFT) ? RIGHT : LEFT;
+	const size_t n = poly.size();
+
+	direction first = robust_direction_in(poly[0], poly[1], p, site);
+	if(first == outer)
+		return OUTSIDE;
+	else if(first == ON)
+		return is_between(poly[0], poly[1], p) ? ON_BONDARY : OUTSIDE;
+
+	direction last = robust_direction_in(poly[0], poly[n - 1], p, site);
+	if(last == inner)
+		return OUTSIDE;
+	else if(last == ON)
+		return is_between(poly[0], poly[n - 1], p) ? ON_BONDARY : OUTSIDE;
+
+	/*
+	 * `p` is in the wedge between the rays to the vertices lo and hi
+	 */
+	size_t lo = 1, hi = n - 1;
+	while(hi - lo > 1){
+		size_t mid = lo + (hi - lo)/2;
+
+		if(robust_direction_in(poly[0], poly[mid], p, site) == outer)
+			hi = mid;
+		else
+			lo = mid;
+	}
+
+	direction d = robust_direction_in(poly[lo], poly[hi], p, site);
+	if(d == inner)
+		return INSIDE;
+	else if(d == ON)
+		return ON_BONDARY;
+
+	return OUTSIDE;
+}
+
+/*
+ * the points outside the bounding box are rejected without reading the
+ * vertices and the strictly convex polygons are searched in O(log n)
+ */
+template<typename T>
+side side_of(const prepared_polygon<T>& poly, const point<T, 2>& p)
+{
+	if(poly.empty() || !poly.bounds().contains(p))
+		return OUTSIDE;
+
+	if(poly.is_strictly_convex())
+		return side_of_convex(poly.ring(), poly.orientation(), p);
+
+	return side_of(poly.ring(), p);
+}
+
 /*
  * FIXME: (maybe this is reasonable?) this algorithm works with the
  * assumption that the holes are inside the boundary
  */
-side side_of(const polygon_with_holes2d& poly, const point2d& p)
+inline side side_of(const polygon_with_holes2d& poly, const point2d& p)
 {
 	side s = side_of(poly.boundary(), p);
 	if(s != INSIDE)
@@ -83,6 +302,61 @@ side side_of(const polygon_with_holes2d& poly, const point2d& p)
 	return INSIDE;
 }
 
+/*
+ * side of `p` in a prepared polygon with holes, with the same assumption
+ * about the holes: the boundary answers first, with its bounding box and
+ * convexity, and then only the holes found by the index are tested
+ */
+template<typename T>
+side side_of(const prepared_polygon_with_holes<T>& poly, const point<T, 2>& p)
+{
+	side s = side_of(poly.boundary(), p);
+	if(s != INSIDE)
+		return s;
+
+	poly.holes_around(p, [&](size_t i){
+		if(s != INSIDE)
+			return;
+
+		switch(side_of(poly.hole(i), p)){
+		case ON_BONDARY:
+			s = ON_BONDARY;
+			break;
+		case INSIDE:
+			s = OUTSIDE;
+			break;
+		default:
+			break;
+		}
+	});
+
+	return s;
+}
+
+/*
+ * side of `p` in the polygon of a `polygon_set`, with the same
+ * assumption about the holes of the `polygon_with_holes2d` version
+ */
+inline side side_of(const polygon_view2d& poly, const point2d& p)
+{
+	if(!poly.n_rings())
+		return OUTSIDE;
+
+	side s = side_of(poly.boundary(), p);
+	if(s != INSIDE)
+		return s;
+
+	for(size_t i=0; i<poly.n_holes(); i++){
+		s = side_of(poly.hole(i), p);
+		if(s == ON_BONDARY)
+			return s;
+		else if(s == INSIDE)
+			return OUTSIDE;
+	}
+
+	return INSIDE;
+}
+
 template<typename T>
 bool point_in_polygon(const T& poly, const point2d& p)
 {
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-with-holes.hpp>
+#include <gmt/polygon-set.hpp>
+#include <gmt/bounding-box.hpp>
+#include <gmt/algorithm/misc.hpp>
+#include <gmt/algorithm/point-in-polygon.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+namespace gmt {
+
+/**
+  * Point location in a polygon by slab decomposition. The horizontal
+  * lines through the vertices cut the plane in slabs, and no edge begins
+  * or ends inside a slab, so the edges which cross a slab are sorted
+  * from left to right once, in the construction. A query finds its slab
+  * by a binary search in the heights of the vertices and the edges to
+  * its right by another binary search in the slab, so it is
+  * O(log n), with the same answers of `side_of`.
+  *
+  * The rings must not cross each other nor themselves, the holes of a
+  * `polygon_with_holes` are told by the parity of the edges to the right
+  * of the point. The memory is proportional to the number of pairs of
+  * slab and edge crossing it, `stats` reports it.
+  */
+class prepared_polygon_locator {
+public:
+	/** cost of the construction of the locator
+	  */
+	struct build_stats {
+		double build_seconds;
+		size_t memory_bytes;
+		size_t n_slabs;
+		size_t n_slab_edges;
+	};
+
+	explicit prepared_polygon_locator(const polygon2d& poly)
+	{
+		build(&poly, 1);
+	}
+
+	explicit prepared_polygon_locator(const polygon_with_holes2d& poly)
+	{
+		std::vector<ring_view2d> rings;
+		rings.reserve(poly.holes().size() + 1);
+
+		rings.push_back(poly.boundary());
+		for(const auto& hole : poly.holes())
+			rings.push_back(hole);
+
+		build(rings.data(), rings.size());
+	}
+
+	explicit prepared_polygon_locator(const polygon_view2d& poly)
+	{
+		std::vector<ring_view2d> rings;
+		rings.reserve(poly.n_rings());
+
+		for(size_t r=0; r<poly.n_rings(); r++)
+			rings.push_back(poly.ring(r));
+
+		build(rings.data(), rings.size());
+	}
+
+	side locate(const point2d& p) const
+	{
+		if(!m_bounds.contains(p))
+			return OUTSIDE;
+
+		auto level = std::lower_bound(m_levels.begin(), m_levels.end(), p.y());
+		size_t k = level - m_levels.begin();
+		size_t slab;
+
+		if(level != m_levels.end() && *level == p.y()){
+			if(on_level(k, p.x()))
+				return ON_BONDARY;
+
+			slab = k;
+		}else{
+			slab = k - 1;
+		}
+
+		/*
+		 * above the last level there is no slab
+		 */
+		if(slab + 1 >= m_levels.size())
+			return OUTSIDE;
+
+		/*
+		 * first edge of the slab with `p` to its left
+		 */
+		const uint32_t* first = m_slab_edges.data() + m_slab_offsets[slab];
+		const uint32_t* last = m_slab_edges.data() + m_slab_offsets[slab + 1];
+		predicate_counter* site = GMT_PREDICATE_SITE("locator");
+
+		size_t lo = 0, hi = last - first;
+		while(lo < hi){
+			size_t mid = lo + (hi - lo)/2;
+			const edge& e = m_edges[first[mid]];
+
+			direction d = robust_direction_in(e.lower, e.upper, p, site);
+			if(d == ON)
+				return ON_BONDARY;
+			else if(d == LEFT)
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+
+		if((last - first - lo)%2)
+			return INSIDE;
+
+		return OUTSIDE;
+	}
+
+	const build_stats& stats() const noexcept
+	{
+		return m_stats;
+	}
+
+private:
+	/*
+	 * non-horizontal edge, from its lowest end to its highest
+	 */
+	struct edge {
+		point2d lower;
+		point2d upper;
+	};
+
+	bounding_box2d m_bounds;
+
+	/*
+	 * heights of the vertices, in increasing order, the slab `k` is
+	 * between the levels `k` and `k + 1`
+	 */
+	std::vector<double> m_levels;
+
+	/*
+	 * disjoint intervals of x, in increasing order, of the vertices and
+	 * the horizontal edges of each level
+	 */
+	std::vector<size_t> m_level_offsets;
+	std::vector<std::pair<double, double>> m_intervals;
+
+	std::vector<edge> m_edges;
+	std::vector<size_t> m_slab_offsets;
+	std::vector<uint32_t> m_slab_edges;
+
+	build_stats m_stats;
+
+	size_t level_of(double y) const
+	{
+		return std::lower_bound(m_levels.begin(), m_levels.end(), y)
+			- m_levels.begin();
+	}
+
+	bool on_level(size_t k, double x) const
+	{
+		auto first = m_intervals.begin() + m_level_offsets[k];
+		auto last = m_intervals.begin() + m_level_offsets[k + 1];
+
+		/*
+		 * last interval which begins before or at x
+		 */
+		auto i = std::upper_bound(first, last, x,
+			[](double v, const std::pair<double, double>& r){
+				return v < r.first;
+			});
+
+		return i != first && std::prev(i)->second >= x;
+	}
+
+	template<typename ring_type>
+	void build(const ring_type* rings, size_t n_rings)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		size_t n_points = 0;
+		for(size_t r=0; r<n_rings; r++){
+			n_points += rings[r].size();
+			for(const auto& p : rings[r])
+				m_bounds.extend(p);
+		}
+
+		m_levels.reserve(n_points);
+		for(size_t r=0; r<n_rings; r++)
+			for(const auto& p : rings[r])
+				m_levels.push_back(p.y());
+
+		std::sort(m_levels.begin(), m_levels.end());
+		m_levels.erase(
+			std::unique(m_levels.begin(), m_levels.end()),
+			m_levels.end());
+
+		/*
+		 * the vertices and the horizontal edges go to their levels, the
+		 * other edges to the slabs they cross
+		 */
+		std::vector<std::pair<size_t, std::pair<double, double>>> spans;
+		std::vector<size_t> slab_count(m_levels.size() + 1, 0);
+
+		spans.reserve(n_points);
+		m_edges.reserve(n_points);
+
+		for(size_t r=0; r<n_rings; r++){
+			const size_t n = rings[r].size();
+
+			for(size_t i=0; i<n; i++){
+				const point2d& a = rings[r][i];
+				const point2d& b = rings[r][(i + 1 == n) ? 0 : i + 1];
+
+				if(a.y() == b.y()){
+					spans.push_back({ level_of(a.y()), {
+						std::min(a.x(), b.x()),
+						std::max(a.x(), b.x())
+					}});
+					continue;
+				}
+
+				spans.push_back({ level_of(a.y()), { a.x(), a.x() } });
+
+				edge e = (a.y() < b.y()) ? edge{ a, b } : edge{ b, a };
+				m_edges.push_back(e);
+
+				for(size_t k = level_of(e.lower.y()); m_levels[k] < e.upper.y(); k++)
+					slab_count[k + 1]++;
+			}
+		}
+
+		/*
+		 * merge the intervals of each level
+		 */
+		std::sort(spans.begin(), spans.end());
+		m_level_offsets.assign(m_levels.size() + 1, 0);
+
+		for(size_t i=0; i<spans.size(); i++){
+			const size_t k = spans[i].first;
+			const auto& span = spans[i].second;
+
+			if(i && spans[i - 1].first == k
+				&& span.first <= m_intervals.back().second){
+				m_intervals.back().second =
+					std::max(m_intervals.back().second, span.second);
+			}else{
+				m_intervals.push_back(span);
+			}
+
+			m_level_offsets[k + 1] = m_intervals.size();
+		}
+
+		for(size_t k=1; k<m_level_offsets.size(); k++)
+			m_level_offsets[k] = std::max(m_level_offsets[k], m_level_offsets[k - 1]);
+
+		/*
+		 * edges of the slabs, sorted by their x in the middle of the
+		 * slab
+		 */
+		m_slab_offsets.assign(m_levels.size() + 1, 0);
+		for(size_t k=1; k<slab_count.size() && k<m_slab_offsets.size(); k++)
+			m_slab_offsets[k] = m_slab_offsets[k - 1] + slab_count[k];
+
+		m_slab_edges.resize(m_slab_offsets.back());
+		std::vector<size_t> fill(m_slab_offsets.begin(), m_slab_offsets.end() - 1);
+
+		for(size_t i=0; i<m_edges.size(); i++){
+			const edge& e = m_edges[i];
+			for(size_t k = level_of(e.lower.y()); m_levels[k] < e.upper.y(); k++)
+				m_slab_edges[fill[k]++] = uint32_t(i);
+		}
+
+		for(size_t k=0; k+1<m_levels.size(); k++){
+			const double y = (m_levels[k] + m_levels[k + 1])/2.0;
+
+			auto x_at = [&](uint32_t i){
+				const edge& e = m_edges[i];
+				double t = (y - e.lower.y())/(e.upper.y() - e.lower.y());
+				return e.lower.x() + t*(e.upper.x() - e.lower.x());
+			};
+
+			std::sort(
+				m_slab_edges.begin() + m_slab_offsets[k],
+				m_slab_edges.begin() + m_slab_offsets[k + 1],
+				[&](uint32_t i, uint32_t j){ return x_at(i) < x_at(j); });
+		}
+
+		m_stats.build_seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+		m_stats.n_slabs = m_levels.size() ? m_levels.size() - 1 : 0;
+		m_stats.n_slab_edges = m_slab_edges.size();
+		m_stats.memory_bytes = sizeof(*this)
+			+ m_levels.capacity()*sizeof(double)
+			+ m_level_offsets.capacity()*sizeof(size_t)
+			+ m_intervals.capacity()*sizeof(std::pair<double, double>)
+			+ m_edges.capacity()*sizeof(edge)
+			+ m_slab_offsets.capacity()*sizeof(size_t)
+			+ m_slab_edges.capacity()*sizeof(uint32_t);
+	}
+};
+
+inline side side_of(const prepared_polygon_locator& locator, const point2d& p)
+{
+	return locator.locate(p);
+}
+
+}
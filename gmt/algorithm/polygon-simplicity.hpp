@@ -0,0 +1,335 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-with-holes.hpp>
+#include <gmt/segment.hpp>
+#include <gmt/sweep-tree.hpp>
+#include <gmt/algorithm/misc.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+namespace gmt {
+
+/**
+  * Search of the first pair of edges of the rings of a polygon that meet
+  * where they should not, by the sweep of Shamos and Hoey. It takes
+  * O(n lg n) time for n edges, whether the rings are simple or not.
+  *
+  * The line sweeps the endpoints of the edges from the left, and the
+  * status keeps the edges it crosses from the lowest. Until a pair is
+  * found no two edges cross, so their order only changes at the
+  * endpoints, which are the only events: at each one the edges through
+  * its point are tested, and then the edges that become neighbours in
+  * the status, and the search stops at the first pair that meets. The
+  * tests are exact orientations, no point is computed.
+  *
+  * The edges are numbered as the vertices, the ones of the first ring
+  * and then the ones of each next ring in order, and the edge `i` goes
+  * from the vertex `i` to the next one of its ring.
+  */
+template<typename T>
+class self_intersection_finder {
+public:
+	typedef std::pair<std::size_t, std::size_t> edge_pair;
+
+	/** @brief appends a ring to be searched
+	  */
+	void add_ring(const polygon<T, 2>& ring)
+	{
+		const std::size_t n = ring.size();
+		const std::size_t offset = m_segments.size();
+
+		for(std::size_t i=0; i<n; i++){
+			std::size_t j = (i + 1 == n) ? 0 : i + 1;
+
+			m_segments.emplace_back(ring[i], ring[j]);
+			m_next.push_back(offset + j);
+		}
+	}
+
+	void clear() noexcept
+	{
+		m_segments.clear();
+		m_next.clear();
+	}
+
+	/**
+	  * the first pair of edges that meet where they should not, the
+	  * first of them the lower, or nothing if there is none. The edge
+	  * of a ring of one vertex is a point and its own next edge, it is
+	  * given as the pair `(i, i)`.
+	  */
+	std::optional<edge_pair> find()
+	{
+		/*
+		 * consecutive edges meet only in their shared vertex, unless an
+		 * edge is a point or the second one goes back over the first
+		 */
+		for(std::size_t i=0; i<m_segments.size(); i++){
+			const point<T, 2>& a = m_segments[i].from;
+			const point<T, 2>& b = m_segments[i].to;
+			const point<T, 2>& c = m_segments[m_next[i]].to;
+
+			if(a == b || (robust_direction_in(a, b, c, m_site) == ON
+				&& (is_between(a, b, c) || is_between(b, c, a))))
+				return ordered(i, m_next[i]);
+		}
+
+		const std::size_t n = m_segments.size();
+
+		m_a.resize(n);
+		m_b.resize(n);
+		m_endpoints.clear();
+		m_endpoints.reserve(2*n);
+
+		for(std::size_t i=0; i<n; i++){
+			bool swap = less(m_segments[i].to, m_segments[i].from);
+
+			m_a[i] = swap ? m_segments[i].to : m_segments[i].from;
+			m_b[i] = swap ? m_segments[i].from : m_segments[i].to;
+			m_endpoints.push_back(endpoint{ m_a[i], i, true });
+			m_endpoints.push_back(endpoint{ m_b[i], i, false });
+		}
+
+		std::sort(m_endpoints.begin(), m_endpoints.end(),
+			[](const endpoint& e0, const endpoint& e1){
+				return less(e0.p, e1.p);
+			});
+
+		m_status.clear();
+		m_node.assign(n, m_status.npos);
+
+		for(std::size_t e=0; e<m_endpoints.size();){
+			const point<T, 2> p = m_endpoints[e].p;
+
+			handle lower = m_status.last_before([&](std::size_t s){
+				return turn(m_a[s], m_b[s], p) == LEFT;
+			});
+
+			/*
+			 * the edges of the status through `p`, and then the ones
+			 * that start at it
+			 */
+			m_at.clear();
+			for(handle h = (lower == m_status.npos) ? m_status.first() : m_status.next(lower);
+				h != m_status.npos && turn(m_a[m_status[h]], m_b[m_status[h]], p) == ON;
+				h = m_status.next(h))
+				m_at.push_back(m_status[h]);
+
+			const std::size_t n_through = m_at.size();
+
+			for(; e < m_endpoints.size() && m_endpoints[e].p == p; e++)
+				if(m_endpoints[e].start)
+					m_at.push_back(m_endpoints[e].segment);
+
+			/*
+			 * the edges at `p` meet there, which only two consecutive
+			 * edges may do, in their shared vertex: past this test the
+			 * edges of the status through `p` end at it, and there are
+			 * at most two edges at `p`
+			 */
+			for(std::size_t i=0; i<m_at.size(); i++)
+				for(std::size_t j=i+1; j<m_at.size(); j++)
+					if(!consecutive(m_at[i], m_at[j]))
+						return ordered(m_at[i], m_at[j]);
+
+			for(std::size_t i=0; i<n_through; i++){
+				m_status.erase(m_node[m_at[i]]);
+				m_node[m_at[i]] = m_status.npos;
+			}
+
+			m_at.erase(m_at.begin(), m_at.begin() + n_through);
+			std::sort(m_at.begin(), m_at.end(), [&](std::size_t s, std::size_t t){
+				return turn(p, m_b[s], m_b[t]) == LEFT;
+			});
+
+			handle h = lower;
+			for(std::size_t s : m_at){
+				h = m_status.insert_after(h, s);
+				m_node[s] = h;
+			}
+
+			/*
+			 * the neighbours that become adjacent: the ones around the
+			 * removed edges, or the new edges and the ones around them
+			 */
+			std::optional<edge_pair> found;
+			if(m_at.empty()){
+				if(lower != m_status.npos)
+					found = check(lower, m_status.next(lower));
+			}else{
+				found = check(lower, m_node[m_at.front()]);
+				if(!found)
+					found = check(h, m_status.next(h));
+			}
+
+			if(found)
+				return found;
+		}
+
+		return std::nullopt;
+	}
+
+private:
+	typedef typename sweep_tree<std::size_t>::handle handle;
+
+	struct endpoint {
+		point<T, 2> p;
+		std::size_t segment;
+		bool start;
+	};
+
+	predicate_counter* m_site = GMT_PREDICATE_SITE("self_intersection");
+
+	std::vector<segment<T, 2>> m_segments;
+	std::vector<std::size_t> m_next;
+
+	/*
+	 * the edges from their lower endpoint `m_a` to their greater one
+	 * `m_b`, their endpoints in the order of the sweep, the status and
+	 * the node of each edge in it
+	 */
+	std::vector<point<T, 2>> m_a;
+	std::vector<point<T, 2>> m_b;
+	std::vector<endpoint> m_endpoints;
+	sweep_tree<std::size_t> m_status;
+	std::vector<handle> m_node;
+	std::vector<std::size_t> m_at;
+
+	static bool less(const point<T, 2>& p0, const point<T, 2>& p1)
+	{
+		return p0.x() < p1.x() || (p0.x() == p1.x() && p0.y() < p1.y());
+	}
+
+	direction turn(const point<T, 2>& p0, const point<T, 2>& p1, const point<T, 2>& p2) const
+	{
+		return robust_direction_in(p0, p1, p2, m_site);
+	}
+
+	bool consecutive(std::size_t s, std::size_t t) const
+	{
+		return m_next[s] == t || m_next[t] == s;
+	}
+
+	/*
+	 * the pair of two neighbours of the status if they meet; consecutive
+	 * edges only meet in their shared vertex, they are not tested
+	 */
+	std::optional<edge_pair> check(handle hs, handle ht) const
+	{
+		if(hs == m_status.npos || ht == m_status.npos)
+			return std::nullopt;
+
+		const std::size_t s = m_status[hs];
+		const std::size_t t = m_status[ht];
+
+		if(consecutive(s, t))
+			return std::nullopt;
+
+		direction d0 = turn(m_a[t], m_b[t], m_a[s]);
+		direction d1 = turn(m_a[t], m_b[t], m_b[s]);
+		direction d2 = turn(m_a[s], m_b[s], m_a[t]);
+		direction d3 = turn(m_a[s], m_b[s], m_b[t]);
+
+		bool meet = (d0 != ON && d1 != ON && d2 != ON && d3 != ON && d0 != d1 && d2 != d3)
+			|| (d0 == ON && is_between(m_a[t], m_b[t], m_a[s]))
+			|| (d1 == ON && is_between(m_a[t], m_b[t], m_b[s]))
+			|| (d2 == ON && is_between(m_a[s], m_b[s], m_a[t]))
+			|| (d3 == ON && is_between(m_a[s], m_b[s], m_b[t]));
+
+		if(meet)
+			return ordered(s, t);
+
+		return std::nullopt;
+	}
+
+	static edge_pair ordered(std::size_t i, std::size_t j)
+	{
+		return (i < j) ? edge_pair(i, j) : edge_pair(j, i);
+	}
+};
+
+/**
+  * First pair of edges of the polygon `poly` that meet where they should
+  * not, found by the sweep of Shamos and Hoey in O(n lg n) time: two
+  * edges that are not consecutive may not share a point, and two
+  * consecutive edges may share only their common vertex.
+  *
+  * @return	the edges `i < j`, the edge `i` goes from the vertex `i`
+  *		to the next one, or nothing if there is no such pair. A
+  *		polygon of one vertex gives `(0, 0)`.
+  *
+  * @see self_intersection_finder
+  */
+template<typename T>
+std::optional<std::pair<std::size_t, std::size_t>> first_self_intersection(
+	const polygon<T, 2>& poly)
+{
+	self_intersection_finder<T> finder;
+	finder.add_ring(poly);
+
+	return finder.find();
+}
+
+/**
+  * First pair of edges of the polygon with holes `poly` that meet where
+  * they should not, in its boundary, in a hole, or in two of its rings.
+  *
+  * @return	the edges `i < j`, numbered as the vertices of the
+  *		boundary and then the ones of each hole, or nothing if there
+  *		is no such pair. A ring of one vertex `i` gives `(i, i)`.
+  *
+  * @see self_intersection_finder
+  */
+template<typename T>
+std::optional<std::pair<std::size_t, std::size_t>> first_self_intersection(
+	const polygon_with_holes<T, 2>& poly)
+{
+	self_intersection_finder<T> finder;
+
+	finder.add_ring(poly.boundary());
+	for(const auto& hole : poly.holes())
+		finder.add_ring(hole);
+
+	return finder.find();
+}
+
+/**
+  * checks whether the polygon `poly` is simple: it has at least three
+  * vertices, no two edges meet but the consecutive ones in their shared
+  * vertex
+  *
+  * @see first_self_intersection
+  */
+template<typename T>
+bool is_simple(const polygon<T, 2>& poly)
+{
+	return poly.size() >= 3 && !first_self_intersection(poly);
+}
+
+/**
+  * checks whether the boundary and the holes of `poly` are simple and do
+  * not meet each other. Whether the holes are inside the boundary and
+  * out of each other is not checked.
+  *
+  * @see first_self_intersection
+  */
+template<typename T>
+bool is_simple(const polygon_with_holes<T, 2>& poly)
+{
+	if(poly.boundary().size() < 3)
+		return false;
+
+	for(const auto& hole : poly.holes())
+		if(hole.size() < 3)
+			return false;
+
+	return !first_self_intersection(poly);
+}
+
+}
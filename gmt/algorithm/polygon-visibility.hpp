@@ -1,16 +1,24 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include <gmt/polygon.hpp>
+#include <gmt/polygon-set.hpp>
 #include <gmt/line.hpp>
 #include <gmt/segment.hpp>
+#include <gmt/sweep-tree.hpp>
 
 #include <gmt/algorithm/intersection.hpp>
 #include <gmt/algorithm/misc.hpp>
 #include <gmt/algorithm/distance.hpp>
 #include <gmt/algorithm/direction.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
 
 namespace gmt {
 
@@ -34,7 +42,19 @@ public:
 		bool v1_above_xaxis = v1.x() >= 0.0;
 
 		if(v0_above_xaxis == v1_above_xaxis){
-			switch(direction_in(v0, v1, 1.0)){
+			/*
+			 * exact direction of the rays, a fixed tolerance
+			 * would merge distinct rays of long edges
+			 */
+			point2d origin;
+			point2d p0{ double(v0.x()), double(v0.y()) };
+			point2d p1{ double(v1.x()), double(v1.y()) };
+
+			switch(robust_direction_in(
+				origin,
+				p0,
+				p1,
+				GMT_PREDICATE_SITE("ray_comparator"))){
 			case RIGHT:
 				return true;
 				break;
@@ -58,10 +78,10 @@ public:
  * return 1 if the rays continue to the left
  * return 2 if the rays continue to the right
  */
-template<typename T, std::size_t n_dimension>
+template<typename ring_type, typename T, std::size_t n_dimension>
 int ray_continues(
 	const point<T, n_dimension>& p,
-	const polygon<T, n_dimension>& poly,
+	const ring_type& poly,
 	const size_t index)
 {
 	size_t next_index = (index+1)% poly.size();
@@ -90,10 +110,14 @@ int ray_continues(
 
 }
 
-template <typename T, std::size_t n_dimension>
+/*
+ * `poly_list` is a list of rings, e.g., a `std::vector` of `polygon`s or
+ * the `rings()` of a `polygon_set`
+ */
+template <typename ring_list, typename T, std::size_t n_dimension>
 void cast_ray(
 	const point<T, n_dimension>& p,
-	const std::vector<polygon<T, n_dimension>>& poly_list,
+	const ring_list& poly_list,
 	size_t poly_index,
 	size_t vertex_index,
 	std::vector<vec<T, n_dimension>>& rays)
@@ -110,42 +134,44 @@ void cast_ray(
 			size_t p0 = j - 1;
 			size_t p1 = j%(poly_list[i].size());
 
-			try{
-				segment<T, n_dimension> seg(
-					poly_list[i][p0],
-					poly_list[i][p1]
-				);
+			segment<T, n_dimension> seg(
+				poly_list[i][p0],
+				poly_list[i][p1]
+			);
 
-				point<T, n_dimension> intersection
-					= point_of_intersection(l, seg);
+			std::optional<point<T, n_dimension>> hit =
+				intersect_line_segment(l, seg);
 
-				if(is_between<T, n_dimension>(
-					poly_list[poly_index][vertex_index],
-					intersection,
-					p)){
-					continue;
-				}
+			if(!hit)
+				continue;
 
-				if(i == poly_index && (p0 == vertex_index
-					|| p1 == vertex_index)){
+			point<T, n_dimension> intersection = *hit;
 
-					ray_continuation = ray_continues(
-								p,
-								poly_list[i],
-								vertex_index
-					);
+			if(is_between<T, n_dimension>(
+				poly_list[poly_index][vertex_index],
+				intersection,
+				p)){
+				continue;
+			}
 
-					if(ray_continuation > 0)
-						continue;
-				}
+			if(i == poly_index && (p0 == vertex_index
+				|| p1 == vertex_index)){
 
-				T d = distance(p, intersection);
-				if((min == -1 || d < min)){
-					min = d;
-					closest = intersection;
-				}
+				ray_continuation = ray_continues(
+							p,
+							poly_list[i],
+							vertex_index
+				);
 
-			}catch(line_does_not_intersect_segment& e){}
+				if(ray_continuation > 0)
+					continue;
+			}
+
+			T d = distance(p, intersection);
+			if((min == -1 || d < min)){
+				min = d;
+				closest = intersection;
+			}
 		}
 	}
 
@@ -170,10 +196,10 @@ void cast_ray(
 }
 
 
-template <typename T, std::size_t n_dimension>
-polygon<T, n_dimension> polygon_visibility(
+template <typename ring_list, typename T, std::size_t n_dimension>
+polygon<T, n_dimension> polygon_visibility_of_rings(
 	const point<T, n_dimension>& p,
-	const std::vector<polygon<T, n_dimension>>& poly_list)
+	const ring_list& poly_list)
 {
 
 	std::vector<vec<T, n_dimension>> rays;
@@ -194,4 +220,521 @@ polygon<T, n_dimension> polygon_visibility(
 	return visibility;
 }
 
+template <typename T, std::size_t n_dimension>
+polygon<T, n_dimension> polygon_visibility(
+	const point<T, n_dimension>& p,
+	const std::vector<polygon<T, n_dimension>>& poly_list)
+{
+	return polygon_visibility_of_rings(p, poly_list);
+}
+
+/*
+ * every ring of the set, boundaries and holes, blocks the visibility
+ */
+template <typename T, std::size_t n_dimension>
+polygon<T, n_dimension> polygon_visibility(
+	const point<T, n_dimension>& p,
+	const polygon_set_view<T, n_dimension>& set)
+{
+	return polygon_visibility_of_rings(p, set.rings());
+}
+
+template <typename T, std::size_t n_dimension>
+polygon<T, n_dimension> polygon_visibility(
+	const point<T, n_dimension>& p,
+	const polygon_set<T, n_dimension>& set)
+{
+	return polygon_visibility(p, set.view());
+}
+
+/**
+  * Visibility polygon of a point among rings by a rotational sweep, in
+  * O(n lg n) time for n vertices. A ray from the point turns clockwise
+  * from the upward direction, the edges it crosses are kept in a
+  * `sweep_tree` from the nearest to the farthest, and at the direction
+  * of each vertex the nearest edge before and after it gives the points
+  * of the polygon, so it is built in a single pass.
+  *
+  * The polygon is the one of `polygon_visibility`, in the same order,
+  * with a point for each direction of the vertices where the visible
+  * boundary is, and two where it jumps from an edge to another one. The
+  * edges in line with the point do not block it. The decisions are
+  * exact, only the points on the edges are rounded, and the buffers are
+  * kept from a query to the next one.
+  *
+  * The edges of the rings must not cross each other, they may only
+  * touch: the order of the status compares two edges by the side of
+  * the line of one of them where the other one is, which holds on every
+  * ray only when they do not cross, and at a vertex the edge that the
+  * ray enters takes the place of the one it leaves.
+  */
+template<typename T>
+class visibility_sweep {
+public:
+	/**
+	  * the visibility polygon of `p` among the rings of `poly_list`,
+	  * e.g., a `std::vector` of `polygon`s or the `rings()` of a
+	  * `polygon_set`
+	  */
+	template<typename ring_list>
+	polygon<T, 2> compute(const point<T, 2>& p, const ring_list& poly_list)
+	{
+		polygon<T, 2> visibility;
+		compute(p, poly_list, visibility);
+		return visibility;
+	}
+
+	/**
+	  * the visibility polygon of `p` in `visibility`, whose storage is
+	  * reused
+	  */
+	template<typename ring_list>
+	void compute(
+		const point<T, 2>& p,
+		const ring_list& poly_list,
+		polygon<T, 2>& visibility)
+	{
+		m_p = p;
+		m_points.clear();
+		m_next.clear();
+		m_prev.clear();
+
+		for(std::size_t i=0; i<poly_list.size(); i++){
+			const std::size_t n = poly_list[i].size();
+			const std::size_t offset = m_points.size();
+
+			for(std::size_t j=0; j<n; j++){
+				m_points.push_back(poly_list[i][j]);
+				m_next.push_back(offset + ((j + 1 == n) ? 0 : j + 1));
+				m_prev.push_back(offset + ((j == 0) ? n - 1 : j - 1));
+			}
+		}
+
+		sweep(visibility);
+	}
+
+private:
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	predicate_counter* m_site = GMT_PREDICATE_SITE("visibility_sweep");
+
+	point<T, 2> m_p;
+
+	/*
+	 * the vertices of all the rings, the edge `i` goes from the vertex
+	 * `i` to the next one of its ring
+	 */
+	std::vector<point<T, 2>> m_points;
+	std::vector<std::size_t> m_next;
+	std::vector<std::size_t> m_prev;
+
+	/*
+	 * the vertices in the order of the sweep with the keys of their
+	 * directions, and the edges that are not in line with `m_p` with the
+	 * vertex where the ray enters them
+	 */
+	std::vector<std::size_t> m_order;
+	std::vector<std::uint32_t> m_keys;
+	std::vector<std::size_t> m_ray;
+	std::size_t m_n_rays = 0;
+	std::vector<std::pair<std::uint32_t, std::size_t>> m_sorted;
+	std::vector<std::pair<std::uint32_t, std::size_t>> m_buffer;
+	std::vector<unsigned char> m_blocks;
+	std::vector<direction> m_side;
+	std::vector<std::size_t> m_enter;
+	sweep_tree<std::size_t> m_status;
+	std::vector<typename sweep_tree<std::size_t>::handle> m_node;
+
+	direction turn(const point<T, 2>& a, const point<T, 2>& b, const point<T, 2>& c) const
+	{
+		return robust_direction_in(a, b, c, m_site);
+	}
+
+	/*
+	 * the half of the turn of the ray that `q` is in, the first one
+	 * goes from the upward direction, included, to the downward one
+	 */
+	int half(const point<T, 2>& q) const
+	{
+		return (q.x() > m_p.x() || (q.x() == m_p.x() && q.y() > m_p.y())) ? 0 : 1;
+	}
+
+	bool sweeps_before(const point<T, 2>& a, const point<T, 2>& b) const
+	{
+		int ha = half(a), hb = half(b);
+		if(ha != hb)
+			return ha < hb;
+
+		return turn(m_p, a, b) == RIGHT;
+	}
+
+	bool same_ray(const point<T, 2>& a, const point<T, 2>& b) const
+	{
+		return half(a) == half(b) && turn(m_p, a, b) == ON;
+	}
+
+	std::size_t leave(std::size_t e) const
+	{
+		return (m_enter[e] == e) ? m_next[e] : e;
+	}
+
+	/*
+	 * whether the ray leaves one edge of the vertex `v` and enters the
+	 * other one there, with the first one in the status
+	 */
+	bool passes(std::size_t v) const
+	{
+		std::size_t e = m_prev[v];
+		std::size_t f = v;
+
+		if(!m_blocks[e] || !m_blocks[f])
+			return false;
+
+		if(leave(f) == v)
+			std::swap(e, f);
+
+		return leave(e) == v && m_enter[f] == v
+			&& m_node[e] != m_status.npos && m_node[f] == m_status.npos;
+	}
+
+	/*
+	 * whether the edge `e` is nearer to `m_p` than `f` on the rays that
+	 * cross both, the edges do not cross each other. The side of `m_p`
+	 * of each edge is the one of `m_side`.
+	 */
+	bool nearer(std::size_t e, std::size_t f) const
+	{
+		const point<T, 2>& e0 = m_points[e];
+		const point<T, 2>& e1 = m_points[m_next[e]];
+		const point<T, 2>& f0 = m_points[f];
+		const point<T, 2>& f1 = m_points[m_next[f]];
+
+		direction side = m_side[e];
+		direction d0 = turn(e0, e1, f0);
+		direction d1 = turn(e0, e1, f1);
+
+		if(d0 == ON && d1 == ON)
+			return e < f;
+
+		/*
+		 * `f` is on the side of `m_p` or on the other one of the line
+		 * of `e`, or it crosses the line and `e` is on one side of `f`
+		 */
+		if((d0 == side || d0 == ON) && (d1 == side || d1 == ON))
+			return false;
+
+		if(d0 != side && d1 != side)
+			return true;
+
+		side = m_side[f];
+		d0 = turn(f0, f1, e0);
+		d1 = turn(f0, f1, e1);
+
+		return (d0 == side || d0 == ON) && (d1 == side || d1 == ON);
+	}
+
+	/*
+	 * point of the ray from `m_p` through `q` on the edge `e`, the ray
+	 * of the vertices of the current event
+	 */
+	point<T, 2> hit(std::size_t e, const point<T, 2>& q) const
+	{
+		const point<T, 2>& e0 = m_points[e];
+		const point<T, 2>& e1 = m_points[m_next[e]];
+
+		if(m_ray[e] == m_n_rays)
+			return e0;
+		if(m_ray[m_next[e]] == m_n_rays)
+			return e1;
+
+		point2d a{ double(e0.x()), double(e0.y()) };
+		point2d b{ double(e1.x()), double(e1.y()) };
+		point2d o{ double(m_p.x()), double(m_p.y()) };
+		point2d d{ double(q.x()), double(q.y()) };
+
+		double op = orient2d(a, b, o);
+		double od = orient2d(a, b, d);
+		double t = op/(op - od);
+
+		point<T, 2> r;
+		r.x() = T(o.x() + t*(d.x() - o.x()));
+		r.y() = T(o.y() + t*(d.y() - o.y()));
+		return r;
+	}
+
+	/*
+	 * the vertices are sorted by a key of their direction, the half of
+	 * the turn in the highest bit and the rest of the turn given by
+	 * `y/(|x| + |y|)`, which only changes with the angle, and the order
+	 * of the close directions is then fixed by the exact test. The key
+	 * is off by less than one from the exact one, so the directions
+	 * whose keys differ by more than one are already in order.
+	 */
+	static bool close_keys(std::uint32_t a, std::uint32_t b)
+	{
+		return (a > b) ? a - b <= 1 : b - a <= 1;
+	}
+
+	void sort_vertices()
+	{
+		const std::size_t n = m_points.size();
+		const double px = double(m_p.x()), py = double(m_p.y());
+
+		m_sorted.clear();
+		for(std::size_t v=0; v<n; v++){
+			if(m_points[v] == m_p)
+				continue;
+
+			double dx = double(m_points[v].x()) - px;
+			double dy = double(m_points[v].y()) - py;
+			double t = dy/(std::fabs(dx) + std::fabs(dy));
+
+			int h = half(m_points[v]);
+			double u = std::min(std::max(h ? t + 1.0 : 1.0 - t, 0.0), 2.0);
+
+			m_sorted.emplace_back(
+				(std::uint32_t(h) << 31) | std::uint32_t(u*1073741823.0),
+				v);
+		}
+
+		radix_sort();
+
+		m_order.resize(m_sorted.size());
+		m_keys.resize(m_sorted.size());
+		for(std::size_t i=0; i<m_sorted.size(); i++){
+			std::uint32_t key = m_sorted[i].first;
+			std::size_t v = m_sorted[i].second;
+			std::size_t j = i;
+
+			for(; j > 0 && close_keys(key, m_keys[j - 1])
+				&& sweeps_before(m_points[v], m_points[m_order[j - 1]]); j--){
+				m_order[j] = m_order[j - 1];
+				m_keys[j] = m_keys[j - 1];
+			}
+
+			m_order[j] = v;
+			m_keys[j] = key;
+		}
+	}
+
+	/*
+	 * sorts `m_sorted` by the keys, a byte at a time from the lowest
+	 */
+	void radix_sort()
+	{
+		m_buffer.resize(m_sorted.size());
+
+		for(unsigned shift=0; shift<32; shift += 8){
+			std::size_t count[257] = {};
+
+			for(const auto& e : m_sorted)
+				count[((e.first >> shift) & 0xff) + 1]++;
+
+			for(std::size_t k=0; k<256; k++)
+				count[k + 1] += count[k];
+
+			for(const auto& e : m_sorted)
+				m_buffer[count[(e.first >> shift) & 0xff]++] = e;
+
+			m_sorted.swap(m_buffer);
+		}
+	}
+
+	void insert(std::size_t e)
+	{
+		m_node[e] = m_status.insert(e, [&](std::size_t f){
+			return nearer(e, f);
+		});
+	}
+
+	/*
+	 * inserts the edge `e` at the vertex `v` where the ray enters it.
+	 * The edges of the status cross the ray of `v`, so `e` is nearer
+	 * than `f` when `v` is on the side of `m_p` of `f`, and only a
+	 * vertex on `f` needs the full test.
+	 */
+	void insert_at(std::size_t e, std::size_t v)
+	{
+		const point<T, 2>& q = m_points[v];
+
+		m_node[e] = m_status.insert(e, [&](std::size_t f){
+			direction d = turn(m_points[f], m_points[m_next[f]], q);
+
+			if(d == ON)
+				return nearer(e, f);
+
+			return d == m_side[f];
+		});
+	}
+
+	/*
+	 * inserts the edge `e` next to the edge `f` of the status, before it
+	 * if it is nearer
+	 */
+	void insert_beside(std::size_t e, std::size_t f)
+	{
+		if(nearer(e, f))
+			m_node[e] = m_status.insert_after(m_status.prev(m_node[f]), e);
+		else
+			m_node[e] = m_status.insert_after(m_node[f], e);
+	}
+
+	void sweep(polygon<T, 2>& visibility)
+	{
+		const std::size_t n = m_points.size();
+
+		visibility.clear();
+		m_status.clear();
+		m_node.assign(n, m_status.npos);
+		m_blocks.assign(n, false);
+		m_side.assign(n, ON);
+		m_enter.assign(n, 0);
+		m_ray.assign(n, 0);
+		m_n_rays = 0;
+
+		/*
+		 * the ray enters an edge at its endpoint that is first in the
+		 * clockwise turn, the edges entered before the upward direction
+		 * and not left are crossed by the first ray
+		 */
+		for(std::size_t e=0; e<n; e++){
+			direction d = turn(m_p, m_points[e], m_points[m_next[e]]);
+
+			if(d == ON)
+				continue;
+
+			m_blocks[e] = true;
+			m_side[e] = d;
+			m_enter[e] = (d == LEFT) ? m_next[e] : e;
+
+			/*
+			 * an edge in one half of the turn is entered first, only
+			 * an edge that goes from the first half to the second one
+			 * crosses the upward direction
+			 */
+			if(half(m_points[leave(e)]) < half(m_points[m_enter[e]]))
+				insert(e);
+		}
+
+		sort_vertices();
+
+		for(std::size_t g=0; g<m_order.size();){
+			const point<T, 2>& q = m_points[m_order[g]];
+
+			std::size_t end = g + 1;
+			while(end < m_order.size() && close_keys(m_keys[g], m_keys[end])
+				&& same_ray(q, m_points[m_order[end]]))
+				end++;
+
+			m_n_rays++;
+			for(std::size_t k=g; k<end; k++)
+				m_ray[m_order[k]] = m_n_rays;
+
+			/*
+			 * the nearest point before the vertices of the ray, then the
+			 * edges they end and start, and the nearest point after them
+			 */
+			auto first = m_status.first();
+			std::size_t nearest = npos;
+			if(first != m_status.npos){
+				nearest = m_status[first];
+				visibility.push_back(hit(nearest, q));
+			}
+
+			for(std::size_t k=g; k<end; k++){
+				std::size_t v = m_order[k];
+
+				/*
+				 * the ray leaves an edge and enters the next one at a
+				 * vertex alone on its ray, the edges do not cross the
+				 * others, so the next one takes its place
+				 */
+				if(end == g + 1 && passes(v)){
+					std::size_t e = (leave(v) == v) ? v : m_prev[v];
+					std::size_t f = (e == v) ? m_prev[v] : v;
+
+					m_status[m_node[e]] = f;
+					m_node[f] = m_node[e];
+					m_node[e] = m_status.npos;
+					continue;
+				}
+
+				for(std::size_t e : { m_prev[v], v }){
+					if(m_blocks[e] && leave(e) == v && m_node[e] != m_status.npos){
+						m_status.erase(m_node[e]);
+						m_node[e] = m_status.npos;
+					}
+				}
+			}
+
+			for(std::size_t k=g; k<end; k++){
+				std::size_t v = m_order[k];
+				std::size_t placed = npos;
+
+				/*
+				 * the two edges entered at a vertex alone on its ray
+				 * are next to each other
+				 */
+				for(std::size_t e : { m_prev[v], v }){
+					if(m_blocks[e] && m_enter[e] == v && m_node[e] == m_status.npos){
+						if(end == g + 1 && placed != npos)
+							insert_beside(e, placed);
+						else
+							insert_at(e, v);
+
+						placed = e;
+					}
+				}
+			}
+
+			/*
+			 * the same nearest edge gives the same point
+			 */
+			first = m_status.first();
+			if(first != m_status.npos && m_status[first] != nearest){
+				point<T, 2> after = hit(m_status[first], q);
+
+				if(visibility.empty() || !(visibility.back() == after))
+					visibility.push_back(after);
+			}
+
+			g = end;
+		}
+	}
+};
+
+/**
+  * Visibility polygon of the point `p` among the rings of `poly_list` by
+  * a rotational sweep in O(n lg n) time, with the output of
+  * `polygon_visibility`.
+  *
+  * @see visibility_sweep
+  */
+template <typename T>
+polygon<T, 2> polygon_visibility_sweep(
+	const point<T, 2>& p,
+	const std::vector<polygon<T, 2>>& poly_list)
+{
+	return visibility_sweep<T>().compute(p, poly_list);
+}
+
+/*
+ * every ring of the set, boundaries and holes, blocks the visibility
+ */
+template <typename T>
+polygon<T, 2> polygon_visibility_sweep(
+	const point<T, 2>& p,
+	const polygon_set_view<T, 2>& set)
+{
+	return visibility_sweep<T>().compute(p, set.rings());
+}
+
+template <typename T>
+polygon<T, 2> polygon_visibility_sweep(
+	const point<T, 2>& p,
+	const polygon_set<T, 2>& set)
+{
+	return polygon_visibility_sweep(p, set.view());
+}
+
 }
@@ -0,0 +1,1175 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/algorithm/direction.hpp>
+#include <gmt/algorithm/batch-direction.hpp>
+
+namespace gmt {
+
+/**
+  * Counter of the evaluations of the robust predicates of one call site,
+  * i.e., how many times the predicates were called and how many times
+  * the floating-point filter was inconclusive and the exact arithmetic
+  * was needed.
+  *
+  * The counters are created by the `GMT_PREDICATE_SITE` macro and only
+  * count when `GMT_PREDICATE_STATS` is defined.
+  */
+class predicate_counter {
+public:
+	explicit predicate_counter(const char* site);
+
+	const char* site() const noexcept
+	{
+		return m_site;
+	}
+
+	std::uint64_t calls() const noexcept
+	{
+		return m_calls.load(std::memory_order_relaxed);
+	}
+
+	std::uint64_t slow_calls() const noexcept
+	{
+		return m_slow.load(std::memory_order_relaxed);
+	}
+
+	void count(std::uint64_t calls, std::uint64_t slow) noexcept
+	{
+		m_calls.fetch_add(calls, std::memory_order_relaxed);
+		m_slow.fetch_add(slow, std::memory_order_relaxed);
+	}
+
+	void reset() noexcept
+	{
+		m_calls.store(0, std::memory_order_relaxed);
+		m_slow.store(0, std::memory_order_relaxed);
+	}
+
+private:
+	const char* m_site;
+	std::atomic<std::uint64_t> m_calls;
+	std::atomic<std::uint64_t> m_slow;
+};
+
+/*
+ * every counter ever created, they live until the end of the program
+ */
+inline std::vector<predicate_counter*>& predicate_counters()
+{
+	static std::vector<predicate_counter*> counters;
+	return counters;
+}
+
+inline std::mutex& predicate_counters_mutex()
+{
+	static std::mutex m;
+	return m;
+}
+
+inline predicate_counter::predicate_counter(const char* site)
+	: m_site(site), m_calls(0), m_slow(0)
+{
+	std::lock_guard<std::mutex> lock(predicate_counters_mutex());
+	predicate_counters().push_back(this);
+}
+
+/**
+  * Writes to `o` one line per call site with the number of calls, the
+  * number of calls that took the exact path and its percentage. The
+  * counters of the sites with the same name are summed.
+  */
+inline void print_predicate_stats(std::ostream& o)
+{
+	std::map<std::string, std::pair<std::uint64_t, std::uint64_t>> sites;
+
+	{
+		std::lock_guard<std::mutex> lock(predicate_counters_mutex());
+		for(auto c : predicate_counters()){
+			auto& s = sites[c->site()];
+			s.first += c->calls();
+			s.second += c->slow_calls();
+		}
+	}
+
+	for(auto& s : sites){
+		double ratio = s.second.first
+			? 100.0*s.second.second/s.second.first
+			: 0.0;
+
+		o << s.first << ": " << s.second.first << " calls, "
+		  << s.second.second << " exact (" << ratio << "%)\n";
+	}
+}
+
+inline void reset_predicate_stats()
+{
+	std::lock_guard<std::mutex> lock(predicate_counters_mutex());
+	for(auto c : predicate_counters())
+		c->reset();
+}
+
+/**
+  * `GMT_PREDICATE_SITE("name")` evaluates to a pointer to the counter of
+  * the call site where it is written, or to `nullptr` when
+  * `GMT_PREDICATE_STATS` is not defined, so counting costs nothing in
+  * regular builds.
+  */
+#ifdef GMT_PREDICATE_STATS
+#define GMT_PREDICATE_SITE(name) \
+	([]() -> gmt::predicate_counter* { \
+		static gmt::predicate_counter counter(name); \
+		return &counter; \
+	}())
+#else
+#define GMT_PREDICATE_SITE(name) \
+	(static_cast<gmt::predicate_counter*>(nullptr))
+#endif
+
+/*
+ * Shewchuk's adaptive precision floating-point arithmetic.
+ *
+ * An expansion is a sum of doubles stored from the smallest to the
+ * largest magnitude whose components do not overlap, so its sign is the
+ * sign of the last component. The functions assume round-to-nearest
+ * IEEE 754 double arithmetic without extended precision.
+ */
+namespace exact {
+
+/*
+ * half of the machine epsilon, the largest relative rounding error
+ */
+constexpr double epsilon = std::numeric_limits<double>::epsilon()/2.0;
+
+/*
+ * 2^ceil(53/2) + 1, splits a double in two halves of 26 bits
+ */
+constexpr double splitter = 134217729.0;
+
+constexpr double result_error_bound = (3.0 + 8.0*epsilon)*epsilon;
+constexpr double ccw_error_bound_a = (3.0 + 16.0*epsilon)*epsilon;
+constexpr double ccw_error_bound_b = (2.0 + 12.0*epsilon)*epsilon;
+constexpr double ccw_error_bound_c = (9.0 + 64.0*epsilon)*epsilon*epsilon;
+constexpr double icc_error_bound_a = (10.0 + 96.0*epsilon)*epsilon;
+constexpr double o3d_error_bound_a = (7.0 + 56.0*epsilon)*epsilon;
+
+/*
+ * x + y == a + b exactly, x is the rounded sum
+ */
+inline void two_sum(double a, double b, double& x, double& y)
+{
+	x = a + b;
+	double bvirt = x - a;
+	double avirt = x - bvirt;
+	double bround = b - bvirt;
+	double around = a - avirt;
+	y = around + bround;
+}
+
+/*
+ * two_sum when |a| >= |b|
+ */
+inline void fast_two_sum(double a, double b, double& x, double& y)
+{
+	x = a + b;
+	double bvirt = x - a;
+	y = b - bvirt;
+}
+
+/*
+ * rounding error of x = a - b
+ */
+inline double two_diff_tail(double a, double b, double x)
+{
+	double bvirt = a - x;
+	double avirt = x + bvirt;
+	double bround = bvirt - b;
+	double around = a - avirt;
+	return around + bround;
+}
+
+/*
+ * x + y == a - b exactly, x is the rounded difference
+ */
+inline void two_diff(double a, double b, double& x, double& y)
+{
+	x = a - b;
+	y = two_diff_tail(a, b, x);
+}
+
+inline void split(double a, double& hi, double& lo)
+{
+	double c = splitter*a;
+	double abig = c - a;
+	hi = c - abig;
+	lo = a - hi;
+}
+
+/*
+ * x + y == a*b exactly, x is the rounded product
+ */
+inline void two_product(double a, double b, double& x, double& y)
+{
+	x = a*b;
+
+#ifdef __FP_FAST_FMA
+	/*
+	 * the fused multiply-add is exact and immune to contraction
+	 */
+	y = std::fma(a, b, -x);
+#else
+	double ahi, alo, bhi, blo;
+	split(a, ahi, alo);
+	split(b, bhi, blo);
+
+	double err1 = x - ahi*bhi;
+	double err2 = err1 - alo*bhi;
+	double err3 = err2 - ahi*blo;
+	y = alo*blo - err3;
+#endif
+}
+
+/*
+ * x[3] + x[2] + x[1] + x[0] == (a1 + a0) - (b1 + b0) exactly
+ */
+inline void two_two_diff(
+	double a1,
+	double a0,
+	double b1,
+	double b0,
+	double* x)
+{
+	double i, j, k;
+
+	two_diff(a0, b0, i, x[0]);
+	two_sum(a1, i, j, k);
+	two_diff(k, b1, i, x[1]);
+	two_sum(j, i, x[3], x[2]);
+}
+
+/*
+ * h = e + f, the zero components are eliminated
+ *
+ * @return the length of h, at least one
+ */
+inline std::size_t expansion_sum(
+	std::size_t elen,
+	const double* e,
+	std::size_t flen,
+	const double* f,
+	double* h)
+{
+	double q, qnew, hh;
+	std::size_t eindex = 0, findex = 0, hindex = 0;
+	double enow = e[0];
+	double fnow = f[0];
+
+	auto next_e = [&](){ enow = (++eindex < elen) ? e[eindex] : 0.0; };
+	auto next_f = [&](){ fnow = (++findex < flen) ? f[findex] : 0.0; };
+
+	if((fnow > enow) == (fnow > -enow)){
+		q = enow;
+		next_e();
+	}else{
+		q = fnow;
+		next_f();
+	}
+
+	if(eindex < elen && findex < flen){
+		if((fnow > enow) == (fnow > -enow)){
+			fast_two_sum(enow, q, qnew, hh);
+			next_e();
+		}else{
+			fast_two_sum(fnow, q, qnew, hh);
+			next_f();
+		}
+
+		q = qnew;
+		if(hh != 0.0)
+			h[hindex++] = hh;
+
+		while(eindex < elen && findex < flen){
+			if((fnow > enow) == (fnow > -enow)){
+				two_sum(q, enow, qnew, hh);
+				next_e();
+			}else{
+				two_sum(q, fnow, qnew, hh);
+				next_f();
+			}
+
+			q = qnew;
+			if(hh != 0.0)
+				h[hindex++] = hh;
+		}
+	}
+
+	while(eindex < elen){
+		two_sum(q, enow, qnew, hh);
+		next_e();
+		q = qnew;
+		if(hh != 0.0)
+			h[hindex++] = hh;
+	}
+
+	while(findex < flen){
+		two_sum(q, fnow, qnew, hh);
+		next_f();
+		q = qnew;
+		if(hh != 0.0)
+			h[hindex++] = hh;
+	}
+
+	if(q != 0.0 || hindex == 0)
+		h[hindex++] = q;
+
+	return hindex;
+}
+
+/*
+ * h = b*e, the zero components are eliminated
+ *
+ * @return the length of h, at least one, at most 2*elen
+ */
+inline std::size_t scale_expansion(
+	std::size_t elen,
+	const double* e,
+	double b,
+	double* h)
+{
+	double q, hh, product1, product0, sum;
+	std::size_t hindex = 0;
+
+	two_product(e[0], b, q, hh);
+	if(hh != 0.0)
+		h[hindex++] = hh;
+
+	for(std::size_t i=1; i<elen; i++){
+		two_product(e[i], b, product1, product0);
+		two_sum(q, product0, sum, hh);
+		if(hh != 0.0)
+			h[hindex++] = hh;
+
+		fast_two_sum(product1, sum, q, hh);
+		if(hh != 0.0)
+			h[hindex++] = hh;
+	}
+
+	if(q != 0.0 || hindex == 0)
+		h[hindex++] = q;
+
+	return hindex;
+}
+
+/*
+ * h = e*f, `scratch` must hold 4*elen*flen doubles and h 2*elen*flen
+ *
+ * @return the length of h
+ */
+inline std::size_t expansion_product(
+	std::size_t elen,
+	const double* e,
+	std::size_t flen,
+	const double* f,
+	double* h,
+	double* scratch)
+{
+	double* term = scratch;
+	double* sum = scratch + 2*elen;
+
+	std::size_t hlen = scale_expansion(elen, e, f[0], h);
+
+	for(std::size_t i=1; i<flen; i++){
+		std::size_t tlen = scale_expansion(elen, e, f[i], term);
+		std::size_t slen = expansion_sum(hlen, h, tlen, term, sum);
+
+		std::copy(sum, sum + slen, h);
+		hlen = slen;
+	}
+
+	return hlen;
+}
+
+inline void negate(std::size_t elen, double* e)
+{
+	for(std::size_t i=0; i<elen; i++)
+		e[i] = -e[i];
+}
+
+/*
+ * approximation of the value of the expansion
+ */
+inline double estimate(std::size_t elen, const double* e)
+{
+	double q = e[0];
+
+	for(std::size_t i=1; i<elen; i++)
+		q += e[i];
+
+	return q;
+}
+
+/*
+ * the adaptive stages of orient2d, run when the filter fails
+ */
+inline double orient2d_adapt(
+	const point2d& a,
+	const point2d& b,
+	const point2d& c,
+	double detsum)
+{
+	double acx = a.x() - c.x();
+	double bcx = b.x() - c.x();
+	double acy = a.y() - c.y();
+	double bcy = b.y() - c.y();
+
+	double detleft, detlefttail, detright, detrighttail;
+	two_product(acx, bcy, detleft, detlefttail);
+	two_product(acy, bcx, detright, detrighttail);
+
+	double B[4];
+	two_two_diff(detleft, detlefttail, detright, detrighttail, B);
+
+	double det = estimate(4, B);
+	double errbound = ccw_error_bound_b*detsum;
+	if(det >= errbound || -det >= errbound)
+		return det;
+
+	double acxtail = two_diff_tail(a.x(), c.x(), acx);
+	double bcxtail = two_diff_tail(b.x(), c.x(), bcx);
+	double acytail = two_diff_tail(a.y(), c.y(), acy);
+	double bcytail = two_diff_tail(b.y(), c.y(), bcy);
+
+	if(acxtail == 0.0 && acytail == 0.0
+		&& bcxtail == 0.0 && bcytail == 0.0)
+		return det;
+
+	errbound = ccw_error_bound_c*detsum + result_error_bound*std::fabs(det);
+	det += (acx*bcytail + bcy*acxtail) - (acy*bcxtail + bcx*acytail);
+	if(det >= errbound || -det >= errbound)
+		return det;
+
+	double s1, s0, t1, t0, u[4];
+	double C1[8], C2[12], D[16];
+
+	two_product(acxtail, bcy, s1, s0);
+	two_product(acytail, bcx, t1, t0);
+	two_two_diff(s1, s0, t1, t0, u);
+	std::size_t c1len = expansion_sum(4, B, 4, u, C1);
+
+	two_product(acx, bcytail, s1, s0);
+	two_product(acy, bcxtail, t1, t0);
+	two_two_diff(s1, s0, t1, t0, u);
+	std::size_t c2len = expansion_sum(c1len, C1, 4, u, C2);
+
+	two_product(acxtail, bcytail, s1, s0);
+	two_product(acytail, bcxtail, t1, t0);
+	two_two_diff(s1, s0, t1, t0, u);
+	std::size_t dlen = expansion_sum(c2len, C2, 4, u, D);
+
+	return D[dlen - 1];
+}
+
+/*
+ * orient2d with the filter, `slow` tells whether the adaptive stages ran
+ */
+inline double orient2d(
+	const point2d& a,
+	const point2d& b,
+	const point2d& c,
+	bool& slow)
+{
+	double detleft = (a.x() - c.x())*(b.y() - c.y());
+	double detright = (a.y() - c.y())*(b.x() - c.x());
+	double det = detleft - detright;
+	double detsum;
+
+	slow = false;
+
+	if(detleft > 0.0){
+		if(detright <= 0.0)
+			return det;
+		detsum = detleft + detright;
+	}else if(detleft < 0.0){
+		if(detright >= 0.0)
+			return det;
+		detsum = -detleft - detright;
+	}else{
+		return det;
+	}
+
+	double errbound = ccw_error_bound_a*detsum;
+	if(det >= errbound || -det >= errbound)
+		return det;
+
+	slow = true;
+	return orient2d_adapt(a, b, c, detsum);
+}
+
+/*
+ * the in-circle determinant evaluated with expansions, the differences
+ * to `d` are kept exact as two component expansions
+ */
+inline double incircle_exact(
+	const point2d& a,
+	const point2d& b,
+	const point2d& c,
+	const point2d& d)
+{
+	double adx[2], ady[2], bdx[2], bdy[2], cdx[2], cdy[2];
+
+	two_diff(a.x(), d.x(), adx[1], adx[0]);
+	two_diff(a.y(), d.y(), ady[1], ady[0]);
+	two_diff(b.x(), d.x(), bdx[1], bdx[0]);
+	two_diff(b.y(), d.y(), bdy[1], bdy[0]);
+	two_diff(c.x(), d.x(), cdx[1], cdx[0]);
+	two_diff(c.y(), d.y(), cdy[1], cdy[0]);
+
+	double scratch[4*16*16];
+
+	/*
+	 * lift*(ux*vy - vx*uy) for the three rows of the determinant
+	 */
+	auto term = [&](
+		const double* px, const double* py,
+		const double* ux, const double* uy,
+		const double* vx, const double* vy,
+		double* out) -> std::size_t
+	{
+		double xx[8], yy[8], lift[16];
+		double m0[8], m1[8], cofactor[16];
+
+		std::size_t xxlen = expansion_product(2, px, 2, px, xx, scratch);
+		std::size_t yylen = expansion_product(2, py, 2, py, yy, scratch);
+		std::size_t liftlen = expansion_sum(xxlen, xx, yylen, yy, lift);
+
+		std::size_t m0len = expansion_product(2, ux, 2, vy, m0, scratch);
+		std::size_t m1len = expansion_product(2, vx, 2, uy, m1, scratch);
+		negate(m1len, m1);
+		std::size_t cofactorlen = expansion_sum(
+			m0len, m0, m1len, m1, cofactor);
+
+		return expansion_product(
+			liftlen, lift,
+			cofactorlen, cofactor,
+			out, scratch);
+	};
+
+	double at[512], bt[512], ct[512];
+	double abt[1024], det[1536];
+
+	std::size_t alen = term(adx, ady, bdx, bdy, cdx, cdy, at);
+	std::size_t blen = term(bdx, bdy, cdx, cdy, adx, ady, bt);
+	std::size_t clen = term(cdx, cdy, adx, ady, bdx, bdy, ct);
+
+	std::size_t ablen = expansion_sum(alen, at, blen, bt, abt);
+	std::size_t detlen = expansion_sum(ablen, abt, clen, ct, det);
+
+	return det[detlen - 1];
+}
+
+/*
+ * incircle with the filter, `slow` tells whether the exact evaluation ran
+ */
+inline double incircle(
+	const point2d& a,
+	const point2d& b,
+	const point2d& c,
+	const point2d& d,
+	bool& slow)
+{
+	double adx = a.x() - d.x();
+	double bdx = b.x() - d.x();
+	double cdx = c.x() - d.x();
+	double ady = a.y() - d.y();
+	double bdy = b.y() - d.y();
+	double cdy = c.y() - d.y();
+
+	double bdxcdy = bdx*cdy;
+	double cdxbdy = cdx*bdy;
+	double alift = adx*adx + ady*ady;
+
+	double cdxady = cdx*ady;
+	double adxcdy = adx*cdy;
+	double blift = bdx*bdx + bdy*bdy;
+
+	double adxbdy = adx*bdy;
+	double bdxady = bdx*ady;
+	double clift = cdx*cdx + cdy*cdy;
+
+	double det = alift*(bdxcdy - cdxbdy)
+		+ blift*(cdxady - adxcdy)
+		+ clift*(adxbdy - bdxady);
+
+	double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy))*alift
+		+ (std::fabs(cdxady) + std::fabs(adxcdy))*blift
+		+ (std::fabs(adxbdy) + std::fabs(bdxady))*clift;
+
+	double errbound = icc_error_bound_a*permanent;
+
+	slow = false;
+	if(det > errbound || -det > errbound)
+		return det;
+
+	slow = true;
+	return incircle_exact(a, b, c, d);
+}
+
+/*
+ * the orientation determinant of four points evaluated with expansions,
+ * the differences to `d` are kept exact as two component expansions
+ */
+inline double orient3d_exact(
+	const point3d& a,
+	const point3d& b,
+	const point3d& c,
+	const point3d& d)
+{
+	double adx[2], ady[2], adz[2], bdx[2], bdy[2], bdz[2];
+	double cdx[2], cdy[2], cdz[2];
+
+	two_diff(a.x(), d.x(), adx[1], adx[0]);
+	two_diff(a.y(), d.y(), ady[1], ady[0]);
+	two_diff(a.z(), d.z(), adz[1], adz[0]);
+	two_diff(b.x(), d.x(), bdx[1], bdx[0]);
+	two_diff(b.y(), d.y(), bdy[1], bdy[0]);
+	two_diff(b.z(), d.z(), bdz[1], bdz[0]);
+	two_diff(c.x(), d.x(), cdx[1], cdx[0]);
+	two_diff(c.y(), d.y(), cdy[1], cdy[0]);
+	two_diff(c.z(), d.z(), cdz[1], cdz[0]);
+
+	double scratch[4*2*16];
+
+	/*
+	 * pz*(ux*vy - vx*uy) for the three rows of the determinant
+	 */
+	auto term = [&](
+		const double* pz,
+		const double* ux, const double* uy,
+		const double* vx, const double* vy,
+		double* out) -> std::size_t
+	{
+		double m0[8], m1[8], cofactor[16];
+
+		std::size_t m0len = expansion_product(2, ux, 2, vy, m0, scratch);
+		std::size_t m1len = expansion_product(2, vx, 2, uy, m1, scratch);
+		negate(m1len, m1);
+		std::size_t cofactorlen = expansion_sum(
+			m0len, m0, m1len, m1, cofactor);
+
+		return expansion_product(2, pz, cofactorlen, cofactor, out, scratch);
+	};
+
+	double at[64], bt[64], ct[64];
+	double abt[128], det[192];
+
+	std::size_t alen = term(adz, bdx, bdy, cdx, cdy, at);
+	std::size_t blen = term(bdz, cdx, cdy, adx, ady, bt);
+	std::size_t clen = term(cdz, adx, ady, bdx, bdy, ct);
+
+	std::size_t ablen = expansion_sum(alen, at, blen, bt, abt);
+	std::size_t detlen = expansion_sum(ablen, abt, clen, ct, det);
+
+	return det[detlen - 1];
+}
+
+/*
+ * orient3d with the filter, `slow` tells whether the exact evaluation ran
+ */
+inline double orient3d(
+	const point3d& a,
+	const point3d& b,
+	const point3d& c,
+	const point3d& d,
+	bool& slow)
+{
+	double adx = a.x() - d.x();
+	double bdx = b.x() - d.x();
+	double cdx = c.x() - d.x();
+	double ady = a.y() - d.y();
+	double bdy = b.y() - d.y();
+	double cdy = c.y() - d.y();
+	double adz = a.z() - d.z();
+	double bdz = b.z() - d.z();
+	double cdz = c.z() - d.z();
+
+	double bdxcdy = bdx*cdy;
+	double cdxbdy = cdx*bdy;
+
+	double cdxady = cdx*ady;
+	double adxcdy = adx*cdy;
+
+	double adxbdy = adx*bdy;
+	double bdxady = bdx*ady;
+
+	double det = adz*(bdxcdy - cdxbdy)
+		+ bdz*(cdxady - adxcdy)
+		+ cdz*(adxbdy - bdxady);
+
+	double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy))*std::fabs(adz)
+		+ (std::fabs(cdxady) + std::fabs(adxcdy))*std::fabs(bdz)
+		+ (std::fabs(adxbdy) + std::fabs(bdxady))*std::fabs(cdz);
+
+	double errbound = o3d_error_bound_a*permanent;
+
+	slow = false;
+	if(det > errbound || -det > errbound)
+		return det;
+
+	slow = true;
+	return orient3d_exact(a, b, c, d);
+}
+
+inline direction to_direction(double det)
+{
+	if(det > 0.0)
+		return LEFT;
+	else if(det < 0.0)
+		return RIGHT;
+	else
+		return ON;
+}
+
+}
+
+/**
+  * Robust orientation test. Its sign is the sign of the exact value of
+  * `(b - a) x (c - a)`, i.e., positive if `a`, `b` and `c` are in
+  * counterclockwise order, negative if they are in clockwise order and
+  * zero if they are collinear. The value is an approximation of the
+  * determinant.
+  *
+  * A floating-point filter decides almost every call; only when the
+  * result is too close to zero the determinant is evaluated adaptively
+  * with expansion arithmetic.
+  *
+  * @param site	counter of the call site, see GMT_PREDICATE_SITE
+  */
+inline double orient2d(
+	const point2d& a,
+	const point2d& b,
+	const point2d& c,
+	predicate_counter* site = nullptr)
+{
+	bool slow;
+	double det = exact::orient2d(a, b, c, slow);
+
+#ifdef GMT_PREDICATE_STATS
+	if(site)
+		site->count(1, slow);
+#else
+	(void) site;
+#endif
+
+	return det;
+}
+
+/**
+  * Robust in-circle test. Its sign is the sign of the exact value of the
+  * in-circle determinant, i.e., positive if `d` is inside the circle
+  * through `a`, `b` and `c`, negative if it is outside and zero if the
+  * four points are cocircular. `a`, `b` and `c` must be in
+  * counterclockwise order, otherwise the sign is reversed.
+  *
+  * @param site	counter of the call site, see GMT_PREDICATE_SITE
+  */
+inline double incircle(
+	const point2d& a,
+	const point2d& b,
+	const point2d& c,
+	const point2d& d,
+	predicate_counter* site = nullptr)
+{
+	bool slow;
+	double det = exact::incircle(a, b, c, d, slow);
+
+#ifdef GMT_PREDICATE_STATS
+	if(site)
+		site->count(1, slow);
+#else
+	(void) site;
+#endif
+
+	return det;
+}
+
+/**
+  * Robust 3D orientation test. Its sign is the sign of the exact value of
+  * the determinant of `a - d`, `b - d` and `c - d`, i.e., positive if `d`
+  * is below the plane through `a`, `b` and `c`, taking as above the side
+  * from which they appear in counterclockwise order, negative if it is
+  * above and zero if the four points are coplanar.
+  *
+  * @param site	counter of the call site, see GMT_PREDICATE_SITE
+  */
+inline double orient3d(
+	const point3d& a,
+	const point3d& b,
+	const point3d& c,
+	const point3d& d,
+	predicate_counter* site = nullptr)
+{
+	bool slow;
+	double det = exact::orient3d(a, b, c, d, slow);
+
+#ifdef GMT_PREDICATE_STATS
+	if(site)
+		site->count(1, slow);
+#else
+	(void) site;
+#endif
+
+	return det;
+}
+
+/**
+  * Exact version of `direction_in`: the direction of the point `p2` in
+  * reference of the segment of `p0` and `p1`. Integer coordinates are
+  * already exact in `direction_in`, the floating-point ones go through
+  * `orient2d`.
+  *
+  * @see orient2d
+  */
+template<typename T>
+direction robust_direction_in(
+	const point<T, 2>& p0,
+	const point<T, 2>& p1,
+	const point<T, 2>& p2,
+	predicate_counter* site = nullptr)
+{
+	if constexpr(std::is_integral<T>::value){
+		(void) site;
+		return direction_in(p0, p1, p2);
+	}else if constexpr(std::is_same<T, double>::value){
+		return exact::to_direction(orient2d(p0, p1, p2, site));
+	}else{
+		return robust_direction_in(
+			point2d{ double(p0.x()), double(p0.y()) },
+			point2d{ double(p1.x()), double(p1.y()) },
+			point2d{ double(p2.x()), double(p2.y()) },
+			site);
+	}
+}
+
+/**
+  * Set of predicates with the exact answers of `robust_direction_in` and
+  * `incircle`. The batch functions run the vectorized direction kernel as
+  * the floating-point filter and evaluate exactly the lanes it cannot
+  * decide.
+  *
+  * The algorithms that take a predicate set call `orientation`,
+  * `in_circle` and the batch functions below, see `epsilon_predicates`
+  * for the other implementation.
+  */
+class robust_predicates {
+public:
+	/**
+	  * @param site	counter of the call site, see GMT_PREDICATE_SITE
+	  */
+	explicit robust_predicates(predicate_counter* site = nullptr) noexcept
+		: site(site)
+	{}
+
+	direction orientation(
+		const point2d& p0,
+		const point2d& p1,
+		const point2d& p2) const
+	{
+		return robust_direction_in(p0, p1, p2, site);
+	}
+
+	/**
+	  * @return positive if `d` is inside the circle through the
+	  *	   counterclockwise points `a`, `b` and `c`, negative if it is
+	  *	   outside and zero if it is on the circle
+	  */
+	double in_circle(
+		const point2d& a,
+		const point2d& b,
+		const point2d& c,
+		const point2d& d) const
+	{
+		return incircle(a, b, c, d, site);
+	}
+
+	/**
+	  * direction of every point of `points` in reference of the segment
+	  * of `p0` and `p1`
+	  */
+	void orientation_batch(
+		const point2d& p0,
+		const point2d& p1,
+		const point2d* points,
+		std::size_t n,
+		packed_direction* out) const
+	{
+		direction_batch(
+			p0,
+			p1,
+			points,
+			n,
+			out,
+			0.0,
+			exact::ccw_error_bound_a);
+
+		record(n, resolve_on(out, n, [&](std::size_t i, std::uint64_t& slow){
+			return resolve(p0, p1, points[i], slow);
+		}));
+	}
+
+	void orientation_batch(
+		const point2d& p0,
+		const point2d& p1,
+		const point_buffer2d& points,
+		packed_direction* out) const
+	{
+		orientation_batch(p0, p1, points.x(), points.y(), points.size(), out);
+	}
+
+	/**
+	  * direction of the points of the columns `x` and `y` in reference
+	  * of the segment of `p0` and `p1`
+	  */
+	void orientation_batch(
+		const point2d& p0,
+		const point2d& p1,
+		const double* x,
+		const double* y,
+		std::size_t n,
+		packed_direction* out) const
+	{
+		direction_batch(
+			p0,
+			p1,
+			x,
+			y,
+			n,
+			out,
+			0.0,
+			exact::ccw_error_bound_a);
+
+		record(n, resolve_on(out, n, [&](std::size_t i, std::uint64_t& slow){
+			return resolve(p0, p1, point2d{ x[i], y[i] }, slow);
+		}));
+	}
+
+	/**
+	  * direction of `p` in reference of the edges `first` to
+	  * `first + count - 1` of the closed chain `ring` of `n` vertices
+	  *
+	  * @see ring_direction_batch
+	  */
+	void ring_orientation_batch(
+		const point2d* ring,
+		std::size_t n,
+		std::size_t first,
+		std::size_t count,
+		const point2d& p,
+		packed_direction* out) const
+	{
+		ring_direction_batch(
+			ring,
+			n,
+			first,
+			count,
+			p,
+			out,
+			0.0,
+			exact::ccw_error_bound_a);
+
+		record(count, resolve_on(out, count, [&](std::size_t k, std::uint64_t& slow){
+			std::size_t i = first + k;
+			if(i >= n)
+				i -= n;
+
+			std::size_t j = (i + 1 == n) ? 0 : i + 1;
+			return resolve(ring[i], ring[j], p, slow);
+		}));
+	}
+
+	void ring_orientation_batch(
+		const point_buffer2d& ring,
+		std::size_t first,
+		std::size_t count,
+		const point2d& p,
+		packed_direction* out) const
+	{
+		ring_direction_batch(
+			ring,
+			first,
+			count,
+			p,
+			out,
+			0.0,
+			exact::ccw_error_bound_a);
+
+		record(count, resolve_on(out, count, [&](std::size_t k, std::uint64_t& slow){
+			std::size_t i = first + k;
+			if(i >= ring.size())
+				i -= ring.size();
+
+			std::size_t j = (i + 1 == ring.size()) ? 0 : i + 1;
+			return resolve(ring[i], ring[j], p, slow);
+		}));
+	}
+
+private:
+	predicate_counter* site;
+
+	/*
+	 * evaluates exactly the lanes the floating-point filter left ON,
+	 * they are rare, so they are searched with memchr instead of a test
+	 * per lane
+	 *
+	 * @return the number of lanes that needed the exact arithmetic
+	 */
+	template<typename resolver>
+	static std::uint64_t resolve_on(
+		packed_direction* out,
+		std::size_t n,
+		const resolver& r)
+	{
+		std::uint64_t slow = 0;
+		packed_direction* last = out + n;
+
+		for(void* i = std::memchr(out, ON, n);
+			i != nullptr;
+			i = std::memchr(static_cast<packed_direction*>(i) + 1, ON,
+				last - static_cast<packed_direction*>(i) - 1)){
+			packed_direction* lane = static_cast<packed_direction*>(i);
+			*lane = r(std::size_t(lane - out), slow);
+		}
+
+		return slow;
+	}
+
+	static packed_direction resolve(
+		const point2d& p0,
+		const point2d& p1,
+		const point2d& p2,
+		std::uint64_t& slow)
+	{
+		bool s;
+		double det = exact::orient2d(p0, p1, p2, s);
+		slow += s;
+		return exact::to_direction(det);
+	}
+
+	void record(std::uint64_t calls, std::uint64_t slow) const noexcept
+	{
+#ifdef GMT_PREDICATE_STATS
+		if(site)
+			site->count(calls, slow);
+#else
+		(void) calls;
+		(void) slow;
+#endif
+	}
+};
+
+/**
+  * Set of predicates with the floating-point answers of `direction_in`,
+  * the results whose absolute value is not greater than `e` are zero.
+  *
+  * @see robust_predicates
+  */
+class epsilon_predicates {
+public:
+	explicit epsilon_predicates(double e = 0.0) noexcept
+		: e(e)
+	{}
+
+	direction orientation(
+		const point2d& p0,
+		const point2d& p1,
+		const point2d& p2) const
+	{
+		return direction_in(p0, p1, p2, e);
+	}
+
+	double in_circle(
+		const point2d& a,
+		const point2d& b,
+		const point2d& c,
+		const point2d& d) const
+	{
+		vec2d ad(d, a), bd(d, b), cd(d, c);
+
+		double det = ad.norm_squared()*signed_parallelogram_area(bd, cd)
+			+ bd.norm_squared()*signed_parallelogram_area(cd, ad)
+			+ cd.norm_squared()*signed_parallelogram_area(ad, bd);
+
+		if(std::fabs(det) <= e)
+			return 0.0;
+
+		return det;
+	}
+
+	void orientation_batch(
+		const point2d& p0,
+		const point2d& p1,
+		const point2d* points,
+		std::size_t n,
+		packed_direction* out) const
+	{
+		direction_batch(p0, p1, points, n, out, e);
+	}
+
+	void orientation_batch(
+		const point2d& p0,
+		const point2d& p1,
+		const point_buffer2d& points,
+		packed_direction* out) const
+	{
+		direction_batch(p0, p1, points, out, e);
+	}
+
+	void orientation_batch(
+		const point2d& p0,
+		const point2d& p1,
+		const double* x,
+		const double* y,
+		std::size_t n,
+		packed_direction* out) const
+	{
+		direction_batch(p0, p1, x, y, n, out, e);
+	}
+
+	void ring_orientation_batch(
+		const point2d* ring,
+		std::size_t n,
+		std::size_t first,
+		std::size_t count,
+		const point2d& p,
+		packed_direction* out) const
+	{
+		ring_direction_batch(ring, n, first, count, p, out, e);
+	}
+
+	void ring_orientation_batch(
+		const point_buffer2d& ring,
+		std::size_t first,
+		std::size_t count,
+		const point2d& p,
+		packed_direction* out) const
+	{
+		ring_direction_batch(ring, first, count, p, out, e);
+	}
+
+private:
+	double e;
+};
+
+}
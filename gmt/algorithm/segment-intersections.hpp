@@ -0,0 +1,633 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/segment.hpp>
+#include <gmt/sweep-tree.hpp>
+#include <gmt/algorithm/intersection.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+namespace gmt {
+
+/**
+  * Pair of segments that intersect, `first < second` are their positions
+  * in the input, and `type` is the one `intersect` gives to them.
+  */
+struct segment_pair {
+	std::size_t first;
+	std::size_t second;
+	intersection::type type;
+};
+
+/**
+  * Sweep of Bentley and Ottmann that finds every pair of intersecting
+  * segments in O((n + k) lg n) time, for n segments and k pairs.
+  *
+  * The line sweeps the plane from the left, the events are the
+  * endpoints, sorted once, and the crossings of the segments that are
+  * neighbours in the status, kept in a heap. Each point where segments
+  * end, start or touch is an event of all the segments through it, and
+  * the pairs among them are reported there: the ones that cross at an
+  * interior point are `intersection::PROPER`, and the ones that touch
+  * or overlap are `intersection::IMPROPER`. Collinear segments that
+  * overlap are reported once, at the start of the overlap.
+  *
+  * The orientations and the order of the events are exact. A crossing
+  * is kept with its rounded point and a bound of its error, which order
+  * it when they tell, and otherwise its exact point, a fraction of
+  * expansions, is compared. The status is a `sweep_tree`, and all the
+  * buffers are kept from a search to the next one.
+  */
+template<typename T>
+class segment_intersector {
+public:
+	/**
+	  * calls `report(i, j, type)` for each pair of intersecting segments,
+	  * with `i < j`. The pairs are found from the left, and none is kept,
+	  * so `report` may return `false` to stop the search.
+	  *
+	  * @return false if the search was stopped by `report`
+	  */
+	template<typename visitor>
+	bool find(const std::vector<segment<T, 2>>& segments, const visitor& report)
+	{
+		const std::size_t n = segments.size();
+
+		m_a.resize(n);
+		m_b.resize(n);
+		m_endpoints.clear();
+		m_endpoints.reserve(2*n);
+
+		for(std::size_t i=0; i<n; i++){
+			bool swap = less(segments[i].to, segments[i].from);
+
+			m_a[i] = swap ? segments[i].to : segments[i].from;
+			m_b[i] = swap ? segments[i].from : segments[i].to;
+			m_endpoints.push_back(endpoint{ m_a[i], i, true });
+			m_endpoints.push_back(endpoint{ m_b[i], i, false });
+		}
+
+		std::sort(m_endpoints.begin(), m_endpoints.end(),
+			[](const endpoint& e0, const endpoint& e1){
+				return less(e0.p, e1.p);
+			});
+
+		m_crossings.clear();
+		m_status.clear();
+		m_node.assign(n, m_status.npos);
+
+		std::size_t e = 0;
+		while(e < m_endpoints.size() || !m_crossings.empty()){
+			/*
+			 * the crossings go before the endpoints at the same point,
+			 * so a segment is not removed before its last crossing
+			 */
+			if(!m_crossings.empty()
+				&& (e == m_endpoints.size()
+					|| compare(m_crossings.front(), to_double(m_endpoints[e].p)) <= 0)){
+
+				if(!cross(report))
+					return false;
+
+				continue;
+			}
+
+			const point<T, 2> p = m_endpoints[e].p;
+
+			m_upper.clear();
+			m_ending.clear();
+
+			for(; e < m_endpoints.size() && m_endpoints[e].p == p; e++){
+				if(m_endpoints[e].start)
+					m_upper.push_back(m_endpoints[e].segment);
+				else
+					m_ending.push_back(m_endpoints[e].segment);
+			}
+
+			if(!meet(p, report))
+				return false;
+		}
+
+		return true;
+	}
+
+private:
+	typedef typename sweep_tree<std::size_t>::handle handle;
+
+	struct endpoint {
+		point<T, 2> p;
+		std::size_t segment;
+		bool start;
+	};
+
+	/*
+	 * crossing of the neighbours `lower` and `upper`, at `p` up to
+	 * `error` on each axis
+	 */
+	struct crossing {
+		point2d p;
+		point2d error;
+		std::size_t lower;
+		std::size_t upper;
+	};
+
+	/*
+	 * exact point of the crossing of the segments `s` and `t`, it is
+	 * `a + (n/d)*(b - a)` for the segment `a b` of `s`, with `d > 0`,
+	 * and `n` and `d` are expansions
+	 */
+	struct fraction {
+		double n[16];
+		double d[16];
+		std::size_t n_length;
+		std::size_t d_length;
+	};
+
+	predicate_counter* m_site = GMT_PREDICATE_SITE("segment_intersections");
+
+	/*
+	 * the segments from their lower to their greater endpoint, in the
+	 * order of the sweep
+	 */
+	std::vector<point<T, 2>> m_a;
+	std::vector<point<T, 2>> m_b;
+
+	std::vector<endpoint> m_endpoints;
+	std::vector<crossing> m_crossings;
+	sweep_tree<std::size_t> m_status;
+	std::vector<handle> m_node;
+
+	/*
+	 * buffers of an event: the segments that start and end at its point,
+	 * the ones of the status through it, and the ones that leave it
+	 */
+	std::vector<std::size_t> m_upper;
+	std::vector<std::size_t> m_ending;
+	std::vector<std::size_t> m_through;
+	std::vector<std::size_t> m_leaving;
+	std::vector<std::size_t> m_rank;
+
+	/*
+	 * expansions of the exact comparisons of the crossings
+	 */
+	std::vector<double> m_exact;
+
+	template<typename P>
+	static bool less(const P& p0, const P& p1)
+	{
+		return p0.x() < p1.x() || (p0.x() == p1.x() && p0.y() < p1.y());
+	}
+
+	static point2d to_double(const point<T, 2>& p)
+	{
+		return point2d{ double(p.x()), double(p.y()) };
+	}
+
+	direction turn(const point<T, 2>& p0, const point<T, 2>& p1, const point<T, 2>& p2) const
+	{
+		return robust_direction_in(p0, p1, p2, m_site);
+	}
+
+	bool collinear(std::size_t s, std::size_t t) const
+	{
+		return turn(m_a[s], m_b[s], m_a[t]) == ON && turn(m_a[s], m_b[s], m_b[t]) == ON;
+	}
+
+	template<typename visitor>
+	static bool call(const visitor& report, std::size_t i, std::size_t j, intersection::type type)
+	{
+		if(i > j)
+			std::swap(i, j);
+
+		if constexpr(std::is_same<decltype(report(i, j, type)), bool>::value){
+			return report(i, j, type);
+		}else{
+			report(i, j, type);
+			return true;
+		}
+	}
+
+	/*
+	 * schedules the crossing of the neighbours `s`, below, and `t` if
+	 * they cross at an interior point and are still in the order before
+	 * the crossing
+	 */
+	void check(handle hs, handle ht)
+	{
+		if(hs == m_status.npos || ht == m_status.npos)
+			return;
+
+		const std::size_t s = m_status[hs];
+		const std::size_t t = m_status[ht];
+
+		direction d0 = turn(m_a[t], m_b[t], m_a[s]);
+		direction d1 = turn(m_a[t], m_b[t], m_b[s]);
+
+		if(d0 == ON || d1 == ON || d0 == d1 || d1 != LEFT)
+			return;
+
+		direction d2 = turn(m_a[s], m_b[s], m_a[t]);
+		direction d3 = turn(m_a[s], m_b[s], m_b[t]);
+
+		if(d2 == ON || d3 == ON || d2 == d3)
+			return;
+
+		fraction f;
+		fraction_of(s, t, f);
+
+		/*
+		 * the fraction is in (0, 1), and the components of its
+		 * expansions do not overlap, so it is rounded to a few ulps
+		 * and the rounded point is within a few ulps of the endpoints
+		 * of `s` from the exact one
+		 */
+		const point2d a = to_double(m_a[s]);
+		const point2d b = to_double(m_b[s]);
+		const double u = exact::estimate(f.n_length, f.n)/exact::estimate(f.d_length, f.d);
+
+		crossing c;
+		c.lower = s;
+		c.upper = t;
+
+		for(std::size_t k=0; k<2; k++){
+			c.p[k] = a[k] + u*(b[k] - a[k]);
+			c.error[k] = 64.0*exact::epsilon*(std::fabs(a[k]) + std::fabs(b[k]));
+		}
+
+		m_crossings.push_back(c);
+		std::push_heap(m_crossings.begin(), m_crossings.end(), heap_order());
+	}
+
+	/*
+	 * the cross product of the vectors `u` and `v`, whose coordinates
+	 * are expansions of two components
+	 *
+	 * @return the length of `out`, at most 16
+	 */
+	static std::size_t cross_product(
+		const double* ux,
+		const double* uy,
+		const double* vx,
+		const double* vy,
+		double* out)
+	{
+		double m0[8], m1[8], scratch[16];
+
+		std::size_t m0_length = exact::expansion_product(2, ux, 2, vy, m0, scratch);
+		std::size_t m1_length = exact::expansion_product(2, uy, 2, vx, m1, scratch);
+		exact::negate(m1_length, m1);
+
+		return exact::expansion_sum(m0_length, m0, m1_length, m1, out);
+	}
+
+	/*
+	 * the exact point of the crossing of `s` and `t`: with `r = b - a`
+	 * for `s` and `q = e - c` for `t`, it is at `(c - a) x q / (r x q)`
+	 * of `r`
+	 */
+	void fraction_of(std::size_t s, std::size_t t, fraction& f) const
+	{
+		const point2d a = to_double(m_a[s]);
+		const point2d b = to_double(m_b[s]);
+		const point2d c = to_double(m_a[t]);
+		const point2d e = to_double(m_b[t]);
+
+		double rx[2], ry[2], qx[2], qy[2], wx[2], wy[2];
+		exact::two_diff(b.x(), a.x(), rx[1], rx[0]);
+		exact::two_diff(b.y(), a.y(), ry[1], ry[0]);
+		exact::two_diff(e.x(), c.x(), qx[1], qx[0]);
+		exact::two_diff(e.y(), c.y(), qy[1], qy[0]);
+		exact::two_diff(c.x(), a.x(), wx[1], wx[0]);
+		exact::two_diff(c.y(), a.y(), wy[1], wy[0]);
+
+		f.n_length = cross_product(wx, wy, qx, qy, f.n);
+		f.d_length = cross_product(rx, ry, qx, qy, f.d);
+
+		if(f.d[f.d_length - 1] < 0.0){
+			exact::negate(f.n_length, f.n);
+			exact::negate(f.d_length, f.d);
+		}
+	}
+
+	/*
+	 * the sign of the coordinate `k` of the crossing `c` minus the one of
+	 * `p`, by the sign of `(a - p)*d + r*n`
+	 */
+	int exact_compare(const crossing& c, const point2d& p, std::size_t k)
+	{
+		fraction f;
+		fraction_of(c.lower, c.upper, f);
+
+		double ap[2], r[2];
+		exact::two_diff(to_double(m_a[c.lower])[k], p[k], ap[1], ap[0]);
+		exact::two_diff(to_double(m_b[c.lower])[k], to_double(m_a[c.lower])[k], r[1], r[0]);
+
+		double t0[64], t1[64], sum[128], scratch[4*16*2];
+		std::size_t l0 = exact::expansion_product(f.d_length, f.d, 2, ap, t0, scratch);
+		std::size_t l1 = exact::expansion_product(f.n_length, f.n, 2, r, t1, scratch);
+		std::size_t length = exact::expansion_sum(l0, t0, l1, t1, sum);
+
+		return (sum[length - 1] > 0.0) - (sum[length - 1] < 0.0);
+	}
+
+	/*
+	 * the sign of the coordinate `k` of the crossing `c0` minus the one
+	 * of `c1`, by the sign of
+	 * `(a0 - a1)*d0*d1 + r0*n0*d1 - r1*n1*d0`
+	 */
+	int exact_compare(const crossing& c0, const crossing& c1, std::size_t k)
+	{
+		fraction f0, f1;
+		fraction_of(c0.lower, c0.upper, f0);
+		fraction_of(c1.lower, c1.upper, f1);
+
+		const double a0 = to_double(m_a[c0.lower])[k];
+		const double a1 = to_double(m_a[c1.lower])[k];
+
+		double da[2], r0[2], r1[2];
+		exact::two_diff(a0, a1, da[1], da[0]);
+		exact::two_diff(to_double(m_b[c0.lower])[k], a0, r0[1], r0[0]);
+		exact::two_diff(to_double(m_b[c1.lower])[k], a1, r1[1], r1[0]);
+
+		/*
+		 * the products have at most 512, 2048 and 64 components, and
+		 * the sums 4096 and 6144
+		 */
+		m_exact.resize(512 + 3*2048 + 2*64 + 4096 + 6144 + 4096);
+
+		double* dd = m_exact.data();
+		double* t0 = dd + 512;
+		double* t1 = t0 + 2048;
+		double* t2 = t1 + 2048;
+		double* rn0 = t2 + 2048;
+		double* rn1 = rn0 + 64;
+		double* sum = rn1 + 64;
+		double* total = sum + 4096;
+		double* scratch = total + 6144;
+
+		std::size_t dd_length = exact::expansion_product(f0.d_length, f0.d, f1.d_length, f1.d, dd, scratch);
+		std::size_t l0 = exact::expansion_product(dd_length, dd, 2, da, t0, scratch);
+
+		std::size_t rn0_length = exact::expansion_product(f0.n_length, f0.n, 2, r0, rn0, scratch);
+		std::size_t l1 = exact::expansion_product(rn0_length, rn0, f1.d_length, f1.d, t1, scratch);
+
+		std::size_t rn1_length = exact::expansion_product(f1.n_length, f1.n, 2, r1, rn1, scratch);
+		std::size_t l2 = exact::expansion_product(rn1_length, rn1, f0.d_length, f0.d, t2, scratch);
+		exact::negate(l2, t2);
+
+		std::size_t sum_length = exact::expansion_sum(l0, t0, l1, t1, sum);
+		std::size_t length = exact::expansion_sum(sum_length, sum, l2, t2, total);
+
+		return (total[length - 1] > 0.0) - (total[length - 1] < 0.0);
+	}
+
+	/*
+	 * -1, 0 or 1 if the crossing `c` is before, at or after `p` in the
+	 * order of the sweep, the rounded point tells unless `p` is in its
+	 * error
+	 */
+	template<typename event>
+	int compare(const crossing& c, const event& p)
+	{
+		for(std::size_t k=0; k<2; k++){
+			double lo, hi;
+			bounds(p, k, lo, hi);
+
+			if(c.p[k] + c.error[k] < lo)
+				return -1;
+			if(c.p[k] - c.error[k] > hi)
+				return 1;
+
+			if(int sign = exact_compare(c, p, k))
+				return sign;
+		}
+
+		return 0;
+	}
+
+	static void bounds(const point2d& p, std::size_t k, double& lo, double& hi)
+	{
+		lo = hi = p[k];
+	}
+
+	static void bounds(const crossing& c, std::size_t k, double& lo, double& hi)
+	{
+		lo = c.p[k] - c.error[k];
+		hi = c.p[k] + c.error[k];
+	}
+
+	/*
+	 * the heap of the crossings has the first one at its front
+	 */
+	auto heap_order()
+	{
+		return [this](const crossing& c0, const crossing& c1){
+			return compare(c1, c0) < 0;
+		};
+	}
+
+	/*
+	 * swaps the segments of the next crossing in the status, unless
+	 * they are not neighbours in the order before it anymore
+	 */
+	template<typename visitor>
+	bool cross(const visitor& report)
+	{
+		std::pop_heap(m_crossings.begin(), m_crossings.end(), heap_order());
+		crossing c = m_crossings.back();
+		m_crossings.pop_back();
+
+		handle hs = m_node[c.lower];
+		handle ht = m_node[c.upper];
+
+		if(hs == m_status.npos || ht == m_status.npos || m_status.next(hs) != ht)
+			return true;
+
+		m_status[hs] = c.upper;
+		m_status[ht] = c.lower;
+		m_node[c.upper] = hs;
+		m_node[c.lower] = ht;
+
+		check(m_status.prev(hs), hs);
+		check(ht, m_status.next(ht));
+
+		return call(report, c.lower, c.upper, intersection::PROPER);
+	}
+
+	/*
+	 * the event of the point `p`: the segments of the status through it
+	 * are found, the pairs among them and the ones that start at it are
+	 * reported, and the ones that go on after it are inserted again in
+	 * their order to the right of `p`
+	 */
+	template<typename visitor>
+	bool meet(const point<T, 2>& p, const visitor& report)
+	{
+		handle lower = m_status.last_before([&](std::size_t s){
+			return turn(m_a[s], m_b[s], p) == LEFT;
+		});
+
+		m_through.clear();
+		for(handle h = (lower == m_status.npos) ? m_status.first() : m_status.next(lower);
+			h != m_status.npos && turn(m_a[m_status[h]], m_b[m_status[h]], p) == ON;
+			h = m_status.next(h))
+			m_through.push_back(m_status[h]);
+
+		/*
+		 * the segments that start at `p` meet all the others there, the
+		 * collinear ones included, since their overlap starts at `p`
+		 */
+		for(std::size_t i=0; i<m_upper.size(); i++){
+			for(std::size_t j=i + 1; j<m_upper.size(); j++)
+				if(!call(report, m_upper[i], m_upper[j], intersection::IMPROPER))
+					return false;
+
+			for(std::size_t s : m_through)
+				if(!call(report, m_upper[i], s, intersection::IMPROPER))
+					return false;
+		}
+
+		/*
+		 * a segment that ends at `p` touches the others through it,
+		 * unless they overlap, which was reported where they started
+		 */
+		for(std::size_t i=0; i<m_through.size(); i++){
+			const std::size_t s = m_through[i];
+
+			if(!(m_b[s] == p))
+				continue;
+
+			for(std::size_t j=0; j<m_through.size(); j++){
+				const std::size_t t = m_through[j];
+
+				if(t == s || (m_b[t] == p && j < i) || collinear(s, t))
+					continue;
+
+				if(!call(report, s, t, intersection::IMPROPER))
+					return false;
+			}
+		}
+
+		m_rank.resize(m_node.size());
+		for(std::size_t i=0; i<m_through.size(); i++){
+			m_rank[m_through[i]] = i;
+			m_status.erase(m_node[m_through[i]]);
+			m_node[m_through[i]] = m_status.npos;
+		}
+
+		for(std::size_t s : m_ending){
+			if(m_node[s] != m_status.npos){
+				m_status.erase(m_node[s]);
+				m_node[s] = m_status.npos;
+			}
+		}
+
+		m_leaving.clear();
+		for(std::size_t s : m_upper)
+			if(!(m_a[s] == m_b[s]))
+				m_leaving.push_back(s);
+
+		const std::size_t n_upper = m_leaving.size();
+
+		for(std::size_t s : m_through)
+			if(!(m_b[s] == p))
+				m_leaving.push_back(s);
+
+		auto below = [&](std::size_t s, std::size_t t){
+			direction d = turn(p, m_b[s], m_b[t]);
+			return (d == ON) ? s < t : d == LEFT;
+		};
+
+		std::sort(m_leaving.begin(), m_leaving.end(), below);
+
+		/*
+		 * the segments that cross at `p` change their order, unless the
+		 * crossing was already taken as an event, before `p`; the
+		 * collinear ones go in groups and never cross
+		 */
+		if(m_leaving.size() - n_upper > 1){
+			for(std::size_t i=0; i<m_leaving.size();){
+				std::size_t end = i + 1;
+				while(end < m_leaving.size() && turn(p, m_b[m_leaving[i]], m_b[m_leaving[end]]) == ON)
+					end++;
+
+				for(std::size_t k=i; k<end; k++){
+					const std::size_t s = m_leaving[k];
+					if(m_a[s] == p)
+						continue;
+
+					for(std::size_t j=end; j<m_leaving.size(); j++){
+						const std::size_t t = m_leaving[j];
+
+						if(!(m_a[t] == p) && m_rank[t] < m_rank[s]
+							&& !call(report, s, t, intersection::PROPER))
+							return false;
+					}
+				}
+
+				i = end;
+			}
+		}
+
+		handle h = lower;
+		for(std::size_t s : m_leaving){
+			h = m_status.insert_after(h, s);
+			m_node[s] = h;
+		}
+
+		if(m_leaving.empty()){
+			if(lower != m_status.npos)
+				check(lower, m_status.next(lower));
+		}else{
+			check(lower, m_node[m_leaving.front()]);
+			check(h, m_status.next(h));
+		}
+
+		return true;
+	}
+};
+
+/**
+  * Finds every pair of intersecting segments of `segments` by the sweep
+  * of Bentley and Ottmann, in O((n + k) lg n) time for k pairs, and
+  * calls `report(i, j, type)` for each one of them, with `i < j` and the
+  * type given by `intersect`. The pairs are not stored, and `report` may
+  * return `false` to stop the sweep.
+  *
+  * @return false if the sweep was stopped by `report`
+  *
+  * @see segment_intersector
+  */
+template<typename T, typename visitor>
+bool for_each_intersection(
+	const std::vector<segment<T, 2>>& segments,
+	const visitor& report)
+{
+	segment_intersector<T> sweep;
+	return sweep.find(segments, report);
+}
+
+/**
+  * Every pair of intersecting segments of `segments`, in the order they
+  * are found by the sweep.
+  *
+  * @see for_each_intersection
+  */
+template<typename T>
+std::vector<segment_pair> segment_intersections(const std::vector<segment<T, 2>>& segments)
+{
+	std::vector<segment_pair> pairs;
+
+	segment_intersector<T> sweep;
+	sweep.find(segments, [&](std::size_t i, std::size_t j, intersection::type type){
+		pairs.push_back(segment_pair{ i, j, type });
+	});
+
+	return pairs;
+}
+
+}
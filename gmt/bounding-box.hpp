@@ -0,0 +1,120 @@
+#pragma once
+
+#include <limits>
+
+#include <gmt/point.hpp>
+
+namespace gmt {
+
+/**
+  * Axis-aligned bounding box, the closed region between the corners
+  * `min` and `max`. A default constructed box is empty, i.e., its `min`
+  * is greater than its `max` in every axis, so extending it with a point
+  * gives the box of that single point.
+  *
+  * @tparam T		type of the axes
+  * @tparam n_dimension	number of axes of the box
+  */
+template<typename T, std::size_t n_dimension = 2>
+class bounding_box {
+public:
+	point<T, n_dimension> min;
+	point<T, n_dimension> max;
+
+	constexpr bounding_box() noexcept
+	{
+		for(size_t i=0; i<n_dimension; i++){
+			min[i] = std::numeric_limits<T>::max();
+			max[i] = std::numeric_limits<T>::lowest();
+		}
+	}
+
+	constexpr bounding_box(
+		const point<T, n_dimension>& min,
+		const point<T, n_dimension>& max) noexcept
+		: min(min), max(max)
+	{}
+
+	/** @brief bounding box of the points of a container, e.g., a
+	  *  `polygon` or a `point_buffer`
+	  */
+	template<typename container>
+	static bounding_box of(const container& points) noexcept
+	{
+		bounding_box b;
+
+		for(const auto& p : points)
+			b.extend(p);
+
+		return b;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		for(size_t i=0; i<n_dimension; i++)
+			if(min[i] > max[i])
+				return true;
+
+		return false;
+	}
+
+	/** @brief grows the box to contain the point `p`
+	  */
+	constexpr void extend(const point<T, n_dimension>& p) noexcept
+	{
+		for(size_t i=0; i<n_dimension; i++){
+			if(p[i] < min[i])
+				min[i] = p[i];
+			if(p[i] > max[i])
+				max[i] = p[i];
+		}
+	}
+
+	/** @brief grows the box to contain the box `b`
+	  */
+	constexpr void extend(const bounding_box& b) noexcept
+	{
+		if(b.empty())
+			return;
+
+		extend(b.min);
+		extend(b.max);
+	}
+
+	/** @brief checks whether `p` is inside the box or on its boundary
+	  */
+	constexpr bool contains(const point<T, n_dimension>& p) const noexcept
+	{
+		for(size_t i=0; i<n_dimension; i++)
+			if(p[i] < min[i] || p[i] > max[i])
+				return false;
+
+		return true;
+	}
+
+	/** @brief checks whether the two boxes share at least one point
+	  */
+	constexpr bool intersects(const bounding_box& b) const noexcept
+	{
+		for(size_t i=0; i<n_dimension; i++)
+			if(b.max[i] < min[i] || b.min[i] > max[i])
+				return false;
+
+		return true;
+	}
+
+	friend std::ostream& operator<<(
+		std::ostream& o,
+		const bounding_box& b)
+	{
+		o << "[" << b.min << ", " << b.max << "]";
+		return o;
+	}
+};
+
+typedef bounding_box<double, 2>	bounding_box2d;
+typedef bounding_box<double, 3>	bounding_box3d;
+typedef bounding_box<int, 2>	bounding_box2i;
+typedef bounding_box<int, 3>	bounding_box3i;
+
+}
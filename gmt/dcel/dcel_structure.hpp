@@ -193,9 +193,9 @@ private:
 				i = i->twin;
 
 				if(i == v->incident_edge){
-					throw exception(
+					GMT_THROW(exception(
 						"connect_orbit: "
-						"cannot find the mutual face");
+						"cannot find the mutual face"));
 				}
 			}
 
@@ -441,6 +441,28 @@ public:
 		m_external_face->incident_edge = nullptr;
 	}
 
+	/** Replaces the content of the dcel by `n_vertex` vertices, `n_edge`
+	  * half-edges and `n_face` faces besides the external face, all of
+	  * them unlinked. The caller links them through their pointers, e.g.,
+	  * to rebuild a dcel stored with indices.
+	  */
+	void reset(size_t n_vertex, size_t n_edge, size_t n_face)
+	{
+		clear();
+
+		vertices.reserve(n_vertex);
+		for(size_t i=0; i<n_vertex; i++)
+			vertices.push_back(vertexptr(new vertex));
+
+		edges.reserve(n_edge);
+		for(size_t i=0; i<n_edge; i++)
+			edges.push_back(edgeptr(new edge));
+
+		faces.reserve(n_face);
+		for(size_t i=0; i<n_face; i++)
+			faces.push_back(faceptr(new face));
+	}
+
 private:
 	faceptr m_external_face;
 	std::vector<edgeptr> edges;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdio>
+#include <cstdlib>
 #include <stdexcept>
 #include <string>
 #include <sstream>
@@ -7,8 +9,36 @@
 #include <gmt/mat.hpp>
 /* #include <gmt/line.hpp> */
 
+/*
+ * GMT_NO_EXCEPTIONS builds the library without exceptions, it is defined
+ * automatically when the compiler has exceptions disabled, e.g., with
+ * -fno-exceptions. In this mode the errors that would be thrown abort
+ * the program, the `try_` functions report the errors without either.
+ */
+#if !defined(GMT_NO_EXCEPTIONS) \
+	&& !defined(__cpp_exceptions) && !defined(__EXCEPTIONS)
+#define GMT_NO_EXCEPTIONS
+#endif
+
+#ifdef GMT_NO_EXCEPTIONS
+#define GMT_THROW(e) ::gmt::fatal_error(e)
+#else
+#define GMT_THROW(e) throw e
+#endif
+
 namespace gmt {
 
+/**
+  * reports the error `e` and aborts, it takes the place of `throw` when
+  * the library is built without exceptions
+  */
+template<typename error>
+[[noreturn]] void fatal_error(const error& e) noexcept
+{
+	std::fprintf(stderr, "gmt: %s\n", e.what());
+	std::abort();
+}
+
 class exception : public std::runtime_error {
 
 public:
@@ -7,6 +7,7 @@
 #include <gmt/segment.hpp>
 #include <gmt/polygon.hpp>
 #include <gmt/polygon-with-holes.hpp>
+#include <gmt/polygon-set.hpp>
 #include <gmt/line.hpp>
 #include <gmt/dcel/dcelp.hpp>
 #include <gmt/algorithm/intersection.hpp>
@@ -176,6 +177,38 @@ public:
 			plot(hole, mode);
 	}
 
+	void plot(const ring_view<double, 2>& ring) const
+	{
+		for(const auto& p : ring)
+			plot(p);
+	}
+
+	void plot(const polygon_view<double, 2>& poly) const
+	{
+		for(size_t i=0; i<poly.n_rings(); i++)
+			plot(poly.ring(i));
+	}
+
+	void plot(const polygon_view<double, 2>& poly, GLenum mode) const
+	{
+		for(size_t i=0; i<poly.n_rings(); i++)
+			plot(poly.ring(i), mode);
+	}
+
+	/*
+	 * every ring of the set is a primitive of its own
+	 */
+	void plot(const polygon_set_view<double, 2>& set, GLenum mode) const
+	{
+		for(size_t r=0; r<set.n_rings(); r++)
+			plot(set.ring(r), mode);
+	}
+
+	void plot(const polygon_set<double, 2>& set, GLenum mode) const
+	{
+		plot(set.view(), mode);
+	}
+
 	void plot(const std::vector<polygon2d>& l, GLenum mode) const
 	{
 		glBegin(mode);
@@ -226,21 +259,18 @@ public:
 
 		glPointSize(5);
 		size_t intersection_count = 0;
-		try{
-			intersection = point_of_intersection(line, viewport[0]);
+		if(auto p = intersect_line_segment(line, viewport[0])){
+			intersection = *p;
 			intersection_count++;
-		}catch(line_does_not_intersect_segment& e){}
+		}
 
 		for(int i=1; i<4; i++){
 			last_intersection = intersection;
 
-			try{
-				intersection = point_of_intersection(
-						line,
-						viewport[i]);
-
+			if(auto p = intersect_line_segment(line, viewport[i])){
+				intersection = *p;
 				intersection_count++;
-			}catch(line_does_not_intersect_segment& e){}
+			}
 
 			if(intersection_count == 2
 				&& last_intersection != intersection){
@@ -134,7 +134,7 @@ protected:
 
 	static void error_callback(int error, const char* description)
 	{
-		throw glfw_error(error, description);
+		GMT_THROW(glfw_error(error, description));
 	}
 
 	static GLFWwindow* init(
@@ -145,7 +145,7 @@ protected:
 		GLFWwindow* share)
 	{
 		if(!glfwInit())
-			throw exception("Fail to initialize GLFW");
+			GMT_THROW(exception("Fail to initialize GLFW"));
 
 		glfwSetErrorCallback(error_callback);
 
@@ -158,7 +158,7 @@ protected:
 
 		if(w == nullptr){
 			terminate();
-			throw exception("Fail to create the window");
+			GMT_THROW(exception("Fail to create the window"));
 		}
 
 		return w;
@@ -187,7 +187,7 @@ private:
 		auto it = window_to_render.find(window);
 
 		if(it == window_to_render.end())
-			throw exception("Could not find a render to callback");
+			GMT_THROW(exception("Could not find a render to callback"));
 
 		return it->second;
 	}
@@ -281,7 +281,7 @@ public:
 		const char* c = glfwGetKeyName(key, scancode);
 
 		if(c == nullptr)
-			throw glfw_unknown_key_name();
+			GMT_THROW(glfw_unknown_key_name());
 
 		return c;
 	}
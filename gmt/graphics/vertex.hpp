@@ -28,9 +28,6 @@ public:
 		: point<T, n_dimension>(l)
 	{}
 
-	virtual ~vertex()
-	{}
-
 };
 
 typedef vertex<double, 2> vertex2d;
@@ -40,4 +37,7 @@ typedef vertex<int, 3> vertex3i;
 typedef vertex<float, 2> vertex2f;
 typedef vertex<float, 3> vertex3f;
 
+static_assert(std::is_trivially_copyable<vertex2d>::value,
+	"vertex2d must be trivially copyable");
+
 }
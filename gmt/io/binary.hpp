@@ -0,0 +1,1060 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GMT_HAS_MMAP
+#endif
+
+#include <gmt/exception.hpp>
+#include <gmt/point.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/polygon-set.hpp>
+#include <gmt/dcel/dcelp.hpp>
+
+/**
+  * Binary geometry files.
+  *
+  * A file is a header followed by sections, every section is a section
+  * header followed by its payload. The integers are unsigned, and the
+  * headers and the arrays of the payloads start at multiples of
+  * `binary_alignment` bytes, so a mapped file is read in place.
+  *
+  * The numbers are stored in the byte order of the host, as they are in
+  * memory; only little-endian hosts write the files, and a reader whose
+  * `byte_order` does not read back as 0x01020304 rejects them, so the
+  * files are little-endian. The layout of version 1 is:
+  *
+  *	header (64 bytes)
+  *		char magic[8]		"GMTGEOM\0"
+  *		u32 version		1
+  *		u32 byte_order		0x01020304 as written by the host
+  *		u64 reserved[6]
+  *
+  *	section header (64 bytes)
+  *		u32 kind		see `section_kind`
+  *		u32 scalar		type of the axes, see `scalar_kind`
+  *		u32 n_dimension		number of axes of the points
+  *		u32 reserved
+  *		u64 count[5]		sizes of the arrays, per kind
+  *		u64 size		bytes of the payload
+  *
+  *	POINT_BUFFER payload, count = { size, capacity }
+  *		the columns of a `point_buffer`, each one with `capacity`
+  *		values and the values after `size` equal to zero
+  *
+  *	POLYGON_SET payload, count = { polygons, rings, points }
+  *		points			the points of the rings, each one
+  *					with its axes in order
+  *		u64 ring_offsets[rings + 1]
+  *		u64 polygon_offsets[polygons + 1]
+  *
+  *	DCEL payload, count = { vertices, half-edges, faces }
+  *		points			the point of each vertex
+  *		u64 vertex_edge[vertices]
+  *		edges			`dcel_edge_record` of each half-edge
+  *		u64 face_edge[faces]
+  *
+  * In a DCEL the elements refer to each other by index, `dcel_none` is
+  * the null reference and the face 0 is the external face.
+  */
+namespace gmt {
+
+namespace io {
+
+constexpr std::size_t binary_alignment = 64;
+constexpr std::uint32_t binary_version = 1;
+constexpr std::uint32_t binary_byte_order = 0x01020304;
+constexpr char binary_magic[8] = { 'G', 'M', 'T', 'G', 'E', 'O', 'M', '\0' };
+constexpr std::uint64_t dcel_none = ~std::uint64_t(0);
+
+typedef enum {
+	POINT_BUFFER = 1,
+	POLYGON_SET = 2,
+	DCEL = 3
+} section_kind;
+
+typedef enum {
+	FLOAT64 = 1,
+	FLOAT32 = 2,
+	INT32 = 3,
+	INT64 = 4
+} scalar_kind;
+
+struct binary_header {
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t byte_order;
+	std::uint64_t reserved[6];
+};
+
+struct section_header {
+	std::uint32_t kind;
+	std::uint32_t scalar;
+	std::uint32_t n_dimension;
+	std::uint32_t reserved;
+	std::uint64_t count[5];
+	std::uint64_t size;
+};
+
+static_assert(sizeof(binary_header) == binary_alignment,
+	"the header must fill one aligned block");
+static_assert(sizeof(section_header) == binary_alignment,
+	"the section header must fill one aligned block");
+
+/**
+  * half-edge of a DCEL stored by indices
+  */
+struct dcel_edge_record {
+	std::uint64_t twin;
+	std::uint64_t next;
+	std::uint64_t prev;
+	std::uint64_t origin;
+	std::uint64_t destination;
+	std::uint64_t face;
+};
+
+/*
+ * code of the type of the axes
+ */
+template<typename T>
+constexpr scalar_kind scalar_of()
+{
+	static_assert(
+		std::is_same<T, double>::value
+		|| std::is_same<T, float>::value
+		|| (std::is_integral<T>::value && std::is_signed<T>::value
+			&& (sizeof(T) == 4 || sizeof(T) == 8)),
+		"the binary files store double, float, 32 or 64 bit integers");
+
+	if constexpr(std::is_same<T, double>::value)
+		return FLOAT64;
+	else if constexpr(std::is_same<T, float>::value)
+		return FLOAT32;
+	else if constexpr(sizeof(T) == 4)
+		return INT32;
+	else
+		return INT64;
+}
+
+constexpr std::uint64_t padded_size(std::uint64_t bytes)
+{
+	return (bytes + binary_alignment - 1)/binary_alignment*binary_alignment;
+}
+
+/*
+ * adds `bytes` to `total`, false if the sum does not fit in 64 bits
+ */
+inline bool checked_add(std::uint64_t& total, std::uint64_t bytes)
+{
+	if(bytes > ~std::uint64_t(0) - total)
+		return false;
+
+	total += bytes;
+	return true;
+}
+
+/*
+ * adds to `total` the padded size of an array of `count` items of
+ * `item_size` bytes, false if it does not fit in 64 bits
+ */
+inline bool add_array_size(
+	std::uint64_t& total,
+	std::uint64_t count,
+	std::uint64_t item_size)
+{
+	const std::uint64_t max = ~std::uint64_t(0) - binary_alignment;
+
+	if(item_size && count > max/item_size)
+		return false;
+
+	return checked_add(total, padded_size(count*item_size));
+}
+
+/*
+ * checks that the `n + 1` offsets start at zero, do not decrease and end
+ * at `last`
+ */
+inline bool valid_offsets(
+	const std::uint64_t* offsets,
+	std::uint64_t n,
+	std::uint64_t last)
+{
+	if(offsets[0] != 0 || offsets[n] != last)
+		return false;
+
+	for(std::uint64_t i=0; i<n; i++)
+		if(offsets[i] > offsets[i + 1])
+			return false;
+
+	return true;
+}
+
+/*
+ * checks that `i` refers to one of `n` elements or is `dcel_none`
+ */
+inline bool valid_index(std::uint64_t i, std::uint64_t n)
+{
+	return i == dcel_none || i < n;
+}
+
+inline bool little_endian_host()
+{
+	const std::uint32_t word = binary_byte_order;
+	unsigned char first;
+	std::memcpy(&first, &word, 1);
+	return first == 0x04;
+}
+
+/**
+  * Read-only view of a DCEL stored by indices, the arrays are read in
+  * place, see `load_dcel` to rebuild a `dcelp`
+  */
+template<typename T, std::size_t n_dimension>
+class dcel_view {
+public:
+	dcel_view() noexcept
+		: m_points(nullptr),
+		  m_vertex_edge(nullptr),
+		  m_edges(nullptr),
+		  m_face_edge(nullptr),
+		  m_n_vertex(0),
+		  m_n_edge(0),
+		  m_n_face(0)
+	{}
+
+	dcel_view(
+		const point<T, n_dimension>* points,
+		const std::uint64_t* vertex_edge,
+		size_t n_vertex,
+		const dcel_edge_record* edges,
+		size_t n_edge,
+		const std::uint64_t* face_edge,
+		size_t n_face) noexcept
+		: m_points(points),
+		  m_vertex_edge(vertex_edge),
+		  m_edges(edges),
+		  m_face_edge(face_edge),
+		  m_n_vertex(n_vertex),
+		  m_n_edge(n_edge),
+		  m_n_face(n_face)
+	{}
+
+	size_t n_vertex() const noexcept
+	{
+		return m_n_vertex;
+	}
+
+	size_t n_edge() const noexcept
+	{
+		return m_n_edge;
+	}
+
+	/** @brief number of faces, the external face included
+	  */
+	size_t n_face() const noexcept
+	{
+		return m_n_face;
+	}
+
+	const point<T, n_dimension>& vertex_point(size_t v) const noexcept
+	{
+		return m_points[v];
+	}
+
+	std::uint64_t vertex_edge(size_t v) const noexcept
+	{
+		return m_vertex_edge[v];
+	}
+
+	const dcel_edge_record& edge(size_t e) const noexcept
+	{
+		return m_edges[e];
+	}
+
+	std::uint64_t face_edge(size_t f) const noexcept
+	{
+		return m_face_edge[f];
+	}
+
+private:
+	const point<T, n_dimension>* m_points;
+	const std::uint64_t* m_vertex_edge;
+	const dcel_edge_record* m_edges;
+	const std::uint64_t* m_face_edge;
+	size_t m_n_vertex;
+	size_t m_n_edge;
+	size_t m_n_face;
+};
+
+/**
+  * Rebuilds in `d` the DCEL of the view `v`, the data of the vertices,
+  * edges and faces besides the points are default constructed. The
+  * indices of `v` are not checked, those of the views returned by
+  * `binary_file` have been checked when the section was opened.
+  */
+template<
+	typename point_type,
+	std::size_t n_dimension,
+	typename vertex_type,
+	typename edge_type,
+	typename face_type
+>
+void load_dcel(
+	const dcel_view<point_type, n_dimension>& v,
+	dcelp<point_type, n_dimension, vertex_type, edge_type, face_type>& d)
+{
+	typedef dcelp<
+		point_type,
+		n_dimension,
+		vertex_type,
+		edge_type,
+		face_type
+	> dcel_type;
+
+	d.reset(v.n_vertex(), v.n_edge(), v.n_face() ? v.n_face() - 1 : 0);
+
+	auto vertex_at = [&](std::uint64_t i) -> typename dcel_type::vertex* {
+		return (i == dcel_none) ? nullptr : d.vertex_at(i);
+	};
+
+	auto edge_at = [&](std::uint64_t i) -> typename dcel_type::edge* {
+		return (i == dcel_none) ? nullptr : d.edge_at(i);
+	};
+
+	auto face_at = [&](std::uint64_t i) -> typename dcel_type::face* {
+		if(i == dcel_none)
+			return nullptr;
+		return (i == 0) ? d.external_face() : d.face_at(i - 1);
+	};
+
+	for(size_t i=0; i<v.n_vertex(); i++){
+		d.vertex_at(i)->data.p = v.vertex_point(i);
+		d.vertex_at(i)->incident_edge = edge_at(v.vertex_edge(i));
+	}
+
+	for(size_t i=0; i<v.n_edge(); i++){
+		const dcel_edge_record& r = v.edge(i);
+		typename dcel_type::edge* e = d.edge_at(i);
+
+		e->twin = edge_at(r.twin);
+		e->next = edge_at(r.next);
+		e->prev = edge_at(r.prev);
+		e->origin = vertex_at(r.origin);
+		e->destination = vertex_at(r.destination);
+		e->incident_face = face_at(r.face);
+	}
+
+	for(size_t i=0; i<v.n_face(); i++)
+		face_at(i)->incident_edge = edge_at(v.face_edge(i));
+}
+
+/**
+  * Binary geometry file opened for reading. The file is mapped in
+  * memory when the system supports it, otherwise it is read at once, and
+  * the sections are returned as views of the mapping, without copying.
+  * The views are valid while the `binary_file` lives.
+  */
+class binary_file {
+public:
+	binary_file() noexcept
+		: m_data(nullptr), m_size(0), m_mapped(false)
+	{}
+
+	explicit binary_file(const std::string& path)
+		: binary_file()
+	{
+		if(const char* error = open(path))
+			GMT_THROW(exception(error));
+	}
+
+	binary_file(const binary_file&) = delete;
+	binary_file& operator=(const binary_file&) = delete;
+
+	binary_file(binary_file&& f) noexcept
+		: binary_file()
+	{
+		*this = std::move(f);
+	}
+
+	binary_file& operator=(binary_file&& f) noexcept
+	{
+		std::swap(m_data, f.m_data);
+		std::swap(m_size, f.m_size);
+		std::swap(m_mapped, f.m_mapped);
+		std::swap(m_sections, f.m_sections);
+		return *this;
+	}
+
+	~binary_file()
+	{
+		release();
+	}
+
+	/** @brief the file at `path`, or nothing if it cannot be read or it
+	  *  is not a valid binary geometry file
+	  */
+	static std::optional<binary_file> try_open(const std::string& path)
+	{
+		binary_file f;
+		if(f.open(path))
+			return std::nullopt;
+
+		return std::optional<binary_file>(std::move(f));
+	}
+
+	size_t n_sections() const noexcept
+	{
+		return m_sections.size();
+	}
+
+	const section_header& section(size_t i) const noexcept
+	{
+		return *m_sections[i];
+	}
+
+	section_kind kind(size_t i) const noexcept
+	{
+		return section_kind(m_sections[i]->kind);
+	}
+
+	/** @brief point buffer of the section `i`, its columns are borrowed
+	  *  from the file, see `point_buffer::borrow`
+	  */
+	template<typename T, std::size_t n_dimension>
+	point_buffer<T, n_dimension> points(size_t i) const
+	{
+		std::optional<point_buffer<T, n_dimension>> b =
+			try_points<T, n_dimension>(i);
+
+		if(!b)
+			GMT_THROW(exception("binary_file: not a point buffer section"));
+
+		return std::move(*b);
+	}
+
+	template<typename T, std::size_t n_dimension>
+	std::optional<point_buffer<T, n_dimension>> try_points(size_t i) const
+	{
+		const section_header* h = find<T, n_dimension>(i, POINT_BUFFER);
+		const std::uint64_t block = binary_alignment/sizeof(T);
+
+		std::uint64_t size = 0;
+		if(!h || h->count[0] > h->count[1] || h->count[1]%block
+			|| !add_array_size(size, h->count[1], n_dimension*sizeof(T))
+			|| size > h->size)
+			return std::nullopt;
+
+		return point_buffer<T, n_dimension>::borrow(
+			reinterpret_cast<const T*>(payload(h)),
+			h->count[0],
+			h->count[1]);
+	}
+
+	/** @brief view of the polygon set of the section `i`
+	  */
+	template<typename T, std::size_t n_dimension>
+	polygon_set_view<T, n_dimension> polygons(size_t i) const
+	{
+		std::optional<polygon_set_view<T, n_dimension>> s =
+			try_polygons<T, n_dimension>(i);
+
+		if(!s)
+			GMT_THROW(exception("binary_file: not a polygon set section"));
+
+		return *s;
+	}
+
+	template<typename T, std::size_t n_dimension>
+	std::optional<polygon_set_view<T, n_dimension>> try_polygons(size_t i) const
+	{
+		const section_header* h = find<T, n_dimension>(i, POLYGON_SET);
+		if(!h)
+			return std::nullopt;
+
+		const std::uint64_t n_polygons = h->count[0];
+		const std::uint64_t n_rings = h->count[1];
+		const std::uint64_t n_points = h->count[2];
+
+		/*
+		 * the counts are bounded by the payload before one is added,
+		 * so `n + 1` and the sums cannot wrap
+		 */
+		if(n_rings >= h->size || n_polygons >= h->size)
+			return std::nullopt;
+
+		std::uint64_t rings_at = 0;
+		if(!add_array_size(rings_at, n_points, sizeof(point<T, n_dimension>)))
+			return std::nullopt;
+
+		std::uint64_t polygons_at = rings_at;
+		if(!add_array_size(polygons_at, n_rings + 1, sizeof(std::uint64_t)))
+			return std::nullopt;
+
+		std::uint64_t size = polygons_at;
+		if(!add_array_size(size, n_polygons + 1, sizeof(std::uint64_t))
+			|| size > h->size)
+			return std::nullopt;
+
+		const char* p = payload(h);
+		const polygon_set_offset* ring_offsets =
+			reinterpret_cast<const polygon_set_offset*>(p + rings_at);
+		const polygon_set_offset* polygon_offsets =
+			reinterpret_cast<const polygon_set_offset*>(p + polygons_at);
+
+		if(!valid_offsets(ring_offsets, n_rings, n_points)
+			|| !valid_offsets(polygon_offsets, n_polygons, n_rings))
+			return std::nullopt;
+
+		return polygon_set_view<T, n_dimension>(
+			reinterpret_cast<const point<T, n_dimension>*>(p),
+			ring_offsets,
+			polygon_offsets,
+			n_polygons);
+	}
+
+	/** @brief view of the DCEL of the section `i`
+	  */
+	template<typename T, std::size_t n_dimension>
+	dcel_view<T, n_dimension> dcel(size_t i) const
+	{
+		std::optional<dcel_view<T, n_dimension>> d =
+			try_dcel<T, n_dimension>(i);
+
+		if(!d)
+			GMT_THROW(exception("binary_file: not a dcel section"));
+
+		return *d;
+	}
+
+	template<typename T, std::size_t n_dimension>
+	std::optional<dcel_view<T, n_dimension>> try_dcel(size_t i) const
+	{
+		const section_header* h = find<T, n_dimension>(i, DCEL);
+		if(!h)
+			return std::nullopt;
+
+		const std::uint64_t n_vertex = h->count[0];
+		const std::uint64_t n_edge = h->count[1];
+		const std::uint64_t n_face = h->count[2];
+
+		std::uint64_t vertices_at = 0;
+		if(!add_array_size(vertices_at, n_vertex, sizeof(point<T, n_dimension>)))
+			return std::nullopt;
+
+		std::uint64_t edges_at = vertices_at;
+		if(!add_array_size(edges_at, n_vertex, sizeof(std::uint64_t)))
+			return std::nullopt;
+
+		std::uint64_t faces_at = edges_at;
+		if(!add_array_size(faces_at, n_edge, sizeof(dcel_edge_record)))
+			return std::nullopt;
+
+		std::uint64_t size = faces_at;
+		if(!add_array_size(size, n_face, sizeof(std::uint64_t))
+			|| size > h->size)
+			return std::nullopt;
+
+		const char* p = payload(h);
+		const std::uint64_t* vertex_edge =
+			reinterpret_cast<const std::uint64_t*>(p + vertices_at);
+		const dcel_edge_record* edges =
+			reinterpret_cast<const dcel_edge_record*>(p + edges_at);
+		const std::uint64_t* face_edge =
+			reinterpret_cast<const std::uint64_t*>(p + faces_at);
+
+		/*
+		 * the view and `load_dcel` follow the indices without checking
+		 * them, so all of them are checked here
+		 */
+		for(std::uint64_t v=0; v<n_vertex; v++)
+			if(!valid_index(vertex_edge[v], n_edge))
+				return std::nullopt;
+
+		for(std::uint64_t e=0; e<n_edge; e++){
+			const dcel_edge_record& r = edges[e];
+
+			if(!valid_index(r.twin, n_edge)
+				|| !valid_index(r.next, n_edge)
+				|| !valid_index(r.prev, n_edge)
+				|| !valid_index(r.origin, n_vertex)
+				|| !valid_index(r.destination, n_vertex)
+				|| !valid_index(r.face, n_face))
+				return std::nullopt;
+		}
+
+		for(std::uint64_t f=0; f<n_face; f++)
+			if(!valid_index(face_edge[f], n_edge))
+				return std::nullopt;
+
+		return dcel_view<T, n_dimension>(
+			reinterpret_cast<const point<T, n_dimension>*>(p),
+			vertex_edge,
+			n_vertex,
+			edges,
+			n_edge,
+			face_edge,
+			n_face);
+	}
+
+private:
+	char* m_data;
+	size_t m_size;
+	bool m_mapped;
+	std::vector<const section_header*> m_sections;
+
+	static const char* payload(const section_header* h) noexcept
+	{
+		return reinterpret_cast<const char*>(h) + sizeof(section_header);
+	}
+
+	/*
+	 * header of the section `i` if it has the kind and the type of the
+	 * points asked
+	 */
+	template<typename T, std::size_t n_dimension>
+	const section_header* find(size_t i, section_kind kind) const noexcept
+	{
+		if(i >= m_sections.size())
+			return nullptr;
+
+		const section_header* h = m_sections[i];
+		if(h->kind != std::uint32_t(kind)
+			|| h->scalar != std::uint32_t(scalar_of<T>())
+			|| h->n_dimension != n_dimension)
+			return nullptr;
+
+		return h;
+	}
+
+	void release() noexcept
+	{
+		if(!m_data)
+			return;
+
+#ifdef GMT_HAS_MMAP
+		if(m_mapped)
+			munmap(m_data, m_size);
+		else
+#endif
+			::operator delete(m_data, std::align_val_t(binary_alignment));
+
+		m_data = nullptr;
+		m_size = 0;
+		m_sections.clear();
+	}
+
+	/*
+	 * maps the file and checks the headers
+	 *
+	 * @return a message describing the error, or null
+	 */
+	const char* open(const std::string& path)
+	{
+		release();
+
+#ifdef GMT_HAS_MMAP
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if(fd < 0)
+			return "binary_file: cannot open the file";
+
+		struct stat st;
+		if(fstat(fd, &st) != 0 || st.st_size < off_t(sizeof(binary_header))){
+			::close(fd);
+			return "binary_file: the file has no header";
+		}
+
+		void* data = mmap(
+			nullptr,
+			st.st_size,
+			PROT_READ,
+			MAP_PRIVATE,
+			fd,
+			0);
+		::close(fd);
+
+		if(data == MAP_FAILED)
+			return "binary_file: cannot map the file";
+
+		m_data = static_cast<char*>(data);
+		m_size = st.st_size;
+		m_mapped = true;
+#else
+		std::ifstream in(path, std::ios::binary | std::ios::ate);
+		if(!in)
+			return "binary_file: cannot open the file";
+
+		std::streamoff size = in.tellg();
+		if(size < std::streamoff(sizeof(binary_header)))
+			return "binary_file: the file has no header";
+
+		m_data = static_cast<char*>(::operator new(
+			size,
+			std::align_val_t(binary_alignment)));
+		m_size = size;
+		m_mapped = false;
+
+		in.seekg(0);
+		if(!in.read(m_data, size)){
+			release();
+			return "binary_file: cannot read the file";
+		}
+#endif
+
+		const binary_header* header =
+			reinterpret_cast<const binary_header*>(m_data);
+
+		const char* error = nullptr;
+		if(std::memcmp(header->magic, binary_magic, sizeof(binary_magic)))
+			error = "binary_file: not a binary geometry file";
+		else if(header->version != binary_version)
+			error = "binary_file: unsupported version";
+		else if(header->byte_order != binary_byte_order)
+			error = "binary_file: unsupported byte order";
+
+		for(size_t at = sizeof(binary_header); !error && at < m_size;){
+			const section_header* h =
+				reinterpret_cast<const section_header*>(m_data + at);
+
+			if(m_size - at < sizeof(section_header)
+				|| h->size%binary_alignment
+				|| h->size > m_size - at - sizeof(section_header)){
+				error = "binary_file: truncated section";
+				break;
+			}
+
+			m_sections.push_back(h);
+			at += sizeof(section_header) + h->size;
+		}
+
+		if(error)
+			release();
+
+		return error;
+	}
+};
+
+/**
+  * Writes a binary geometry file section by section. Each section is
+  * written as soon as it is given, and a polygon set may also be
+  * streamed a polygon at a time, see `begin_polygon_set`.
+  */
+class binary_writer {
+public:
+	explicit binary_writer(const std::string& path)
+		: m_out(path, std::ios::binary | std::ios::trunc),
+		  m_streaming(false)
+	{
+		if(!little_endian_host())
+			GMT_THROW(exception(
+				"binary_writer: the files are little-endian"));
+
+		if(!m_out)
+			GMT_THROW(exception("binary_writer: cannot open the file"));
+
+		binary_header header = {};
+		std::memcpy(header.magic, binary_magic, sizeof(binary_magic));
+		header.version = binary_version;
+		header.byte_order = binary_byte_order;
+
+		put(&header, sizeof(header));
+	}
+
+	~binary_writer()
+	{
+		if(m_out.is_open())
+			m_out.flush();
+	}
+
+	template<typename T, std::size_t n_dimension>
+	void write(const point_buffer<T, n_dimension>& b)
+	{
+		const size_t block = binary_alignment/sizeof(T);
+		const size_t capacity = (b.size() + block - 1)/block*block;
+
+		section_header h = header<T, n_dimension>(POINT_BUFFER);
+		h.count[0] = b.size();
+		h.count[1] = capacity;
+		h.size = capacity*n_dimension*sizeof(T);
+		put(&h, sizeof(h));
+
+		for(size_t a=0; a<n_dimension; a++){
+			put(b.column(a), b.size()*sizeof(T));
+			pad((capacity - b.size())*sizeof(T));
+		}
+	}
+
+	template<typename T, std::size_t n_dimension>
+	void write(const polygon_set_view<T, n_dimension>& s)
+	{
+		section_header h = header<T, n_dimension>(POLYGON_SET);
+		h.count[0] = s.size();
+		h.count[1] = s.n_rings();
+		h.count[2] = s.n_points();
+
+		std::uint64_t points_size = s.n_points()*sizeof(point<T, n_dimension>);
+		std::uint64_t rings_size = (s.n_rings() + 1)*sizeof(std::uint64_t);
+		std::uint64_t polygons_size = (s.size() + 1)*sizeof(std::uint64_t);
+
+		h.size = padded_size(points_size)
+			+ padded_size(rings_size)
+			+ padded_size(polygons_size);
+		put(&h, sizeof(h));
+
+		const std::uint64_t zero = 0;
+
+		put_padded(s.points(), points_size);
+
+		if(s.size())
+			put_padded(s.ring_offsets(), rings_size);
+		else
+			put_padded(&zero, rings_size);
+
+		if(s.size())
+			put_padded(s.polygon_offsets(), polygons_size);
+		else
+			put_padded(&zero, polygons_size);
+	}
+
+	template<typename T, std::size_t n_dimension>
+	void write(const polygon_set<T, n_dimension>& s)
+	{
+		write(s.view());
+	}
+
+	/** @brief starts a polygon set section whose polygons are given
+	  *  by `add_polygon` and `add_hole`, the points are written as they
+	  *  come and only the offsets are kept until `end_polygon_set`
+	  */
+	template<typename T, std::size_t n_dimension>
+	void begin_polygon_set()
+	{
+		if(m_streaming)
+			GMT_THROW(exception("binary_writer: a polygon set is open"));
+
+		m_streaming = true;
+		m_section = header<T, n_dimension>(POLYGON_SET);
+		m_section_at = m_out.tellp();
+		m_ring_offsets.assign(1, 0);
+		m_polygon_offsets.assign(1, 0);
+
+		put(&m_section, sizeof(m_section));
+	}
+
+	template<typename container>
+	void add_polygon(const container& boundary)
+	{
+		m_polygon_offsets.push_back(m_polygon_offsets.back());
+		add_hole(boundary);
+	}
+
+	template<typename container>
+	void add_hole(const container& ring)
+	{
+		typedef typename container::value_type point_type;
+		typedef typename point_type::value_type T;
+
+		if(!m_streaming || m_polygon_offsets.size() < 2
+			|| m_section.scalar != std::uint32_t(scalar_of<T>())
+			|| m_section.n_dimension != point_type().ndim())
+			GMT_THROW(exception("binary_writer: no matching polygon set"));
+
+		size_t n = 0;
+		for(const auto& p : ring){
+			put(&p, sizeof(point_type));
+			n++;
+		}
+
+		m_ring_offsets.push_back(m_ring_offsets.back() + n);
+		m_polygon_offsets.back()++;
+	}
+
+	void end_polygon_set()
+	{
+		if(!m_streaming)
+			GMT_THROW(exception("binary_writer: no polygon set is open"));
+
+		m_streaming = false;
+
+		const std::uint64_t n_points = m_ring_offsets.back();
+		const std::uint64_t point_size =
+			scalar_size(scalar_kind(m_section.scalar))
+			*m_section.n_dimension;
+		const std::uint64_t points_size = n_points*point_size;
+		const std::uint64_t rings_size =
+			m_ring_offsets.size()*sizeof(std::uint64_t);
+		const std::uint64_t polygons_size =
+			m_polygon_offsets.size()*sizeof(std::uint64_t);
+
+		pad(padded_size(points_size) - points_size);
+		put_padded(m_ring_offsets.data(), rings_size);
+		put_padded(m_polygon_offsets.data(), polygons_size);
+
+		m_section.count[0] = m_polygon_offsets.size() - 1;
+		m_section.count[1] = m_ring_offsets.size() - 1;
+		m_section.count[2] = n_points;
+		m_section.size = padded_size(points_size)
+			+ padded_size(rings_size)
+			+ padded_size(polygons_size);
+
+		std::streampos end = m_out.tellp();
+		m_out.seekp(m_section_at);
+		put(&m_section, sizeof(m_section));
+		m_out.seekp(end);
+
+		m_ring_offsets.clear();
+		m_polygon_offsets.clear();
+	}
+
+	/** @brief writes the points and the topology of the DCEL `d`, the
+	  *  data of the vertices, edges and faces besides the points are not
+	  *  written
+	  */
+	template<
+		typename point_type,
+		std::size_t n_dimension,
+		typename vertex_type,
+		typename edge_type,
+		typename face_type
+	>
+	void write(const dcelp<
+		point_type,
+		n_dimension,
+		vertex_type,
+		edge_type,
+		face_type>& d)
+	{
+		std::unordered_map<const void*, std::uint64_t> index;
+
+		index[d.external_face()] = 0;
+		for(size_t i=0; i<d.n_vertex(); i++)
+			index[d.vertex_at(i)] = i;
+		for(size_t i=0; i<d.n_edge(); i++)
+			index[d.edge_at(i)] = i;
+		for(size_t i=0; i<d.n_face(); i++)
+			index[d.face_at(i)] = i + 1;
+
+		auto index_of = [&](const void* p) -> std::uint64_t {
+			return p ? index.at(p) : dcel_none;
+		};
+
+		section_header h = header<point_type, n_dimension>(DCEL);
+		h.count[0] = d.n_vertex();
+		h.count[1] = d.n_edge();
+		h.count[2] = d.n_face() + 1;
+
+		const std::uint64_t points_size =
+			d.n_vertex()*sizeof(point<point_type, n_dimension>);
+		const std::uint64_t vertex_size =
+			d.n_vertex()*sizeof(std::uint64_t);
+		const std::uint64_t edges_size =
+			d.n_edge()*sizeof(dcel_edge_record);
+		const std::uint64_t faces_size =
+			(d.n_face() + 1)*sizeof(std::uint64_t);
+
+		h.size = padded_size(points_size)
+			+ padded_size(vertex_size)
+			+ padded_size(edges_size)
+			+ padded_size(faces_size);
+		put(&h, sizeof(h));
+
+		for(size_t i=0; i<d.n_vertex(); i++)
+			put(&d.vertex_at(i)->data.p, sizeof(point<point_type, n_dimension>));
+		pad(padded_size(points_size) - points_size);
+
+		for(size_t i=0; i<d.n_vertex(); i++){
+			std::uint64_t e = index_of(d.vertex_at(i)->incident_edge);
+			put(&e, sizeof(e));
+		}
+		pad(padded_size(vertex_size) - vertex_size);
+
+		for(size_t i=0; i<d.n_edge(); i++){
+			auto* e = d.edge_at(i);
+			dcel_edge_record r = {
+				index_of(e->twin),
+				index_of(e->next),
+				index_of(e->prev),
+				index_of(e->origin),
+				index_of(e->destination),
+				index_of(e->incident_face)
+			};
+			put(&r, sizeof(r));
+		}
+		pad(padded_size(edges_size) - edges_size);
+
+		std::uint64_t e = index_of(d.external_face()->incident_edge);
+		put(&e, sizeof(e));
+		for(size_t i=0; i<d.n_face(); i++){
+			e = index_of(d.face_at(i)->incident_edge);
+			put(&e, sizeof(e));
+		}
+		pad(padded_size(faces_size) - faces_size);
+	}
+
+	/** @brief writes the pending data to the file
+	  */
+	void flush()
+	{
+		if(!m_out.flush())
+			GMT_THROW(exception("binary_writer: cannot write the file"));
+	}
+
+private:
+	std::ofstream m_out;
+	bool m_streaming;
+	section_header m_section;
+	std::streampos m_section_at;
+	std::vector<std::uint64_t> m_ring_offsets;
+	std::vector<std::uint64_t> m_polygon_offsets;
+
+	template<typename T, std::size_t n_dimension>
+	static section_header header(section_kind kind)
+	{
+		static_assert(sizeof(point<T, n_dimension>) == n_dimension*sizeof(T),
+			"the points are written as their axes");
+
+		section_header h = {};
+		h.kind = kind;
+		h.scalar = scalar_of<T>();
+		h.n_dimension = n_dimension;
+		return h;
+	}
+
+	static std::uint64_t scalar_size(scalar_kind s)
+	{
+		return (s == FLOAT64 || s == INT64) ? 8 : 4;
+	}
+
+	void put(const void* data, std::uint64_t size)
+	{
+		if(size && !m_out.write(static_cast<const char*>(data), size))
+			GMT_THROW(exception("binary_writer: cannot write the file"));
+	}
+
+	void pad(std::uint64_t size)
+	{
+		static const char zero[binary_alignment] = {};
+		put(zero, size);
+	}
+
+	void put_padded(const void* data, std::uint64_t size)
+	{
+		put(data, size);
+		pad(padded_size(size) - size);
+	}
+};
+
+}
+
+}
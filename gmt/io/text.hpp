@@ -0,0 +1,1317 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+
+#include <gmt/exception.hpp>
+#include <gmt/point.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-with-holes.hpp>
+#include <gmt/polygon-set.hpp>
+
+/**
+  * Text geometry formats: WKT, GeoJSON and CSV lists of points.
+  *
+  * The readers consume the stream a chunk of `text_chunk_size` bytes at
+  * a time, so their memory does not depend on the size of the input, and
+  * the coordinates are parsed with `std::from_chars` and written straight
+  * into the containers. The closing vertex of the rings, which repeats
+  * the first one in WKT and GeoJSON, is dropped, and the writers add it
+  * back. A reader that fails leaves the containers as they were.
+  *
+  * An empty polygon is written as `POLYGON EMPTY` in WKT and as empty
+  * coordinates in GeoJSON, and read back as an empty polygon, and the
+  * empty rings are skipped. The writers throw on coordinates that are
+  * not finite, which the readers do not accept.
+  */
+namespace gmt {
+
+namespace io {
+
+constexpr std::size_t text_chunk_size = 1 << 16;
+
+/**
+  * Nesting of the GeoJSON objects and arrays, and of the WKT geometry
+  * collections, past which the readers fail, so a malformed input does
+  * not overflow the stack of their recursive descent.
+  */
+constexpr std::size_t text_max_depth = 256;
+
+/**
+  * Destination of the geometries read, the polygons are appended to a
+  * `polygon_set` and the standalone points, if `points` is not null, to a
+  * `point_buffer`
+  */
+class polygon_set_sink {
+public:
+	explicit polygon_set_sink(
+		polygon_set2d& polygons,
+		point_buffer2d* points = nullptr) noexcept
+		: polygons(polygons), points(points)
+	{}
+
+	void begin_polygon()
+	{
+		polygons.new_polygon();
+	}
+
+	void vertex(const point2d& p)
+	{
+		polygons.push_back(p);
+	}
+
+	void end_ring()
+	{
+		size_t n = polygons.open_ring_size();
+		const auto& v = polygons.points();
+
+		if(n == 0)
+			return;
+
+		if(n > 1 && v.back() == v[v.size() - n])
+			polygons.pop_back();
+
+		polygons.close_ring();
+	}
+
+	void end_polygon()
+	{}
+
+	void point(const point2d& p)
+	{
+		if(points)
+			points->push_back(p);
+	}
+
+	/*
+	 * sizes of the containers, to take back what was given after them
+	 */
+	struct mark {
+		size_t polygons;
+		size_t rings;
+		size_t vertices;
+		size_t points;
+	};
+
+	mark position() const noexcept
+	{
+		return mark{
+			polygons.size(),
+			polygons.n_rings(),
+			polygons.n_points(),
+			points ? points->size() : 0
+		};
+	}
+
+	void rollback(const mark& m)
+	{
+		polygons.truncate(m.polygons, m.rings, m.vertices);
+		if(points)
+			points->resize(m.points);
+	}
+
+private:
+	polygon_set2d& polygons;
+	point_buffer2d* points;
+};
+
+/*
+ * the input stream read one chunk at a time
+ */
+class text_source {
+public:
+	explicit text_source(std::istream& in)
+		: in(in), pos(0), end(0), consumed(0)
+	{}
+
+	int peek()
+	{
+		if(pos == end && !fill())
+			return EOF;
+
+		return static_cast<unsigned char>(buffer[pos]);
+	}
+
+	int get()
+	{
+		int c = peek();
+		if(c != EOF)
+			pos++;
+
+		return c;
+	}
+
+	/** @brief skips the white spaces and returns the next character
+	  */
+	int skip_space()
+	{
+		int c = peek();
+		while(c == ' ' || c == '\t' || c == '\n' || c == '\r'){
+			pos++;
+			c = peek();
+		}
+
+		return c;
+	}
+
+	/** @brief the characters of the chunk from the next one
+	  */
+	const char* cursor() const noexcept
+	{
+		return buffer + pos;
+	}
+
+	const char* chunk_end() const noexcept
+	{
+		return buffer + end;
+	}
+
+	void advance(size_t n) noexcept
+	{
+		pos += n;
+	}
+
+	/** @brief offset of the next character in the stream
+	  */
+	size_t offset() const noexcept
+	{
+		return consumed + pos;
+	}
+
+private:
+	std::istream& in;
+	char buffer[text_chunk_size];
+	size_t pos;
+	size_t end;
+	size_t consumed;
+
+	bool fill()
+	{
+		consumed += end;
+		in.read(buffer, sizeof(buffer));
+		end = in.gcount();
+		pos = 0;
+		return end > 0;
+	}
+};
+
+/*
+ * recursive descent parsers of the formats, the geometries are given to
+ * `sink`, see `polygon_set_sink`
+ */
+template<typename sink_type>
+class text_parser {
+public:
+	text_parser(std::istream& in, sink_type& sink)
+		: src(in), sink(sink), error(nullptr), error_at(0), count(0), nesting(0)
+	{}
+
+	/** @brief number of polygons and points read
+	  */
+	size_t geometries() const noexcept
+	{
+		return count;
+	}
+
+	/** @brief message of the error of the last parse, with its offset
+	  */
+	std::string message(const char* format) const
+	{
+		return std::string(format) + ": " + error
+			+ " at byte " + std::to_string(error_at);
+	}
+
+	bool wkt()
+	{
+		while(src.skip_space() != EOF){
+			if(!wkt_geometry())
+				return false;
+
+			if(src.skip_space() == ';')
+				src.get();
+		}
+
+		return true;
+	}
+
+	bool geojson()
+	{
+		while(src.skip_space() != EOF)
+			if(!json_value())
+				return false;
+
+		return true;
+	}
+
+	bool csv(char delimiter, bool header, size_t x_column, size_t y_column)
+	{
+		if(header)
+			while(true){
+				int c = src.get();
+				if(c == EOF || c == '\n')
+					break;
+			}
+
+		const size_t last = std::max(x_column, y_column);
+		double axis[2] = { 0.0, 0.0 };
+
+		while(src.peek() != EOF){
+			size_t column = 0;
+			size_t found = 0;
+			bool blank = true;
+
+			while(true){
+				int c = src.peek();
+				if(c == EOF || c == '\n'){
+					src.get();
+					break;
+				}
+
+				if(c == '\r' || c == ' ' || c == '\t' || c == '"'){
+					src.get();
+				}else if(c == delimiter){
+					src.get();
+					column++;
+				}else if(column == x_column || column == y_column){
+					double v;
+					if(!number(v))
+						return false;
+
+					if(column == x_column)
+						axis[0] = v;
+					if(column == y_column)
+						axis[1] = v;
+
+					found++;
+					blank = false;
+				}else{
+					src.get();
+					blank = false;
+				}
+			}
+
+			if(blank && column == 0)
+				continue;
+
+			if(found < (x_column == y_column ? 1 : 2) || column < last)
+				return fail("missing column");
+
+			sink.point(point2d{ axis[0], axis[1] });
+			count++;
+		}
+
+		return true;
+	}
+
+private:
+	text_source src;
+	sink_type& sink;
+	const char* error;
+	size_t error_at;
+	size_t count;
+	size_t nesting;
+
+	bool fail(const char* e)
+	{
+		if(!error){
+			error = e;
+			error_at = src.offset();
+		}
+
+		return false;
+	}
+
+	/*
+	 * counts a level of nesting, the parse stops past `text_max_depth`
+	 */
+	bool enter()
+	{
+		if(nesting == text_max_depth)
+			return fail("nested too deep");
+
+		nesting++;
+		return true;
+	}
+
+	bool leave(bool ok)
+	{
+		nesting--;
+		return ok;
+	}
+
+	void empty_polygon()
+	{
+		sink.begin_polygon();
+		sink.end_polygon();
+		count++;
+	}
+
+	bool expect(char c)
+	{
+		if(src.skip_space() != c)
+			return fail("unexpected character");
+
+		src.get();
+		return true;
+	}
+
+	static bool is_number_char(int c)
+	{
+		return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.'
+			|| c == 'e' || c == 'E';
+	}
+
+	/*
+	 * parses a number with `std::from_chars`, the leading `+` it does not
+	 * accept is skipped, and so are the `inf` and `nan` it accepts. The
+	 * number is parsed in place when it ends before the end of the chunk
+	 * at a character that cannot go on a number, otherwise it may go on
+	 * in the next chunk, e.g., "1e|5", and it is copied first.
+	 */
+	bool number(double& v)
+	{
+		char token[64];
+		size_t n = 0;
+
+		int c = src.skip_space();
+		if(c == '+'){
+			src.get();
+			c = src.peek();
+		}
+
+		if(!is_number_char(c))
+			return fail("invalid number");
+
+		const char* first = src.cursor();
+		std::from_chars_result in_place =
+			std::from_chars(first, src.chunk_end(), v);
+
+		if(in_place.ec == std::errc() && in_place.ptr != src.chunk_end()
+			&& is_number_char(in_place.ptr[-1])
+			&& !is_number_char(*in_place.ptr)){
+			src.advance(in_place.ptr - first);
+			return true;
+		}
+
+		while(is_number_char(c)){
+			if(n == sizeof(token))
+				return fail("number too long");
+
+			token[n++] = char(c);
+			src.get();
+			c = src.peek();
+		}
+
+		std::from_chars_result r = std::from_chars(token, token + n, v);
+		if(n == 0 || r.ec != std::errc() || r.ptr != token + n)
+			return fail("invalid number");
+
+		return true;
+	}
+
+	static bool is_letter(int c)
+	{
+		return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+	}
+
+	/*
+	 * reads a word in upper case, it is truncated to the size of `word`
+	 */
+	void word(char (&w)[24])
+	{
+		size_t n = 0;
+		int c = src.skip_space();
+
+		while(is_letter(c)){
+			if(n + 1 < sizeof(w))
+				w[n++] = char(c >= 'a' ? c - 'a' + 'A' : c);
+			src.get();
+			c = src.peek();
+		}
+
+		w[n] = '\0';
+	}
+
+	/*
+	 * WKT
+	 */
+
+	bool wkt_coordinate(point2d& p)
+	{
+		if(!number(p.x()) || !number(p.y()))
+			return false;
+
+		/*
+		 * z and m are skipped
+		 */
+		double ignored;
+		for(int c = src.skip_space(); c != ',' && c != ')'; c = src.skip_space())
+			if(!number(ignored))
+				return false;
+
+		return true;
+	}
+
+	/*
+	 * a list of coordinates between parenthesis, given to `f`
+	 */
+	template<typename function>
+	bool wkt_coordinates(function f)
+	{
+		if(!expect('('))
+			return false;
+
+		do{
+			/*
+			 * the points of a multipoint may have parenthesis
+			 */
+			bool nested = src.skip_space() == '(';
+			if(nested)
+				src.get();
+
+			point2d p;
+			if(!wkt_coordinate(p))
+				return false;
+
+			f(p);
+
+			if(nested && !expect(')'))
+				return false;
+		}while(src.skip_space() == ',' && src.get());
+
+		return expect(')');
+	}
+
+	/*
+	 * checks for the EMPTY keyword after the type
+	 */
+	bool wkt_empty()
+	{
+		if(!is_letter(src.skip_space()))
+			return false;
+
+		char w[24];
+		word(w);
+		return !std::strcmp(w, "EMPTY");
+	}
+
+	bool wkt_polygon()
+	{
+		if(src.skip_space() != '('){
+			if(!wkt_empty())
+				return fail("expected a polygon");
+
+			empty_polygon();
+			return true;
+		}
+
+		src.get();
+		sink.begin_polygon();
+
+		do{
+			if(!wkt_coordinates([&](const point2d& p){ sink.vertex(p); }))
+				return false;
+
+			sink.end_ring();
+		}while(src.skip_space() == ',' && src.get());
+
+		sink.end_polygon();
+		count++;
+
+		return expect(')');
+	}
+
+	/*
+	 * a parenthesized list of elements parsed by `element`
+	 */
+	template<typename function>
+	bool wkt_list(function element)
+	{
+		if(src.skip_space() != '(')
+			return wkt_empty() || fail("expected a list");
+
+		src.get();
+
+		do{
+			if(!element())
+				return false;
+		}while(src.skip_space() == ',' && src.get());
+
+		return expect(')');
+	}
+
+	bool wkt_geometry()
+	{
+		char type[24];
+		word(type);
+
+		/*
+		 * SRID=<n>; of the extended WKT
+		 */
+		if(!std::strcmp(type, "SRID")){
+			int c;
+			do{
+				c = src.get();
+			}while(c != ';' && c != EOF);
+
+			word(type);
+		}
+
+		/*
+		 * the dimension modifiers Z, M and ZM
+		 */
+		if(is_letter(src.skip_space())){
+			char modifier[24];
+			word(modifier);
+
+			if(!std::strcmp(modifier, "EMPTY")){
+				if(!std::strcmp(type, "POLYGON"))
+					empty_polygon();
+				return true;
+			}
+		}
+
+		auto points = [&](const point2d& p){
+			sink.point(p);
+			count++;
+		};
+
+		auto ignore = [](const point2d&){};
+
+		if(!std::strcmp(type, "POINT")){
+			if(src.skip_space() != '(')
+				return wkt_empty() || fail("expected a point");
+			return wkt_coordinates(points);
+		}else if(!std::strcmp(type, "MULTIPOINT")){
+			if(src.skip_space() != '(')
+				return wkt_empty() || fail("expected a point list");
+			return wkt_coordinates(points);
+		}else if(!std::strcmp(type, "LINESTRING")){
+			if(src.skip_space() != '(')
+				return wkt_empty() || fail("expected a point list");
+			return wkt_coordinates(ignore);
+		}else if(!std::strcmp(type, "MULTILINESTRING")){
+			return wkt_list([&]{ return wkt_coordinates(ignore); });
+		}else if(!std::strcmp(type, "POLYGON")){
+			return wkt_polygon();
+		}else if(!std::strcmp(type, "MULTIPOLYGON")){
+			return wkt_list([&]{ return wkt_polygon(); });
+		}else if(!std::strcmp(type, "GEOMETRYCOLLECTION")){
+			return enter() && leave(wkt_list([&]{ return wkt_geometry(); }));
+		}
+
+		return fail("unknown geometry type");
+	}
+
+	/*
+	 * GeoJSON
+	 */
+
+	/*
+	 * reads a string, `s` receives its first characters
+	 */
+	bool json_string(char (&s)[24])
+	{
+		size_t n = 0;
+
+		if(!expect('"'))
+			return false;
+
+		while(true){
+			int c = src.get();
+			if(c == EOF)
+				return fail("unterminated string");
+			else if(c == '"')
+				break;
+			else if(c == '\\')
+				c = src.get();
+
+			if(n + 1 < sizeof(s))
+				s[n++] = char(c);
+		}
+
+		s[n] = '\0';
+		return true;
+	}
+
+	bool json_value()
+	{
+		char s[24];
+		double v;
+		int c = src.skip_space();
+
+		switch(c){
+		case '{':
+			return enter() && leave(json_object());
+		case '[':
+			return enter() && leave(json_array());
+		case '"':
+			return json_string(s);
+		case 't':
+		case 'f':
+		case 'n':
+			word(s);
+			return true;
+		}
+
+		return number(v);
+	}
+
+	bool json_array()
+	{
+		src.get();
+		if(src.skip_space() == ']'){
+			src.get();
+			return true;
+		}
+
+		do{
+			if(!json_value())
+				return false;
+		}while(src.skip_space() == ',' && src.get());
+
+		return expect(']');
+	}
+
+	/*
+	 * nesting of the coordinates of the `type`, 0 when it is not known
+	 */
+	static int json_depth(const char* type)
+	{
+		if(!std::strcmp(type, "Point"))
+			return 1;
+		if(!std::strcmp(type, "MultiPoint") || !std::strcmp(type, "LineString"))
+			return 2;
+		if(!std::strcmp(type, "Polygon") || !std::strcmp(type, "MultiLineString"))
+			return 3;
+		if(!std::strcmp(type, "MultiPolygon"))
+			return 4;
+		return 0;
+	}
+
+	static bool json_lines(const char* type)
+	{
+		return !std::strcmp(type, "LineString")
+			|| !std::strcmp(type, "MultiLineString");
+	}
+
+	bool json_object()
+	{
+		char key[24];
+		char type[24] = "";
+
+		/*
+		 * coordinates read before the type, they are taken back if the
+		 * type turns out to be a line
+		 */
+		bool untyped = false;
+		typename sink_type::mark before{};
+		size_t count_before = 0;
+		size_t count_after = 0;
+
+		src.get();
+		if(src.skip_space() == '}'){
+			src.get();
+			return true;
+		}
+
+		do{
+			if(!json_string(key) || !expect(':'))
+				return false;
+
+			if(!std::strcmp(key, "type") && src.skip_space() == '"'){
+				if(!json_string(type))
+					return false;
+			}else if(!std::strcmp(key, "coordinates")){
+				if(!type[0]){
+					untyped = true;
+					before = sink.position();
+					count_before = count;
+				}
+
+				if(!json_coordinates(type))
+					return false;
+
+				count_after = count;
+			}else if(!json_value()){
+				return false;
+			}
+		}while(src.skip_space() == ',' && src.get());
+
+		if(!expect('}'))
+			return false;
+
+		if(untyped && json_lines(type)){
+			if(count != count_after)
+				return fail("line coordinates before the type");
+
+			sink.rollback(before);
+			count = count_before;
+		}
+
+		return true;
+	}
+
+	/*
+	 * coordinates of a geometry, the type or else the nesting of the
+	 * arrays tells the kind of the geometry: 1 is a point, 2 is a list of
+	 * points, 3 is a polygon and 4 is a list of polygons. The lines are skipped when the
+	 * type comes before the coordinates, otherwise `json_object` takes
+	 * them back once it reads the type. An empty array is an empty
+	 * polygon at the level of the polygons and is skipped at the others.
+	 */
+	bool json_coordinates(const char* type)
+	{
+		const bool lines = json_lines(type);
+
+		int opened = 0;
+		while(src.skip_space() == '['){
+			src.get();
+			opened++;
+		}
+
+		if(opened == 0)
+			return json_value();
+
+		/*
+		 * the type tells the nesting even when the first element is
+		 * empty, otherwise the arrays opened down to the first number do
+		 */
+		int depth = json_depth(type);
+		if(!depth)
+			depth = opened;
+
+		if(opened > depth || depth > 4)
+			return fail("coordinates nested too deep");
+
+		/*
+		 * ring and polygon levels of the arrays
+		 */
+		const int ring = (depth >= 3) ? depth - 1 : 0;
+		const int poly = (depth >= 3) ? depth - 2 : 0;
+
+		auto open = [&](int level){
+			if(lines)
+				return;
+			if(level == poly)
+				sink.begin_polygon();
+		};
+
+		auto close = [&](int level){
+			if(lines)
+				return;
+			if(level == ring){
+				sink.end_ring();
+			}else if(level == poly){
+				sink.end_polygon();
+				count++;
+			}
+		};
+
+		for(int level=1; level<=opened; level++)
+			open(level);
+
+		int level = opened;
+		while(level){
+			if(level == depth && src.skip_space() != ']'){
+				point2d p;
+
+				if(!number(p.x()) || !expect(',') || !number(p.y()))
+					return false;
+
+				/*
+				 * the altitude is skipped
+				 */
+				double ignored;
+				while(src.skip_space() == ','){
+					src.get();
+					if(!number(ignored))
+						return false;
+				}
+
+				if(!expect(']'))
+					return false;
+
+				if(!lines){
+					if(depth >= 3){
+						sink.vertex(p);
+					}else{
+						sink.point(p);
+						count++;
+					}
+				}
+
+				level--;
+			}
+
+			/*
+			 * close the arrays until the next element, an empty one
+			 * among them
+			 */
+			while(level && src.skip_space() == ']'){
+				src.get();
+				close(level);
+				level--;
+			}
+
+			if(!level)
+				break;
+
+			if(!expect(','))
+				return false;
+
+			/*
+			 * open the arrays of the next element down to its point,
+			 * unless one of them is empty
+			 */
+			while(level < depth){
+				if(!expect('['))
+					return false;
+
+				level++;
+				open(level);
+
+				if(src.skip_space() == ']')
+					break;
+			}
+		}
+
+		return true;
+	}
+};
+
+/*
+ * runs the parser `parse` and throws the error of the `format`
+ */
+template<typename function>
+size_t parse_text(std::istream& in, polygon_set2d& polygons,
+	point_buffer2d* points, const char* format, function parse)
+{
+	polygon_set_sink sink(polygons, points);
+	polygon_set_sink::mark start = sink.position();
+	text_parser<polygon_set_sink> parser(in, sink);
+
+	if(!parse(parser)){
+		sink.rollback(start);
+		GMT_THROW(exception(parser.message(format)));
+	}
+
+	return parser.geometries();
+}
+
+template<typename function>
+std::optional<size_t> try_parse_text(std::istream& in,
+	polygon_set2d& polygons, point_buffer2d* points, function parse)
+{
+	polygon_set_sink sink(polygons, points);
+	polygon_set_sink::mark start = sink.position();
+	text_parser<polygon_set_sink> parser(in, sink);
+
+	if(!parse(parser)){
+		sink.rollback(start);
+		return std::nullopt;
+	}
+
+	return parser.geometries();
+}
+
+/**
+  * Reads the WKT geometries of `in`, separated by white spaces or `;`.
+  * The polygons and multipolygons are appended to `polygons` and the
+  * points and multipoints to `points`, if it is not null. The line
+  * strings are skipped.
+  *
+  * @return the number of polygons and points read
+  */
+inline size_t read_wkt(
+	std::istream& in,
+	polygon_set2d& polygons,
+	point_buffer2d* points = nullptr)
+{
+	return parse_text(in, polygons, points, "read_wkt",
+		[](auto& p){ return p.wkt(); });
+}
+
+inline std::optional<size_t> try_read_wkt(
+	std::istream& in,
+	polygon_set2d& polygons,
+	point_buffer2d* points = nullptr)
+{
+	return try_parse_text(in, polygons, points,
+		[](auto& p){ return p.wkt(); });
+}
+
+/**
+  * Reads the geometries of GeoJSON values, e.g., a FeatureCollection, a
+  * Feature or a bare geometry, one after another if there are many. The
+  * polygons and multipolygons are appended to `polygons` and the points
+  * and multipoints to `points`, if it is not null.
+  *
+  * @return the number of polygons and points read
+  */
+inline size_t read_geojson(
+	std::istream& in,
+	polygon_set2d& polygons,
+	point_buffer2d* points = nullptr)
+{
+	return parse_text(in, polygons, points, "read_geojson",
+		[](auto& p){ return p.geojson(); });
+}
+
+inline std::optional<size_t> try_read_geojson(
+	std::istream& in,
+	polygon_set2d& polygons,
+	point_buffer2d* points = nullptr)
+{
+	return try_parse_text(in, polygons, points,
+		[](auto& p){ return p.geojson(); });
+}
+
+/**
+  * Reads a point per line of the CSV `in`, the coordinates are the
+  * columns `x_column` and `y_column` and the other columns are skipped.
+  *
+  * @param header	whether the first line is a header to skip
+  * @return the number of points read
+  */
+inline size_t read_csv(
+	std::istream& in,
+	point_buffer2d& points,
+	char delimiter = ',',
+	bool header = false,
+	size_t x_column = 0,
+	size_t y_column = 1)
+{
+	polygon_set2d none;
+	return parse_text(in, none, &points, "read_csv",
+		[&](auto& p){
+			return p.csv(delimiter, header, x_column, y_column);
+		});
+}
+
+inline std::optional<size_t> try_read_csv(
+	std::istream& in,
+	point_buffer2d& points,
+	char delimiter = ',',
+	bool header = false,
+	size_t x_column = 0,
+	size_t y_column = 1)
+{
+	polygon_set2d none;
+	return try_parse_text(in, none, &points,
+		[&](auto& p){
+			return p.csv(delimiter, header, x_column, y_column);
+		});
+}
+
+/*
+ * output buffered in chunks, the numbers are written by `std::to_chars`
+ * in their shortest form that reads back the same
+ */
+class text_output {
+public:
+	explicit text_output(std::ostream& out)
+		: out(out), n(0)
+	{}
+
+	~text_output()
+	{
+		flush();
+	}
+
+	void put(char c)
+	{
+		if(n == sizeof(buffer))
+			flush();
+
+		buffer[n++] = c;
+	}
+
+	void put(const char* s)
+	{
+		for(; *s; s++)
+			put(*s);
+	}
+
+	void number(double v)
+	{
+		if(sizeof(buffer) - n < 32)
+			flush();
+
+		std::to_chars_result r = std::to_chars(
+			buffer + n,
+			buffer + sizeof(buffer),
+			v);
+		n = r.ptr - buffer;
+	}
+
+	void flush()
+	{
+		out.write(buffer, n);
+		n = 0;
+	}
+
+private:
+	std::ostream& out;
+	char buffer[text_chunk_size];
+	size_t n;
+};
+
+/*
+ * the writers throw before writing anything if a coordinate is not
+ * finite
+ */
+template<typename container>
+void check_finite(const container& points, const char* format)
+{
+	for(const point2d& p : points)
+		if(!std::isfinite(p.x()) || !std::isfinite(p.y()))
+			GMT_THROW(exception(std::string(format) + ": coordinate not finite"));
+}
+
+inline void check_finite(const polygon_view2d& poly, const char* format)
+{
+	for(size_t r=0; r<poly.n_rings(); r++)
+		check_finite(poly.ring(r), format);
+}
+
+inline void check_finite(const polygon_set_view2d& set, const char* format)
+{
+	for(auto poly : set)
+		check_finite(poly, format);
+}
+
+/*
+ * whether the polygon has a ring that is not empty, the empty rings are
+ * not written
+ */
+inline bool has_vertices(const polygon_view2d& poly)
+{
+	for(size_t r=0; r<poly.n_rings(); r++)
+		if(!poly.ring(r).empty())
+			return true;
+
+	return false;
+}
+
+/*
+ * WKT
+ */
+
+inline void wkt_ring(text_output& o, const ring_view2d& ring)
+{
+	o.put('(');
+	for(size_t i=0; i<=ring.size() && !ring.empty(); i++){
+		const point2d& p = ring[i%ring.size()];
+		if(i)
+			o.put(", ");
+		o.number(p.x());
+		o.put(' ');
+		o.number(p.y());
+	}
+	o.put(')');
+}
+
+inline void wkt_polygon(text_output& o, const polygon_view2d& poly)
+{
+	if(!has_vertices(poly)){
+		o.put("POLYGON EMPTY");
+		return;
+	}
+
+	o.put("POLYGON (");
+	bool first = true;
+	for(size_t r=0; r<poly.n_rings(); r++){
+		if(poly.ring(r).empty())
+			continue;
+		if(!first)
+			o.put(", ");
+		wkt_ring(o, poly.ring(r));
+		first = false;
+	}
+	o.put(')');
+}
+
+inline void write_wkt(std::ostream& out, const point2d& p)
+{
+	check_finite(std::initializer_list<point2d>{ p }, "write_wkt");
+
+	text_output o(out);
+	o.put("POINT (");
+	o.number(p.x());
+	o.put(' ');
+	o.number(p.y());
+	o.put(')');
+}
+
+/** @brief writes the polygon `ring`, e.g., a hull or a visibility
+  *  polygon, as a WKT POLYGON
+  */
+inline void write_wkt(std::ostream& out, const ring_view2d& ring)
+{
+	check_finite(ring, "write_wkt");
+
+	text_output o(out);
+
+	if(ring.empty()){
+		o.put("POLYGON EMPTY");
+		return;
+	}
+
+	o.put("POLYGON (");
+	wkt_ring(o, ring);
+	o.put(')');
+}
+
+inline void write_wkt(std::ostream& out, const polygon_view2d& poly)
+{
+	check_finite(poly, "write_wkt");
+
+	text_output o(out);
+	wkt_polygon(o, poly);
+}
+
+inline void write_wkt(std::ostream& out, const polygon_with_holes2d& poly)
+{
+	polygon_set2d set;
+	set.add_polygon(poly);
+	write_wkt(out, set[0]);
+}
+
+/** @brief writes every polygon of the set as a WKT POLYGON in a line
+  */
+inline void write_wkt(std::ostream& out, const polygon_set_view2d& set)
+{
+	check_finite(set, "write_wkt");
+
+	text_output o(out);
+	for(auto poly : set){
+		wkt_polygon(o, poly);
+		o.put('\n');
+	}
+}
+
+inline void write_wkt(std::ostream& out, const polygon_set2d& set)
+{
+	write_wkt(out, set.view());
+}
+
+/*
+ * GeoJSON
+ */
+
+inline void geojson_ring(text_output& o, const ring_view2d& ring)
+{
+	o.put('[');
+	for(size_t i=0; i<=ring.size() && !ring.empty(); i++){
+		const point2d& p = ring[i%ring.size()];
+		if(i)
+			o.put(',');
+		o.put('[');
+		o.number(p.x());
+		o.put(',');
+		o.number(p.y());
+		o.put(']');
+	}
+	o.put(']');
+}
+
+inline void geojson_polygon(text_output& o, const polygon_view2d& poly)
+{
+	o.put('[');
+	bool first = true;
+	for(size_t r=0; r<poly.n_rings(); r++){
+		if(poly.ring(r).empty())
+			continue;
+		if(!first)
+			o.put(',');
+		geojson_ring(o, poly.ring(r));
+		first = false;
+	}
+	o.put(']');
+}
+
+/** @brief writes the polygon `ring` as a GeoJSON Polygon geometry
+  */
+inline void write_geojson(std::ostream& out, const ring_view2d& ring)
+{
+	check_finite(ring, "write_geojson");
+
+	text_output o(out);
+	o.put("{\"type\":\"Polygon\",\"coordinates\":[");
+	if(!ring.empty())
+		geojson_ring(o, ring);
+	o.put("]}");
+}
+
+inline void write_geojson(std::ostream& out, const polygon_view2d& poly)
+{
+	check_finite(poly, "write_geojson");
+
+	text_output o(out);
+	o.put("{\"type\":\"Polygon\",\"coordinates\":");
+	geojson_polygon(o, poly);
+	o.put('}');
+}
+
+inline void write_geojson(std::ostream& out, const polygon_with_holes2d& poly)
+{
+	polygon_set2d set;
+	set.add_polygon(poly);
+	write_geojson(out, set[0]);
+}
+
+/** @brief writes the set as a GeoJSON MultiPolygon geometry
+  */
+inline void write_geojson(std::ostream& out, const polygon_set_view2d& set)
+{
+	check_finite(set, "write_geojson");
+
+	text_output o(out);
+	o.put("{\"type\":\"MultiPolygon\",\"coordinates\":[");
+	for(size_t i=0; i<set.size(); i++){
+		if(i)
+			o.put(',');
+		geojson_polygon(o, set[i]);
+	}
+	o.put("]}");
+}
+
+inline void write_geojson(std::ostream& out, const polygon_set2d& set)
+{
+	write_geojson(out, set.view());
+}
+
+/*
+ * CSV
+ */
+
+/** @brief writes a point per line of the container of points `points`,
+  *  e.g., a `point_buffer2d` or a `polygon2d`
+  */
+template<typename container>
+void write_csv(std::ostream& out, const container& points, char delimiter = ',')
+{
+	check_finite(points, "write_csv");
+
+	text_output o(out);
+	for(const point2d& p : points){
+		o.number(p.x());
+		o.put(delimiter);
+		o.number(p.y());
+		o.put('\n');
+	}
+}
+
+}
+
+}
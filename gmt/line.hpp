@@ -11,29 +11,44 @@ public:
 	vec<T, n_dimension> sense;
 	vec<T, n_dimension> shift;
 
-	line()
+	constexpr line() noexcept
 	{}
 
-	line(	const point<T, n_dimension>& p0,
-		const point<T, n_dimension>& p1)
+	constexpr line(	const point<T, n_dimension>& p0,
+		const point<T, n_dimension>& p1) noexcept
 		: sense(p1 - p0), shift(p0)
 	{}
 
-	line(	const segment<T, n_dimension>& seg)
+	constexpr line(	const segment<T, n_dimension>& seg) noexcept
 		: line(seg.from, seg.to)
 	{}
 
-	line(	const vec<T, n_dimension>& v)
+	constexpr line(	const vec<T, n_dimension>& v) noexcept
 		: line(point<T, n_dimension>(), v)
 	{}
 
-	virtual ~line()
-	{}
-
-	point<T, n_dimension> point_on_line_at(
-		const T& scalar) const
+	/**
+	  * the point `shift + scalar*sense`. On a line of integer axes the
+	  * scalar may be real, e.g. the `double` scalars of `intersect_scalars`:
+	  * the point is computed in `double` and rounded to the nearest one of
+	  * the grid, halves away from zero.
+	  */
+	template<typename S>
+	constexpr point<T, n_dimension> point_on_line_at(
+		const S& scalar) const noexcept
 	{
-		return shift + sense*scalar;
+		if constexpr(std::is_integral<T>::value && std::is_floating_point<S>::value){
+			point<T, n_dimension> p;
+
+			for(std::size_t i=0; i<n_dimension; i++){
+				double x = double(shift[i]) + double(sense[i])*double(scalar);
+				p[i] = T((x < 0.0) ? x - 0.5 : x + 0.5);
+			}
+
+			return p;
+		}else{
+			return shift + sense*T(scalar);
+		}
 	}
 
 	std::ostream& print(
@@ -62,4 +77,9 @@ typedef line<float, 3>	line3f;
 typedef line<int, 2>	line2i;
 typedef line<int, 3>	line3i;
 
+static_assert(std::is_trivially_copyable<line2d>::value,
+	"line2d must be trivially copyable");
+static_assert(std::is_standard_layout<line2d>::value,
+	"line2d must have standard layout");
+
 }
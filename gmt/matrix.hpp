@@ -5,6 +5,8 @@
 #include <cstdlib>
 #include <stdexcept>
 
+#include <gmt/exception.hpp>
+
 namespace gmt {
 template<typename T>
 
@@ -79,8 +81,8 @@ public:
 	{
 
 		if(other.n_row != n_row || other.n_col != n_col)
-			throw exception("operator+: the matrix must have the "
-					"same size to perform this operation");
+			GMT_THROW(exception("operator+: the matrix must have the "
+					"same size to perform this operation"));
 
 		matrix<T> m(n_row, n_col);
 		for(size_t i=0; i<n_row; i++)
@@ -94,8 +96,8 @@ public:
 	{
 
 		if(other.n_row != n_row || other.n_col != n_col)
-			throw exception("operator+: the matrix must have the "
-					"same size to perform this operation");
+			GMT_THROW(exception("operator+: the matrix must have the "
+					"same size to perform this operation"));
 
 		matrix<T> m(n_row, n_col);
 		for(size_t i=0; i<n_row; i++)
@@ -108,8 +110,8 @@ public:
 	matrix<T> operator*(const matrix<T>& other) const
 	{
 		if(n_col != other.n_row)
-			throw exception("operator*: the matrices must have the "
-					"same number of columns and rows");
+			GMT_THROW(exception("operator*: the matrices must have the "
+					"same number of columns and rows"));
 		matrix<T> m(n_row, other.n_col);
 
 		for(size_t i = 0; i<n_row ; i++)
@@ -0,0 +1,513 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <gmt/point.hpp>
+
+namespace gmt {
+
+/**
+  * Structure-of-arrays container of points.
+  *
+  * Instead of storing `point`s one after another, every axis is stored in
+  * its own contiguous column, i.e., all the x values, then all the y
+  * values and so on. Every column starts at a `alignment` byte boundary
+  * and its length is padded to a multiple of `alignment` bytes, so batch
+  * kernels can stream a column with full-width aligned loads and read
+  * past `size()` up to `capacity()` without leaving the allocation. The
+  * padding is always zero.
+  *
+  * All columns share one allocation. A buffer may also borrow its
+  * columns from memory it does not own, e.g., a mapped file, see
+  * `borrow`. A borrowed buffer is read in place and copies its columns to
+  * an allocation of its own before the first modification.
+  *
+  * @tparam T		type of the axes
+  * @tparam n_dimension	number of axes of the points
+  */
+template<typename T = double, std::size_t n_dimension = 2>
+class point_buffer {
+	static_assert(std::is_trivially_copyable<T>::value,
+		"point_buffer requires a trivially copyable axis type");
+	static_assert(n_dimension > 0,
+		"point_buffer requires at least one dimension");
+
+public:
+	static constexpr std::size_t alignment = 64;
+
+	typedef point<T, n_dimension> value_type;
+	typedef std::size_t size_type;
+
+	/** read-only iterator, dereferencing builds the point from the
+	  * columns
+	  */
+	class const_iterator {
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef point<T, n_dimension> value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const value_type* pointer;
+		typedef value_type reference;
+
+		const_iterator() noexcept
+			: buffer(nullptr), index(0)
+		{}
+
+		const_iterator(const point_buffer* buffer, size_t index) noexcept
+			: buffer(buffer), index(index)
+		{}
+
+		value_type operator*() const noexcept
+		{
+			return (*buffer)[index];
+		}
+
+		value_type operator[](difference_type n) const noexcept
+		{
+			return (*buffer)[index + n];
+		}
+
+		const_iterator& operator++() noexcept
+		{
+			index++;
+			return *this;
+		}
+
+		const_iterator operator++(int) noexcept
+		{
+			const_iterator tmp = *this;
+			index++;
+			return tmp;
+		}
+
+		const_iterator& operator--() noexcept
+		{
+			index--;
+			return *this;
+		}
+
+		const_iterator operator--(int) noexcept
+		{
+			const_iterator tmp = *this;
+			index--;
+			return tmp;
+		}
+
+		const_iterator& operator+=(difference_type n) noexcept
+		{
+			index += n;
+			return *this;
+		}
+
+		const_iterator& operator-=(difference_type n) noexcept
+		{
+			index -= n;
+			return *this;
+		}
+
+		const_iterator operator+(difference_type n) const noexcept
+		{
+			return const_iterator(buffer, index + n);
+		}
+
+		const_iterator operator-(difference_type n) const noexcept
+		{
+			return const_iterator(buffer, index - n);
+		}
+
+		difference_type operator-(const const_iterator& i) const noexcept
+		{
+			return static_cast<difference_type>(index)
+				- static_cast<difference_type>(i.index);
+		}
+
+		bool operator==(const const_iterator& i) const noexcept
+		{
+			return index == i.index;
+		}
+
+		bool operator!=(const const_iterator& i) const noexcept
+		{
+			return index != i.index;
+		}
+
+		bool operator<(const const_iterator& i) const noexcept
+		{
+			return index < i.index;
+		}
+
+	private:
+		const point_buffer* buffer;
+		size_t index;
+	};
+
+	typedef const_iterator iterator;
+
+	point_buffer() noexcept
+		: m_data(nullptr), m_size(0), m_capacity(0), m_owner(true)
+	{}
+
+	/** @brief buffer that reads the columns stored from `data`, with the
+	  *  layout of the buffer: one column after another, each one with
+	  *  `capacity` values and aligned to `alignment` bytes, with the
+	  *  values after `size` equal to zero. The memory must outlive the
+	  *  buffer and it is never written.
+	  *
+	  * @param capacity	must be a multiple of the number of values in
+	  *			`alignment` bytes
+	  */
+	static point_buffer borrow(
+		const T* data,
+		size_t size,
+		size_t capacity) noexcept
+	{
+		point_buffer b;
+		b.m_data = const_cast<T*>(data);
+		b.m_size = size;
+		b.m_capacity = capacity;
+		b.m_owner = false;
+		return b;
+	}
+
+	/** @brief constructs a buffer with `n` points in the origin
+	  */
+	explicit point_buffer(size_t n)
+		: point_buffer()
+	{
+		resize(n);
+	}
+
+	point_buffer(const std::initializer_list<point<T, n_dimension>>& l)
+		: point_buffer(l.begin(), l.end())
+	{}
+
+	/** @brief constructs the buffer from a range of points
+	  */
+	template<typename input_iterator>
+	point_buffer(input_iterator first, input_iterator last)
+		: point_buffer()
+	{
+		typedef typename std::iterator_traits<input_iterator>::iterator_category
+			category;
+
+		if(std::is_base_of<std::forward_iterator_tag, category>::value)
+			reserve(std::distance(first, last));
+
+		for(; first != last; ++first)
+			push_back(*first);
+	}
+
+	/** @brief constructs the buffer from a container of points, e.g.,
+	  * a `polygon` or a `std::vector<point>`
+	  */
+	template<
+		typename container,
+		typename = decltype(std::declval<const container&>().begin())
+	>
+	explicit point_buffer(const container& c)
+		: point_buffer(c.begin(), c.end())
+	{}
+
+	point_buffer(const point_buffer& b)
+		: point_buffer()
+	{
+		reserve(b.m_size);
+		copy_columns(b);
+	}
+
+	point_buffer(point_buffer&& b) noexcept
+		: m_data(b.m_data),
+		  m_size(b.m_size),
+		  m_capacity(b.m_capacity),
+		  m_owner(b.m_owner)
+	{
+		b.m_data = nullptr;
+		b.m_size = 0;
+		b.m_capacity = 0;
+		b.m_owner = true;
+	}
+
+	~point_buffer()
+	{
+		if(m_owner)
+			deallocate(m_data);
+	}
+
+	point_buffer& operator=(const point_buffer& b)
+	{
+		if(this != &b){
+			clear();
+			reserve(b.m_size);
+			copy_columns(b);
+		}
+
+		return *this;
+	}
+
+	point_buffer& operator=(point_buffer&& b) noexcept
+	{
+		std::swap(m_data, b.m_data);
+		std::swap(m_size, b.m_size);
+		std::swap(m_capacity, b.m_capacity);
+		std::swap(m_owner, b.m_owner);
+		return *this;
+	}
+
+	size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	/** @brief number of points the columns can hold, it is always a
+	  * multiple of the number of values in `alignment` bytes
+	  */
+	size_t capacity() const noexcept
+	{
+		return m_capacity;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	/** @brief checks whether the columns are borrowed, see `borrow`
+	  */
+	bool borrowed() const noexcept
+	{
+		return !m_owner;
+	}
+
+	constexpr std::size_t ndim() const noexcept
+	{
+		return n_dimension;
+	}
+
+	void reserve(size_t n)
+	{
+		if(n <= m_capacity && m_owner)
+			return;
+
+		size_t capacity = padded(std::max(n, m_capacity));
+		T* data = allocate(capacity);
+
+		for(size_t a=0; a<n_dimension; a++){
+			if(m_size)
+				std::memcpy(
+					data + a*capacity,
+					m_data + a*m_capacity,
+					m_size*sizeof(T));
+
+			std::memset(
+				data + a*capacity + m_size,
+				0,
+				(capacity - m_size)*sizeof(T));
+		}
+
+		if(m_owner)
+			deallocate(m_data);
+
+		m_data = data;
+		m_capacity = capacity;
+		m_owner = true;
+	}
+
+	void resize(size_t n)
+	{
+		if(n > m_capacity || !m_owner)
+			reserve(n);
+
+		/*
+		 * keep the padding after the last point zeroed
+		 */
+		if(n < m_size){
+			for(size_t a=0; a<n_dimension; a++)
+				std::memset(
+					column(a) + n,
+					0,
+					(m_size - n)*sizeof(T));
+		}
+
+		m_size = n;
+	}
+
+	void clear() noexcept
+	{
+		if(!m_owner){
+			*this = point_buffer();
+			return;
+		}
+
+		if(m_size)
+			for(size_t a=0; a<n_dimension; a++)
+				std::memset(column(a), 0, m_size*sizeof(T));
+
+		m_size = 0;
+	}
+
+	void push_back(const point<T, n_dimension>& p)
+	{
+		if(m_size == m_capacity)
+			reserve(m_capacity ? 2*m_capacity : 1);
+		else if(!m_owner)
+			reserve(m_capacity);
+
+		for(size_t a=0; a<n_dimension; a++)
+			column(a)[m_size] = p[a];
+
+		m_size++;
+	}
+
+	void pop_back()
+	{
+		if(!m_owner)
+			reserve(m_capacity);
+
+		m_size--;
+
+		for(size_t a=0; a<n_dimension; a++)
+			column(a)[m_size] = 0;
+	}
+
+	/** @brief builds the point `i` from the columns
+	  */
+	point<T, n_dimension> operator[](size_t i) const noexcept
+	{
+		point<T, n_dimension> p;
+
+		for(size_t a=0; a<n_dimension; a++)
+			p[a] = column(a)[i];
+
+		return p;
+	}
+
+	/** @brief writes the point `p` in the position `i`
+	  */
+	void set(size_t i, const point<T, n_dimension>& p)
+	{
+		for(size_t a=0; a<n_dimension; a++)
+			column(a)[i] = p[a];
+	}
+
+	/** @brief pointer to the column of the axis `a`, it is aligned to
+	  * `alignment` bytes. A borrowed buffer copies its columns first.
+	  */
+	T* column(size_t a)
+	{
+		if(!m_owner)
+			reserve(m_capacity);
+
+		return m_data + a*m_capacity;
+	}
+
+	const T* column(size_t a) const noexcept
+	{
+		return m_data + a*m_capacity;
+	}
+
+	T* x() { return column(0); }
+	const T* x() const noexcept { return column(0); }
+
+	T* y()
+	{
+		static_assert(n_dimension > 1, "the buffer has no y axis");
+		return column(1);
+	}
+
+	const T* y() const noexcept
+	{
+		static_assert(n_dimension > 1, "the buffer has no y axis");
+		return column(1);
+	}
+
+	T* z()
+	{
+		static_assert(n_dimension > 2, "the buffer has no z axis");
+		return column(2);
+	}
+
+	const T* z() const noexcept
+	{
+		static_assert(n_dimension > 2, "the buffer has no z axis");
+		return column(2);
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return const_iterator(this, 0);
+	}
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(this, m_size);
+	}
+
+	friend std::ostream& operator<<(
+		std::ostream& o,
+		const point_buffer& b)
+	{
+		o << "[";
+		for(size_t i=0; i<b.size(); i++){
+			if(i)
+				o << ", ";
+			o << b[i];
+		}
+		o << "]";
+		return o;
+	}
+
+private:
+	T* m_data;
+	size_t m_size;
+	size_t m_capacity;
+	bool m_owner;
+
+	/*
+	 * round `n` up to a whole number of aligned blocks
+	 */
+	static size_t padded(size_t n) noexcept
+	{
+		const size_t block = alignment/sizeof(T) ? alignment/sizeof(T) : 1;
+		return ((n + block - 1)/block)*block;
+	}
+
+	static T* allocate(size_t capacity)
+	{
+		return static_cast<T*>(::operator new(
+			capacity*n_dimension*sizeof(T),
+			std::align_val_t(alignment)));
+	}
+
+	static void deallocate(T* data) noexcept
+	{
+		if(data)
+			::operator delete(data, std::align_val_t(alignment));
+	}
+
+	void copy_columns(const point_buffer& b)
+	{
+		for(size_t a=0; a<n_dimension; a++)
+			if(b.m_size)
+				std::memcpy(
+					column(a),
+					b.column(a),
+					b.m_size*sizeof(T));
+
+		m_size = b.m_size;
+	}
+};
+
+typedef point_buffer<double, 2>	point_buffer2d;
+typedef point_buffer<double, 3>	point_buffer3d;
+typedef point_buffer<float, 2>	point_buffer2f;
+typedef point_buffer<float, 3>	point_buffer3f;
+typedef point_buffer<int, 2>	point_buffer2i;
+typedef point_buffer<int, 3>	point_buffer3i;
+
+}
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <optional>
+#include <type_traits>
 
 #include <gmt/exception.hpp>
 
@@ -9,93 +12,132 @@ namespace gmt {
 
 /**
   * Describes a euclidean point of arbitrary number of dimension.
+  *
+  * The point is a plain aggregate of `n_dimension` values: it has no
+  * virtual functions, it is trivially copyable and it has standard
+  * layout, so a `point2d` is exactly two doubles and an array of points
+  * can be copied with `memcpy` or mapped from a file.
+  *
+  * The indexing operator and the `x()`, `y()` and `z()` accessors are
+  * unchecked; use `at()` when the index comes from outside and a bounds
+  * check is wanted.
   */
 template<typename T = double, std::size_t n_dimension = 2>
 class point {
 public:
+	typedef T value_type;
 
-	/**
-	  * TODO: Constructor of point.
-	  * TODO: Elaborated Description.
+	/** @brief constructs the point at the origin
 	  */
-	point(void)
-	{
-		for(size_t i=0; i<n_dimension; i++)
-			axis[i] = 0;
-	}
+	constexpr point() noexcept
+		: axis{}
+	{}
 
 	/** @brief constructs a point with facilitator, the number of
 	  *  arguments is the same of the dimensions, e.g., point(x, y, z, etc..)
 	  */
-	point(const std::initializer_list<T>& l)
+	constexpr point(const std::initializer_list<T>& l)
+		: axis{}
 	{
 
 		if(l.size() != n_dimension)
-			throw axis_out_of_bounds(n_dimension, l.size());
+			GMT_THROW(axis_out_of_bounds(n_dimension, l.size()));
 
 		size_t count = 0;
 		for(auto& i : l)
 			this->axis[count++] = i;
 	}
 
-	/**
-	  * TODO: Desctructor of point.
-	  * TODO: Elaborated Description
-	  */
-	virtual ~point ()
-	{}
-
 	/** @brief Get the number of dimensions of this point
 	  *
 	  * @return the constant number of dimension of this vec
 	 */
-	std::size_t ndim() const
+	constexpr std::size_t ndim() const noexcept
 	{
 		return n_dimension;
 	}
 
-	/** @brief get element in the axis `axis`
+	/** @brief get element in the axis `axis` checking the bounds
+	  *
+	  * @throw axis_out_of_bounds if `index` is not an axis of the point
 	  */
-	T& at(std::size_t index)
+	constexpr T& at(std::size_t index)
 	{
-		if(index < n_dimension)
+		if(try_at(index))
 			return this->axis[index];
-		else
-			throw axis_out_of_bounds(n_dimension, index);
+
+		GMT_THROW(axis_out_of_bounds(n_dimension, index));
 	}
 
-	const T& at(std::size_t index) const
+	constexpr const T& at(std::size_t index) const
+	{
+		if(try_at(index))
+			return this->axis[index];
+
+		GMT_THROW(axis_out_of_bounds(n_dimension, index));
+	}
+
+	/** @brief get element in the axis `axis` checking the bounds
+	  *
+	  * @return the element, or nothing if `index` is not an axis of the
+	  *	   point
+	  */
+	constexpr std::optional<T> try_at(std::size_t index) const noexcept
 	{
 		if(index < n_dimension)
 			return this->axis[index];
-		else
-			throw axis_out_of_bounds(n_dimension, index);
+
+		return std::nullopt;
 	}
 
+	/** @brief pointer to the contiguous coordinates of the point
+	  */
+	constexpr T* data() noexcept { return axis; }
+	constexpr const T* data() const noexcept { return axis; }
+
 	/** @brief reference to x
 	  */
-	T& x(void) { return at(0); }
-	const T& x(void) const { return at(0); }
+	constexpr T& x(void) noexcept { return axis[0]; }
+	constexpr const T& x(void) const noexcept { return axis[0]; }
 
 	/** @brief reference to y
 	  */
-	T& y(void) { return at(1); }
-	const T& y(void) const { return at(1); }
+	constexpr T& y(void) noexcept
+	{
+		static_assert(n_dimension > 1, "the point has no y axis");
+		return axis[1];
+	}
+
+	constexpr const T& y(void) const noexcept
+	{
+		static_assert(n_dimension > 1, "the point has no y axis");
+		return axis[1];
+	}
 
 	/** @brief reference to z
 	  */
-	T& z(void) { return at(2); }
-	const T& z(void) const { return at(2); }
+	constexpr T& z(void) noexcept
+	{
+		static_assert(n_dimension > 2, "the point has no z axis");
+		return axis[2];
+	}
+
+	constexpr const T& z(void) const noexcept
+	{
+		static_assert(n_dimension > 2, "the point has no z axis");
+		return axis[2];
+	}
 
 	/**
 	  * @brief subtracts the `p` of this point and return the result
 	  */
-	point<T, n_dimension> subtraction(const point<T, n_dimension>& p) const
+	constexpr point<T, n_dimension> subtraction(
+		const point<T, n_dimension>& p) const noexcept
 	{
 		point<T, n_dimension> r;
 
 		for(size_t i=0; i<n_dimension; i++)
-			r[i] = at(i) - p[i];
+			r[i] = axis[i] - p[i];
 
 		return r;
 	}
@@ -103,7 +145,7 @@ public:
 	/**
 	  * @brief subtracts the `p` of this point in place
 	  */
-	void subtract(const point<T, n_dimension>& p)
+	constexpr void subtract(const point<T, n_dimension>& p) noexcept
 	{
 		for(size_t i=0; i<n_dimension; i++)
 			(*this)[i] -= p[i];
@@ -112,12 +154,13 @@ public:
 	/**
 	  * @brief adds the `p` of this point and return the result
 	  */
-	point<T, n_dimension> addition(const point<T, n_dimension>& p) const
+	constexpr point<T, n_dimension> addition(
+		const point<T, n_dimension>& p) const noexcept
 	{
 		point<T, n_dimension> r;
 
 		for(size_t i=0; i<n_dimension; i++)
-			r[i] = at(i) + p[i];
+			r[i] = axis[i] + p[i];
 
 		return r;
 	}
@@ -125,7 +168,7 @@ public:
 	/**
 	  * @brief adds the `p` in this point
 	  */
-	void add(const point<T, n_dimension>& p)
+	constexpr void add(const point<T, n_dimension>& p) noexcept
 	{
 		for(size_t i=0; i<n_dimension; i++)
 			(*this)[i] += p[i];
@@ -134,12 +177,12 @@ public:
 	/**
 	  * @brief divide point with the scalar
 	  */
-	point<T, n_dimension> division(const T& scalar) const
+	constexpr point<T, n_dimension> division(const T& scalar) const noexcept
 	{
 		point<T, n_dimension> r;
 
 		for(size_t i=0; i<n_dimension; i++)
-			r[i] = at(i) / scalar;
+			r[i] = axis[i] / scalar;
 
 		return r;
 	}
@@ -147,7 +190,7 @@ public:
 	/**
 	  * @brief divide this point with the scalar
 	  */
-	void divide(const T& scalar)
+	constexpr void divide(const T& scalar) noexcept
 	{
 		for(size_t i=0; i<n_dimension; i++)
 			(*this)[i] /= scalar;
@@ -156,12 +199,13 @@ public:
 	/**
 	  * @brief multiply the point with a scalar
 	  */
-	point<T, n_dimension> multiplication(const T& scalar) const
+	constexpr point<T, n_dimension> multiplication(
+		const T& scalar) const noexcept
 	{
 		point<T, n_dimension> r;
 
 		for(size_t i=0; i<n_dimension; i++)
-			r[i] = at(i)*scalar;
+			r[i] = axis[i]*scalar;
 
 		return r;
 	}
@@ -169,7 +213,7 @@ public:
 	/**
 	  * @brief multiply this point with the scalar
 	  */
-	void multiply(const T& scalar)
+	constexpr void multiply(const T& scalar) noexcept
 	{
 		for(size_t i=0; i<n_dimension; i++)
 			(*this)[i] *= scalar;
@@ -179,10 +223,10 @@ public:
 	  *
 	  * @return true in case the point is zero or false otherwise
 	  */
-	bool is_zero (void) const
+	constexpr bool is_zero (void) const noexcept
 	{
 		for(std::size_t i=0; i<n_dimension; i++)
-			if(at(i) != 0)
+			if(axis[i] != 0)
 				return false;
 
 		return true;
@@ -192,7 +236,7 @@ public:
 	  *
 	  * @return true in case the point is equal or false otherwise
 	  */
-	bool is_equal(const point<T, n_dimension>& p) const
+	constexpr bool is_equal(const point<T, n_dimension>& p) const noexcept
 	{
 		for(std::size_t i=0; i<n_dimension; i++){
 			if( (*this)[i] != p[i] )
@@ -202,7 +246,7 @@ public:
 		return true;
 	}
 
-	bool is_equal(const T& value) const
+	constexpr bool is_equal(const T& value) const noexcept
 	{
 		for(std::size_t i=0; i<n_dimension; i++){
 			if((*this)[i] != value)
@@ -228,10 +272,10 @@ public:
 
 			if(n_dimension > 1){
 				for(; i< (n_dimension-1); i++)
-					o << this->at(i) << sep;
+					o << (*this)[i] << sep;
 			}
 
-			o << this->at(i);
+			o << (*this)[i];
 		}
 
 		o << pos;
@@ -241,39 +285,49 @@ public:
 	/*
 	 * Operators --------------------------------------
 	 */
-	T& operator[](std::size_t axis)
+
+	/** unchecked access to the axis `index`, the bounds are only
+	  * asserted in debug builds
+	  */
+	constexpr T& operator[](std::size_t index) noexcept
 	{
-		return at(axis);
+		assert(index < n_dimension);
+		return axis[index];
 	}
 
-	const T& operator[](std::size_t index) const
+	constexpr const T& operator[](std::size_t index) const noexcept
 	{
-		return at(index);
+		assert(index < n_dimension);
+		return axis[index];
 	}
 
-	point<T, n_dimension> operator+(const point<T, n_dimension>& p) const
+	constexpr point<T, n_dimension> operator+(
+		const point<T, n_dimension>& p) const noexcept
 	{
 		return this->addition(p);
 	}
 
-	point<T, n_dimension> operator+=(const point<T, n_dimension>& p)
+	constexpr point<T, n_dimension> operator+=(
+		const point<T, n_dimension>& p) noexcept
 	{
 		this->add(p);
 		return *this;
 	}
 
-	point<T, n_dimension> operator-(const point<T, n_dimension>& p) const
+	constexpr point<T, n_dimension> operator-(
+		const point<T, n_dimension>& p) const noexcept
 	{
 		return this->subtraction(p);
 	}
 
-	point<T, n_dimension> operator-=(const point<T, n_dimension>& p)
+	constexpr point<T, n_dimension> operator-=(
+		const point<T, n_dimension>& p) noexcept
 	{
 		this->subtract(p);
 		return *this;
 	}
 
-	point<T, n_dimension> operator-() const
+	constexpr point<T, n_dimension> operator-() const noexcept
 	{
 		point<T, n_dimension> p;
 		for(size_t i=0; i<n_dimension; i++)
@@ -282,44 +336,45 @@ public:
 		return p;
 	}
 
-	const point<T, n_dimension> operator/(const T& scalar) const
+	constexpr const point<T, n_dimension> operator/(
+		const T& scalar) const noexcept
 	{
 		return this->division(scalar);
 	}
 
-	point<T, n_dimension> operator/=(const T& scalar)
+	constexpr point<T, n_dimension> operator/=(const T& scalar) noexcept
 	{
 		this->divide(scalar);
 		return *this;
 	}
 
-	point<T, n_dimension> operator*(const T& d) const
+	constexpr point<T, n_dimension> operator*(const T& d) const noexcept
 	{
 		return multiplication(d);
 	}
 
-	const point<T, n_dimension>& operator*=(const T& d)
+	constexpr const point<T, n_dimension>& operator*=(const T& d) noexcept
 	{
 		multiply(d);
 		return *this;
 	}
 
-	bool operator==(const point<T, n_dimension>& p) const
+	constexpr bool operator==(const point<T, n_dimension>& p) const noexcept
 	{
 		return this->is_equal(p);
 	}
 
-	bool operator!=(const point<T, n_dimension>& p) const
+	constexpr bool operator!=(const point<T, n_dimension>& p) const noexcept
 	{
 		return !(this->is_equal(p));
 	}
 
-	bool operator==(const T& value) const
+	constexpr bool operator==(const T& value) const noexcept
 	{
 		return this->is_equal(value);
 	}
 
-	bool operator!=(const T& value) const
+	constexpr bool operator!=(const T& value) const noexcept
 	{
 		return this->is_equal(value);
 	}
@@ -346,4 +401,21 @@ typedef point<double,	4> point4d;
 typedef point<int,	4> point4i;
 typedef point<float,	4> point4f;
 
+/*
+ * the points are stored in bulk (polygons, buffers, files), these
+ * properties allow them to be copied with memcpy and mapped directly
+ */
+static_assert(std::is_trivially_copyable<point2d>::value,
+	"point2d must be trivially copyable");
+static_assert(std::is_standard_layout<point2d>::value,
+	"point2d must have standard layout");
+static_assert(sizeof(point2d) == 2*sizeof(double),
+	"point2d must not have padding");
+static_assert(std::is_trivially_copyable<point3d>::value,
+	"point3d must be trivially copyable");
+static_assert(std::is_standard_layout<point3d>::value,
+	"point3d must have standard layout");
+static_assert(std::is_trivially_copyable<point2i>::value,
+	"point2i must be trivially copyable");
+
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include <cstdlib>
+#include <cmath>
 #include <gmt/polygon.hpp>
+#include <gmt/point-buffer.hpp>
 
 namespace gmt {
 
@@ -152,4 +154,203 @@ double polygon_dot(
 	return sum;
 }
 
+/*
+ * the same operations over structure-of-arrays buffers, they run column
+ * by column over contiguous memory
+ */
+
+template<typename T, size_t n_dimension>
+point_buffer<T, n_dimension> operator+(
+	const point_buffer<T, n_dimension>& a,
+	const point_buffer<T, n_dimension>& b)
+{
+	point_buffer<T, n_dimension> r(a.size());
+
+	for(size_t j = 0; j<n_dimension ; j++){
+		const T* ca = a.column(j);
+		const T* cb = b.column(j);
+		T* cr = r.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			cr[i] = ca[i] + cb[i];
+	}
+
+	return r;
+}
+
+template<typename T, size_t n_dimension>
+point_buffer<T, n_dimension>& operator+=(
+	point_buffer<T, n_dimension>& a,
+	const point_buffer<T, n_dimension>& b)
+{
+	for(size_t j = 0; j<n_dimension ; j++){
+		T* ca = a.column(j);
+		const T* cb = b.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			ca[i] += cb[i];
+	}
+
+	return a;
+}
+
+template<typename T, size_t n_dimension>
+point_buffer<T, n_dimension> operator-(
+	const point_buffer<T, n_dimension>& a,
+	const point_buffer<T, n_dimension>& b)
+{
+	point_buffer<T, n_dimension> r(a.size());
+
+	for(size_t j = 0; j<n_dimension ; j++){
+		const T* ca = a.column(j);
+		const T* cb = b.column(j);
+		T* cr = r.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			cr[i] = ca[i] - cb[i];
+	}
+
+	return r;
+}
+
+template<typename T, size_t n_dimension>
+point_buffer<T, n_dimension> operator*(
+	const point_buffer<T, n_dimension>& a,
+	const point_buffer<T, n_dimension>& b)
+{
+	point_buffer<T, n_dimension> r(a.size());
+
+	for(size_t j = 0; j<n_dimension ; j++){
+		const T* ca = a.column(j);
+		const T* cb = b.column(j);
+		T* cr = r.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			cr[i] = ca[i] * cb[i];
+	}
+
+	return r;
+}
+
+template<typename T, size_t n_dimension>
+point_buffer<T, n_dimension> operator*(
+	const point_buffer<T, n_dimension>& a,
+	T b)
+{
+	point_buffer<T, n_dimension> r(a.size());
+
+	for(size_t j = 0; j<n_dimension ; j++){
+		const T* ca = a.column(j);
+		T* cr = r.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			cr[i] = ca[i] * b;
+	}
+
+	return r;
+}
+
+template<typename T, size_t n_dimension>
+point_buffer<T, n_dimension> operator/(
+	const point_buffer<T, n_dimension>& a,
+	const point_buffer<T, n_dimension>& b)
+{
+	point_buffer<T, n_dimension> r(a.size());
+
+	for(size_t j = 0; j<n_dimension ; j++){
+		const T* ca = a.column(j);
+		const T* cb = b.column(j);
+		T* cr = r.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			cr[i] = ca[i] / cb[i];
+	}
+
+	return r;
+}
+
+template<typename T, size_t n_dimension>
+point_buffer<T, n_dimension> operator/(
+	const point_buffer<T, n_dimension>& a,
+	T b)
+{
+	point_buffer<T, n_dimension> r(a.size());
+
+	for(size_t j = 0; j<n_dimension ; j++){
+		const T* ca = a.column(j);
+		T* cr = r.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			cr[i] = ca[i] / b;
+	}
+
+	return r;
+}
+
+template<typename T, size_t n_dimension>
+point_buffer<T, n_dimension>& operator/=(
+	point_buffer<T, n_dimension>& a,
+	T b)
+{
+	for(size_t j = 0; j<n_dimension ; j++){
+		T* ca = a.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			ca[i] /= b;
+	}
+
+	return a;
+}
+
+template<typename T, size_t n_dimension>
+point_buffer<T, n_dimension>& operator*=(
+	point_buffer<T, n_dimension>& a,
+	T b)
+{
+	for(size_t j = 0; j<n_dimension ; j++){
+		T* ca = a.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			ca[i] *= b;
+	}
+
+	return a;
+}
+
+template<typename T, size_t n_dimension>
+point_buffer<T, n_dimension> operator-(const point_buffer<T, n_dimension>& a)
+{
+	point_buffer<T, n_dimension> r(a.size());
+
+	for(size_t j = 0; j<n_dimension ; j++){
+		const T* ca = a.column(j);
+		T* cr = r.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			cr[i] = -ca[i];
+	}
+
+	return r;
+}
+
+template<typename T, size_t n_dimension>
+T polygon_norm(const gmt::point_buffer<T, n_dimension>& polygon)
+{
+	T sum = 0.0;
+	for(size_t j = 0; j<n_dimension ; j++){
+		const T* c = polygon.column(j);
+		for(size_t i = 0; i<polygon.size() ; i++)
+			sum += c[i]*c[i];
+	}
+
+	return sqrt(sum);
+}
+
+template<typename T, size_t n_dimension>
+T polygon_dot(
+	const gmt::point_buffer<T, n_dimension>& a,
+	const gmt::point_buffer<T, n_dimension>& b)
+{
+	T sum = 0.0;
+
+	for(size_t j = 0; j<n_dimension ; j++){
+		const T* ca = a.column(j);
+		const T* cb = b.column(j);
+		for(size_t i = 0; i<a.size() ; i++)
+			sum += ca[i]*cb[i];
+	}
+
+	return sum;
+}
+
 };
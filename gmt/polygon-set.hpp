@@ -0,0 +1,627 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-with-holes.hpp>
+
+namespace gmt {
+
+/**
+  * type of the offsets of a `polygon_set`, they have a fixed width so the
+  * binary files read them in place on any platform
+  */
+typedef std::uint64_t polygon_set_offset;
+
+/**
+  * Non-owning view of a ring of contiguous points, i.e., a pointer and a
+  * number of points. It is indexed and iterated like a `polygon`, but
+  * it is only valid while the storage of the points is.
+  *
+  * @tparam T		type of the axes
+  * @tparam n_dimension	number of axes of the points
+  */
+template<typename T, std::size_t n_dimension = 2>
+class ring_view {
+public:
+	typedef point<T, n_dimension> value_type;
+	typedef const point<T, n_dimension>* const_iterator;
+	typedef const_iterator iterator;
+
+	constexpr ring_view() noexcept
+		: m_data(nullptr), m_size(0)
+	{}
+
+	constexpr ring_view(const point<T, n_dimension>* data, size_t size) noexcept
+		: m_data(data), m_size(size)
+	{}
+
+	ring_view(const polygon<T, n_dimension>& poly) noexcept
+		: m_data(poly.data()), m_size(poly.size())
+	{}
+
+	constexpr size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	constexpr const point<T, n_dimension>* data() const noexcept
+	{
+		return m_data;
+	}
+
+	constexpr const point<T, n_dimension>& operator[](size_t i) const noexcept
+	{
+		return m_data[i];
+	}
+
+	constexpr const_iterator begin() const noexcept
+	{
+		return m_data;
+	}
+
+	constexpr const_iterator end() const noexcept
+	{
+		return m_data + m_size;
+	}
+
+	/** @brief copies the points of the ring to a `polygon`
+	  */
+	polygon<T, n_dimension> to_polygon() const
+	{
+		polygon<T, n_dimension> poly;
+		poly.assign(begin(), end());
+		return poly;
+	}
+
+	friend std::ostream& operator<<(std::ostream& o, const ring_view& r)
+	{
+		o << "[";
+		for(size_t i=0; i<r.size(); i++){
+			if(i)
+				o << ", ";
+			o << r[i];
+		}
+		o << "]";
+		return o;
+	}
+
+private:
+	const point<T, n_dimension>* m_data;
+	size_t m_size;
+};
+
+/**
+  * Non-owning view of a polygon with holes of a `polygon_set`, the ring 0
+  * is the boundary and the other rings are the holes
+  */
+template<typename T, std::size_t n_dimension = 2>
+class polygon_view {
+public:
+	/**
+	  * @param points		points of all the rings of the set
+	  * @param ring_offsets	offsets of the rings of the set in `points`
+	  * @param first_ring		index of the boundary of the polygon
+	  * @param n_rings		number of rings of the polygon
+	  */
+	constexpr polygon_view(
+		const point<T, n_dimension>* points,
+		const polygon_set_offset* ring_offsets,
+		size_t first_ring,
+		size_t n_rings) noexcept
+		: m_points(points),
+		  m_ring_offsets(ring_offsets),
+		  m_first_ring(first_ring),
+		  m_n_rings(n_rings)
+	{}
+
+	/** @brief number of rings of the polygon, the boundary included
+	  */
+	constexpr size_t n_rings() const noexcept
+	{
+		return m_n_rings;
+	}
+
+	/** @brief number of holes, 0 for an empty polygon, which has no
+	  *  boundary either
+	  */
+	constexpr size_t n_holes() const noexcept
+	{
+		return m_n_rings ? m_n_rings - 1 : 0;
+	}
+
+	constexpr ring_view<T, n_dimension> ring(size_t i) const noexcept
+	{
+		const polygon_set_offset* offset = m_ring_offsets + m_first_ring + i;
+		return ring_view<T, n_dimension>(
+			m_points + offset[0],
+			offset[1] - offset[0]);
+	}
+
+	constexpr ring_view<T, n_dimension> boundary() const noexcept
+	{
+		return ring(0);
+	}
+
+	constexpr ring_view<T, n_dimension> hole(size_t i) const noexcept
+	{
+		return ring(i + 1);
+	}
+
+	/** @brief copies the polygon to a `polygon_with_holes`
+	  */
+	polygon_with_holes<T, n_dimension> to_polygon_with_holes() const
+	{
+		polygon_with_holes<T, n_dimension> poly;
+		if(!m_n_rings)
+			return poly;
+
+		poly.boundary().assign(boundary().begin(), boundary().end());
+
+		for(size_t i=0; i<n_holes(); i++)
+			poly.add_hole(hole(i).to_polygon());
+
+		return poly;
+	}
+
+private:
+	const point<T, n_dimension>* m_points;
+	const polygon_set_offset* m_ring_offsets;
+	size_t m_first_ring;
+	size_t m_n_rings;
+};
+
+/**
+  * Non-owning view of the three arrays of a `polygon_set`, it reads the
+  * arrays wherever they are, e.g., in a `polygon_set` or in a mapped
+  * file, see `polygon_set` for their layout.
+  */
+template<typename T, std::size_t n_dimension = 2>
+class polygon_set_view {
+public:
+	typedef polygon_view<T, n_dimension> value_type;
+
+	/** index based iterator over the polygons of the set
+	  */
+	class const_iterator {
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef polygon_view<T, n_dimension> value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const value_type* pointer;
+		typedef value_type reference;
+
+		constexpr const_iterator(const polygon_set_view& set, size_t index) noexcept
+			: set(set), index(index)
+		{}
+
+		value_type operator*() const noexcept
+		{
+			return set[index];
+		}
+
+		const_iterator& operator++() noexcept
+		{
+			index++;
+			return *this;
+		}
+
+		const_iterator operator++(int) noexcept
+		{
+			const_iterator tmp = *this;
+			index++;
+			return tmp;
+		}
+
+		const_iterator& operator--() noexcept
+		{
+			index--;
+			return *this;
+		}
+
+		const_iterator& operator+=(difference_type n) noexcept
+		{
+			index += n;
+			return *this;
+		}
+
+		const_iterator operator+(difference_type n) const noexcept
+		{
+			return const_iterator(set, index + n);
+		}
+
+		difference_type operator-(const const_iterator& i) const noexcept
+		{
+			return static_cast<difference_type>(index)
+				- static_cast<difference_type>(i.index);
+		}
+
+		bool operator==(const const_iterator& i) const noexcept
+		{
+			return index == i.index;
+		}
+
+		bool operator!=(const const_iterator& i) const noexcept
+		{
+			return index != i.index;
+		}
+
+	private:
+		polygon_set_view set;
+		size_t index;
+	};
+
+	typedef const_iterator iterator;
+
+	/** every ring of the set as a list of rings, e.g., to treat the
+	  * holes as obstacles like the boundaries
+	  */
+	class ring_list {
+	public:
+		typedef ring_view<T, n_dimension> value_type;
+
+		constexpr explicit ring_list(const polygon_set_view& set) noexcept
+			: set(set)
+		{}
+
+		constexpr size_t size() const noexcept
+		{
+			return set.n_rings();
+		}
+
+		constexpr ring_view<T, n_dimension> operator[](size_t r) const noexcept
+		{
+			return set.ring(r);
+		}
+
+	private:
+		polygon_set_view set;
+	};
+
+	constexpr polygon_set_view() noexcept
+		: m_points(nullptr),
+		  m_ring_offsets(nullptr),
+		  m_polygon_offsets(nullptr),
+		  m_size(0)
+	{}
+
+	/**
+	  * @param points		points of all the rings
+	  * @param ring_offsets	`n_rings + 1` offsets of the rings in
+	  *				`points`
+	  * @param polygon_offsets	`n_polygons + 1` offsets of the polygons
+	  *				in `ring_offsets`
+	  * @param n_polygons		number of polygons
+	  */
+	constexpr polygon_set_view(
+		const point<T, n_dimension>* points,
+		const polygon_set_offset* ring_offsets,
+		const polygon_set_offset* polygon_offsets,
+		size_t n_polygons) noexcept
+		: m_points(points),
+		  m_ring_offsets(ring_offsets),
+		  m_polygon_offsets(polygon_offsets),
+		  m_size(n_polygons)
+	{}
+
+	/** @brief number of polygons
+	  */
+	constexpr size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	constexpr bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	constexpr size_t n_rings() const noexcept
+	{
+		return m_size ? m_polygon_offsets[m_size] : 0;
+	}
+
+	constexpr size_t n_points() const noexcept
+	{
+		return m_size ? m_ring_offsets[n_rings()] : 0;
+	}
+
+	constexpr polygon_view<T, n_dimension> operator[](size_t i) const noexcept
+	{
+		return polygon_view<T, n_dimension>(
+			m_points,
+			m_ring_offsets,
+			m_polygon_offsets[i],
+			m_polygon_offsets[i + 1] - m_polygon_offsets[i]);
+	}
+
+	constexpr ring_view<T, n_dimension> ring(size_t r) const noexcept
+	{
+		return ring_view<T, n_dimension>(
+			m_points + m_ring_offsets[r],
+			m_ring_offsets[r + 1] - m_ring_offsets[r]);
+	}
+
+	constexpr ring_list rings() const noexcept
+	{
+		return ring_list(*this);
+	}
+
+	constexpr const_iterator begin() const noexcept
+	{
+		return const_iterator(*this, 0);
+	}
+
+	constexpr const_iterator end() const noexcept
+	{
+		return const_iterator(*this, m_size);
+	}
+
+	constexpr const point<T, n_dimension>* points() const noexcept
+	{
+		return m_points;
+	}
+
+	constexpr const polygon_set_offset* ring_offsets() const noexcept
+	{
+		return m_ring_offsets;
+	}
+
+	constexpr const polygon_set_offset* polygon_offsets() const noexcept
+	{
+		return m_polygon_offsets;
+	}
+
+private:
+	const point<T, n_dimension>* m_points;
+	const polygon_set_offset* m_ring_offsets;
+	const polygon_set_offset* m_polygon_offsets;
+	size_t m_size;
+};
+
+/**
+  * Collection of polygons with holes in three flat arrays, in the style
+  * of the compressed sparse row matrices:
+  *
+  * - `points()`, the vertices of all the rings one after another;
+  * - `ring_offsets()`, the ring `r` is made of the points from
+  *   `ring_offsets()[r]` to `ring_offsets()[r + 1] - 1`;
+  * - `polygon_offsets()`, the polygon `i` is made of the rings from
+  *   `polygon_offsets()[i]` to `polygon_offsets()[i + 1] - 1`, the first
+  *   one is its boundary and the others are its holes.
+  *
+  * Adding a polygon appends to the three arrays, so after `reserve` it
+  * does not allocate, and the views returned by the set do not allocate
+  * either. The views are invalidated by the modifications of the set.
+  *
+  * @tparam T		type of the axes
+  * @tparam n_dimension	number of axes of the points
+  */
+template<typename T, std::size_t n_dimension = 2>
+class polygon_set {
+public:
+	typedef polygon_view<T, n_dimension> value_type;
+	typedef typename polygon_set_view<T, n_dimension>::const_iterator
+		const_iterator;
+	typedef const_iterator iterator;
+	typedef typename polygon_set_view<T, n_dimension>::ring_list ring_list;
+
+	polygon_set()
+		: m_ring_offsets(1, 0), m_polygon_offsets(1, 0)
+	{}
+
+	/** @brief builds the set from a list of polygons without holes
+	  */
+	explicit polygon_set(const std::vector<polygon<T, n_dimension>>& l)
+		: polygon_set()
+	{
+		size_t n_points = 0;
+		for(const auto& poly : l)
+			n_points += poly.size();
+
+		reserve(l.size(), l.size(), n_points);
+
+		for(const auto& poly : l)
+			add_polygon(poly);
+	}
+
+	/** @brief reserves the space for `n_polygons` polygons with
+	  *  `n_rings` rings and `n_points` points in total
+	  */
+	void reserve(size_t n_polygons, size_t n_rings, size_t n_points)
+	{
+		m_points.reserve(n_points);
+		m_ring_offsets.reserve(n_rings + 1);
+		m_polygon_offsets.reserve(n_polygons + 1);
+	}
+
+	/** @brief adds a polygon whose boundary is the range of points
+	  *  `boundary`, e.g., a `polygon` or a `ring_view`
+	  */
+	template<typename container>
+	void add_polygon(const container& boundary)
+	{
+		new_polygon();
+		add_hole(boundary);
+	}
+
+	void add_polygon(const polygon_with_holes<T, n_dimension>& poly)
+	{
+		add_polygon(poly.boundary());
+		for(const auto& hole : poly.holes())
+			add_hole(hole);
+	}
+
+	/** @brief adds the range of points `ring` as a hole of the last
+	  *  polygon added
+	  */
+	template<typename container>
+	void add_hole(const container& ring)
+	{
+		m_points.insert(m_points.end(), ring.begin(), ring.end());
+		close_ring();
+	}
+
+	/*
+	 * point by point construction: `new_polygon` starts a polygon
+	 * without rings, `push_back` appends a point to the ring being built
+	 * and `close_ring` adds that ring to the last polygon
+	 */
+
+	void new_polygon()
+	{
+		m_polygon_offsets.push_back(m_polygon_offsets.back());
+	}
+
+	void push_back(const point<T, n_dimension>& p)
+	{
+		m_points.push_back(p);
+	}
+
+	/** @brief removes the last point of the ring being built
+	  */
+	void pop_back()
+	{
+		m_points.pop_back();
+	}
+
+	/** @brief number of points of the ring being built
+	  */
+	size_t open_ring_size() const noexcept
+	{
+		return m_points.size() - m_ring_offsets.back();
+	}
+
+	void close_ring()
+	{
+		m_ring_offsets.push_back(m_points.size());
+		m_polygon_offsets.back()++;
+	}
+
+	void clear() noexcept
+	{
+		m_points.clear();
+		m_ring_offsets.resize(1);
+		m_polygon_offsets.resize(1);
+	}
+
+	/** @brief goes back to the first `n_polygons` polygons, made of the
+	  *  first `n_rings` rings and `n_points` points, e.g., the sizes of
+	  *  the set before a construction that failed; the ring and the
+	  *  polygon being built, if any, are removed too
+	  */
+	void truncate(size_t n_polygons, size_t n_rings, size_t n_points)
+	{
+		m_points.resize(n_points);
+		m_ring_offsets.resize(n_rings + 1);
+		m_polygon_offsets.resize(n_polygons + 1);
+	}
+
+	/** @brief view of the three arrays of the set
+	  */
+	polygon_set_view<T, n_dimension> view() const noexcept
+	{
+		return polygon_set_view<T, n_dimension>(
+			m_points.data(),
+			m_ring_offsets.data(),
+			m_polygon_offsets.data(),
+			size());
+	}
+
+	/** @brief number of polygons
+	  */
+	size_t size() const noexcept
+	{
+		return m_polygon_offsets.size() - 1;
+	}
+
+	bool empty() const noexcept
+	{
+		return size() == 0;
+	}
+
+	size_t n_rings() const noexcept
+	{
+		return m_ring_offsets.size() - 1;
+	}
+
+	size_t n_points() const noexcept
+	{
+		return m_points.size();
+	}
+
+	polygon_view<T, n_dimension> operator[](size_t i) const noexcept
+	{
+		return view()[i];
+	}
+
+	ring_view<T, n_dimension> ring(size_t r) const noexcept
+	{
+		return view().ring(r);
+	}
+
+	ring_list rings() const noexcept
+	{
+		return view().rings();
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return view().begin();
+	}
+
+	const_iterator end() const noexcept
+	{
+		return view().end();
+	}
+
+	const std::vector<point<T, n_dimension>>& points() const noexcept
+	{
+		return m_points;
+	}
+
+	const std::vector<polygon_set_offset>& ring_offsets() const noexcept
+	{
+		return m_ring_offsets;
+	}
+
+	const std::vector<polygon_set_offset>& polygon_offsets() const noexcept
+	{
+		return m_polygon_offsets;
+	}
+
+private:
+	std::vector<point<T, n_dimension>> m_points;
+	std::vector<polygon_set_offset> m_ring_offsets;
+	std::vector<polygon_set_offset> m_polygon_offsets;
+};
+
+typedef ring_view<double, 2>		ring_view2d;
+typedef ring_view<double, 3>		ring_view3d;
+typedef ring_view<int, 2>		ring_view2i;
+typedef ring_view<int, 3>		ring_view3i;
+
+typedef polygon_view<double, 2>		polygon_view2d;
+typedef polygon_view<double, 3>		polygon_view3d;
+typedef polygon_view<int, 2>		polygon_view2i;
+typedef polygon_view<int, 3>		polygon_view3i;
+
+typedef polygon_set_view<double, 2>	polygon_set_view2d;
+typedef polygon_set_view<double, 3>	polygon_set_view3d;
+typedef polygon_set_view<int, 2>	polygon_set_view2i;
+typedef polygon_set_view<int, 3>	polygon_set_view3i;
+
+typedef polygon_set<double, 2>		polygon_set2d;
+typedef polygon_set<double, 3>		polygon_set3d;
+typedef polygon_set<int, 2>		polygon_set2i;
+typedef polygon_set<int, 3>		polygon_set3i;
+
+}
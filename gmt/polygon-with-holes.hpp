@@ -26,12 +26,12 @@ public:
 
 	polygon<T, n_dimension>& boundary()
 	{
-		return static_cast<polygon2d&>(*this);
+		return static_cast<polygon<T, n_dimension>&>(*this);
 	}
 
 	const polygon<T, n_dimension>& boundary() const
 	{
-		return static_cast<const polygon2d&>(*this);
+		return static_cast<const polygon<T, n_dimension>&>(*this);
 	}
 
 	polygon<T, n_dimension>& hole(size_t i)
@@ -44,6 +44,19 @@ public:
 		return m_holes.at(i);
 	}
 
+	/** @brief pointer to the hole `i`, or `nullptr` if there is not such
+	  *  hole
+	  */
+	polygon<T, n_dimension>* try_hole(size_t i) noexcept
+	{
+		return (i < m_holes.size()) ? &m_holes[i] : nullptr;
+	}
+
+	const polygon<T, n_dimension>* try_hole(size_t i) const noexcept
+	{
+		return (i < m_holes.size()) ? &m_holes[i] : nullptr;
+	}
+
 	std::vector<polygon<T, n_dimension>>& holes()
 	{
 		return m_holes;
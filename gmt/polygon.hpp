@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include <gmt/point.hpp>
@@ -26,6 +27,17 @@ public:
 	~polygon()
 	{}
 
+	/** @brief vertex `i` of the polygon, or nothing if the polygon has
+	  *  not `i + 1` vertices
+	  */
+	std::optional<point<T, n_dimension>> try_at(std::size_t i) const noexcept
+	{
+		if(i < this->size())
+			return (*this)[i];
+
+		return std::nullopt;
+	}
+
 	friend std::ostream& operator<<(std::ostream& o, const polygon& poly)
 	{
 		o << "[";
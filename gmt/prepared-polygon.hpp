@@ -0,0 +1,506 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-with-holes.hpp>
+#include <gmt/bounding-box.hpp>
+#include <gmt/rtree.hpp>
+#include <gmt/algorithm/misc.hpp>
+#include <gmt/algorithm/direction.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+#include <gmt/algorithm/polygon-simplicity.hpp>
+
+namespace gmt {
+
+/**
+  * Polygon with cached attributes. The bounding box, the signed area, the
+  * orientation, the convexity, the list of reflex vertices and whether
+  * the polygon is simple are computed the first time they are asked and
+  * kept until the polygon is modified through one of the mutators below,
+  * which invalidate all of them.
+  *
+  * The attributes are computed lazily from `const` functions, so a
+  * `prepared_polygon` shared between threads must be `prepare`d first.
+  *
+  * @tparam T	type of the axes
+  */
+template<typename T>
+class prepared_polygon {
+public:
+	typedef polygon<T, 2>		polygon_type;
+	typedef point<T, 2>		value_type;
+	typedef typename polygon_type::const_iterator const_iterator;
+
+	prepared_polygon()
+	{}
+
+	explicit prepared_polygon(const polygon_type& poly)
+		: m_polygon(poly)
+	{}
+
+	explicit prepared_polygon(polygon_type&& poly)
+		: m_polygon(std::move(poly))
+	{}
+
+	prepared_polygon(const std::initializer_list<point<T, 2>>& l)
+		: m_polygon(l)
+	{}
+
+	/** @brief the vertices of the polygon
+	  */
+	const polygon_type& ring() const noexcept
+	{
+		return m_polygon;
+	}
+
+	size_t size() const noexcept
+	{
+		return m_polygon.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return m_polygon.empty();
+	}
+
+	const point<T, 2>& operator[](size_t i) const noexcept
+	{
+		return m_polygon[i];
+	}
+
+	const point<T, 2>* data() const noexcept
+	{
+		return m_polygon.data();
+	}
+
+	const_iterator begin() const noexcept
+	{
+		return m_polygon.begin();
+	}
+
+	const_iterator end() const noexcept
+	{
+		return m_polygon.end();
+	}
+
+	/*
+	 * mutators, all of them drop the cached attributes
+	 */
+
+	void set(size_t i, const point<T, 2>& p)
+	{
+		m_polygon[i] = p;
+		invalidate();
+	}
+
+	void push_back(const point<T, 2>& p)
+	{
+		m_polygon.push_back(p);
+		invalidate();
+	}
+
+	void insert(size_t i, const point<T, 2>& p)
+	{
+		m_polygon.insert(m_polygon.begin() + i, p);
+		invalidate();
+	}
+
+	void erase(size_t i)
+	{
+		m_polygon.erase(m_polygon.begin() + i);
+		invalidate();
+	}
+
+	void clear() noexcept
+	{
+		m_polygon.clear();
+		invalidate();
+	}
+
+	void assign(const polygon_type& poly)
+	{
+		m_polygon = poly;
+		invalidate();
+	}
+
+	/** @brief mutable access to the vertices. The cached attributes are
+	  *  dropped now, so the reference must not be used to modify the
+	  *  polygon after the next query.
+	  */
+	polygon_type& edit() noexcept
+	{
+		invalidate();
+		return m_polygon;
+	}
+
+	/** @brief drops the cached attributes
+	  */
+	void invalidate() noexcept
+	{
+		m_valid = 0;
+		m_reflex.clear();
+	}
+
+	/** @brief computes all the attributes now
+	  */
+	void prepare() const
+	{
+		compute_shape();
+		compute_turns();
+		compute_simple();
+	}
+
+	/** @brief axis-aligned bounding box of the vertices
+	  */
+	const bounding_box<T, 2>& bounds() const
+	{
+		compute_shape();
+		return m_bounds;
+	}
+
+	/** @brief signed area of the polygon, positive when the vertices are
+	  *  in counterclockwise order
+	  */
+	double signed_area() const
+	{
+		compute_shape();
+		return m_signed_area;
+	}
+
+	double area() const
+	{
+		return fabs(signed_area());
+	}
+
+	/** @brief LEFT if the vertices are in counterclockwise order, RIGHT
+	  *  if they are in clockwise order and ON if the area is zero. With
+	  *  integer coordinates it is exact.
+	  */
+	direction orientation() const
+	{
+		compute_shape();
+		return m_orientation;
+	}
+
+	/** @brief checks whether the polygon is convex, collinear vertices
+	  *  are allowed
+	  */
+	bool is_convex() const
+	{
+		compute_turns();
+		return m_convex;
+	}
+
+	/** @brief checks whether the polygon is convex and no three
+	  *  consecutive vertices are collinear
+	  */
+	bool is_strictly_convex() const
+	{
+		compute_turns();
+		return m_strictly_convex;
+	}
+
+	/** @brief indices of the reflex vertices in increasing order, the
+	  *  reflex vertices are the ones which turn against the orientation
+	  */
+	const std::vector<size_t>& reflex_vertices() const
+	{
+		compute_turns();
+		return m_reflex;
+	}
+
+	bool is_reflex(size_t i) const
+	{
+		const std::vector<size_t>& r = reflex_vertices();
+		return std::binary_search(r.begin(), r.end(), i);
+	}
+
+	/** @brief checks whether no two edges of the polygon intersect, but
+	  *  the consecutive ones in their shared vertex
+	  */
+	bool is_simple() const
+	{
+		compute_simple();
+		return m_simple;
+	}
+
+private:
+	enum {
+		SHAPE = 1,
+		TURNS = 2,
+		SIMPLE = 4
+	};
+
+	polygon_type m_polygon;
+
+	mutable unsigned m_valid = 0;
+	mutable bounding_box<T, 2> m_bounds;
+	mutable double m_signed_area = 0.0;
+	mutable direction m_orientation = ON;
+	mutable bool m_convex = false;
+	mutable bool m_strictly_convex = false;
+	mutable bool m_simple = false;
+	mutable std::vector<size_t> m_reflex;
+
+	size_t next(size_t i) const noexcept
+	{
+		return (i + 1 == m_polygon.size()) ? 0 : i + 1;
+	}
+
+	size_t prev(size_t i) const noexcept
+	{
+		return (i == 0) ? m_polygon.size() - 1 : i - 1;
+	}
+
+	static direction turn(
+		const point<T, 2>& a,
+		const point<T, 2>& b,
+		const point<T, 2>& c)
+	{
+		return robust_direction_in(
+			a, b, c,
+			GMT_PREDICATE_SITE("prepared_polygon"));
+	}
+
+	/*
+	 * bounding box and area in one pass, the area is the sum of the
+	 * triangles of the fan of the vertex 0, with integer coordinates the
+	 * sum is exact
+	 */
+	void compute_shape() const
+	{
+		if(m_valid & SHAPE)
+			return;
+
+		const size_t n = m_polygon.size();
+		m_bounds = bounding_box<T, 2>::of(m_polygon);
+
+		if constexpr(std::is_integral<T>::value){
+			wide_int twice_area = 0;
+
+			for(size_t i=1; i+1<n; i++)
+				twice_area += exact_signed_parallelogram_area(
+					m_polygon[0],
+					m_polygon[i],
+					m_polygon[i + 1]);
+
+			m_signed_area = double(twice_area)/2.0;
+			m_orientation = integer_direction(twice_area, 0.0);
+		}else{
+			double twice_area = 0.0;
+
+			for(size_t i=1; i+1<n; i++)
+				twice_area += signed_parallelogram_area(
+					vec<T, 2>(m_polygon[0], m_polygon[i]),
+					vec<T, 2>(m_polygon[0], m_polygon[i + 1]));
+
+			m_signed_area = twice_area/2.0;
+
+			if(twice_area > 0.0)
+				m_orientation = LEFT;
+			else if(twice_area < 0.0)
+				m_orientation = RIGHT;
+			else
+				m_orientation = ON;
+		}
+
+		m_valid |= SHAPE;
+	}
+
+	/*
+	 * the polygon is convex when no vertex turns against the orientation
+	 * and the boundary goes around only once, i.e., the x direction of
+	 * the edges changes at most twice
+	 */
+	void compute_turns() const
+	{
+		if(m_valid & TURNS)
+			return;
+
+		compute_shape();
+
+		const size_t n = m_polygon.size();
+		m_reflex.clear();
+		m_convex = false;
+		m_strictly_convex = false;
+
+		if(n < 3 || m_orientation == ON){
+			m_valid |= TURNS;
+			return;
+		}
+
+		const direction against = (m_orientation == LEFT) ? RIGHT : LEFT;
+		bool collinear = false;
+
+		for(size_t i=0; i<n; i++){
+			direction d = turn(
+				m_polygon[prev(i)],
+				m_polygon[i],
+				m_polygon[next(i)]);
+
+			if(d == against)
+				m_reflex.push_back(i);
+			else if(d == ON)
+				collinear = true;
+		}
+
+		int first_sign = 0, last_sign = 0, changes = 0;
+
+		for(size_t i=0; i<n; i++){
+			const point<T, 2>& a = m_polygon[i];
+			const point<T, 2>& b = m_polygon[next(i)];
+			int sign = (b.x() > a.x()) - (b.x() < a.x());
+
+			if(sign == 0)
+				continue;
+
+			if(first_sign == 0)
+				first_sign = sign;
+			else if(sign != last_sign)
+				changes++;
+
+			last_sign = sign;
+		}
+
+		if(last_sign != first_sign)
+			changes++;
+
+		m_convex = m_reflex.empty() && changes <= 2;
+		m_strictly_convex = m_convex && !collinear;
+
+		m_valid |= TURNS;
+	}
+
+	/*
+	 * the sweep of Shamos and Hoey stops at the first pair of edges
+	 * that meet where they should not
+	 */
+	void compute_simple() const
+	{
+		if(m_valid & SIMPLE)
+			return;
+
+		m_simple = gmt::is_simple(m_polygon);
+
+		m_valid |= SIMPLE;
+	}
+};
+
+typedef prepared_polygon<double>	prepared_polygon2d;
+typedef prepared_polygon<int>		prepared_polygon2i;
+
+/**
+  * Polygon with holes prepared for point queries: the boundary and the
+  * holes are `prepared_polygon`s and the bounding boxes of the holes are
+  * indexed in an R-tree, so a query only tests the holes whose boxes
+  * contain the point. It is built once and its attributes are computed
+  * in the construction, so it can be shared between threads.
+  *
+  * @tparam T	type of the axes
+  */
+template<typename T>
+class prepared_polygon_with_holes {
+public:
+	typedef polygon_with_holes<T, 2>	polygon_with_holes_type;
+	typedef prepared_polygon<T>		ring_type;
+
+	prepared_polygon_with_holes()
+	{}
+
+	explicit prepared_polygon_with_holes(const polygon_with_holes_type& poly)
+		: m_boundary(poly.boundary())
+	{
+		m_boundary.prepare();
+
+		std::vector<bounding_box<T, 2>> boxes;
+		boxes.reserve(poly.holes().size());
+		m_holes.reserve(poly.holes().size());
+
+		for(const auto& hole : poly.holes()){
+			m_holes.emplace_back(hole);
+			m_holes.back().prepare();
+			boxes.push_back(m_holes.back().bounds());
+		}
+
+		m_index = rtree<T, 2>(boxes);
+	}
+
+	const ring_type& boundary() const noexcept
+	{
+		return m_boundary;
+	}
+
+	size_t n_holes() const noexcept
+	{
+		return m_holes.size();
+	}
+
+	const ring_type& hole(size_t i) const noexcept
+	{
+		return m_holes[i];
+	}
+
+	const bounding_box<T, 2>& bounds() const
+	{
+		return m_boundary.bounds();
+	}
+
+	/** @brief calls `f(i)` for every hole `i` whose bounding box contains
+	  *  `p`, the only holes that can contain it
+	  */
+	template<typename visitor>
+	void holes_around(const point<T, 2>& p, const visitor& f) const
+	{
+		m_index.query(p, f);
+	}
+
+private:
+	ring_type m_boundary;
+	std::vector<ring_type> m_holes;
+	rtree<T, 2> m_index;
+};
+
+typedef prepared_polygon_with_holes<double>	prepared_polygon_with_holes2d;
+typedef prepared_polygon_with_holes<int>	prepared_polygon_with_holes2i;
+
+/**
+  * check if the vertex `i` of the prepared polygon `poly` is reflex,
+  * regardless of its orientation
+  */
+template<typename T>
+bool is_reflex(const prepared_polygon<T>& poly, std::size_t i)
+{
+	return poly.is_reflex(i);
+}
+
+/*
+ * classify the vertice i of the prepared polygon, a clockwise polygon
+ * is classified as if its vertices were in counterclockwise order
+ */
+template<typename T>
+vertex_type classify(const prepared_polygon<T>& poly, size_t index)
+{
+	vertex_type type = classify(poly.ring(), index);
+
+	if(poly.orientation() != RIGHT)
+		return type;
+
+	switch(type){
+	case START:
+		return SPLIT;
+	case SPLIT:
+		return START;
+	case END:
+		return MERGE;
+	case MERGE:
+		return END;
+	default:
+		return type;
+	}
+}
+
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/bounding-box.hpp>
+
+namespace gmt {
+
+/**
+  * Static R-tree of bounding boxes, packed bottom-up with the
+  * Sort-Tile-Recursive order: the boxes are sorted by the first axis of
+  * their centers, cut in vertical slices, and each slice is sorted by the
+  * second axis, so every node covers a compact group of up to
+  * `node_capacity` neighbours. The tree is built once and only answers
+  * queries, the items are identified by their positions in the vector
+  * given to the constructor.
+  *
+  * @tparam T		type of the axes
+  * @tparam n_dimension	number of axes of the boxes
+  */
+template<typename T, std::size_t n_dimension = 2>
+class rtree {
+public:
+	typedef bounding_box<T, n_dimension> box_type;
+
+	static constexpr size_t node_capacity = 16;
+
+	rtree()
+	{}
+
+	explicit rtree(const std::vector<box_type>& boxes)
+	{
+		build(boxes);
+	}
+
+	/** @brief number of boxes
+	  */
+	size_t size() const noexcept
+	{
+		return m_items.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return m_items.empty();
+	}
+
+	/** @brief box of all the boxes, empty if the tree is empty
+	  */
+	box_type bounds() const noexcept
+	{
+		if(m_nodes.empty())
+			return box_type();
+
+		return m_nodes.back().box;
+	}
+
+	/** @brief calls `f(i)` for every item `i` whose box contains `p`
+	  */
+	template<typename visitor>
+	void query(const point<T, n_dimension>& p, const visitor& f) const
+	{
+		visit([&p](const box_type& b){ return b.contains(p); }, f);
+	}
+
+	/** @brief calls `f(i)` for every item `i` whose box intersects `b`
+	  */
+	template<typename visitor>
+	void query(const box_type& b, const visitor& f) const
+	{
+		visit([&b](const box_type& c){ return c.intersects(b); }, f);
+	}
+
+private:
+	/*
+	 * the children of a node are the nodes or, in the leaves, the items
+	 * `first` to `first + count - 1`
+	 */
+	struct node {
+		box_type box;
+		std::uint32_t first;
+		std::uint32_t count;
+	};
+
+	/*
+	 * the levels of the tree one after the other, from the leaves to the
+	 * root, which is the last node
+	 */
+	std::vector<node> m_nodes;
+	size_t m_n_leaves = 0;
+
+	/*
+	 * the items and their boxes in the order of the leaves
+	 */
+	std::vector<std::uint32_t> m_items;
+	std::vector<box_type> m_boxes;
+
+	static T center(const box_type& b, size_t axis)
+	{
+		return b.min[axis] + (b.max[axis] - b.min[axis])/2;
+	}
+
+	/*
+	 * Sort-Tile-Recursive order of the boxes `boxes[order[i]]`
+	 */
+	static void sort_tile(
+		std::vector<std::uint32_t>& order,
+		const std::vector<box_type>& boxes)
+	{
+		const size_t n = order.size();
+		const size_t n_groups = (n + node_capacity - 1)/node_capacity;
+		const size_t n_slices = size_t(std::ceil(std::sqrt(double(n_groups))));
+		const size_t slice = n_slices*node_capacity;
+
+		auto by_axis = [&boxes](size_t axis){
+			return [&boxes, axis](std::uint32_t i, std::uint32_t j){
+				return center(boxes[i], axis) < center(boxes[j], axis);
+			};
+		};
+
+		std::sort(order.begin(), order.end(), by_axis(0));
+
+		if(n_dimension < 2)
+			return;
+
+		for(size_t first=0; first<n; first += slice){
+			auto last = order.begin() + std::min(n, first + slice);
+			std::sort(order.begin() + first, last, by_axis(1));
+		}
+	}
+
+	/*
+	 * groups of `node_capacity` consecutive children, `base` is the
+	 * position of the first child
+	 */
+	static void pack(
+		const std::vector<box_type>& boxes,
+		size_t base,
+		std::vector<node>& level)
+	{
+		for(size_t first=0; first<boxes.size(); first += node_capacity){
+			const size_t last = std::min(boxes.size(), first + node_capacity);
+
+			node parent;
+			parent.first = std::uint32_t(base + first);
+			parent.count = std::uint32_t(last - first);
+			for(size_t i=first; i<last; i++)
+				parent.box.extend(boxes[i]);
+
+			level.push_back(parent);
+		}
+	}
+
+	void build(const std::vector<box_type>& boxes)
+	{
+		if(boxes.empty())
+			return;
+
+		m_items.resize(boxes.size());
+		std::iota(m_items.begin(), m_items.end(), 0);
+		sort_tile(m_items, boxes);
+
+		m_boxes.reserve(boxes.size());
+		for(auto i : m_items)
+			m_boxes.push_back(boxes[i]);
+
+		std::vector<node> level;
+		pack(m_boxes, 0, level);
+		m_n_leaves = level.size();
+
+		/*
+		 * each level is sorted before its parents are packed, the
+		 * parents keep the children contiguous
+		 */
+		while(true){
+			const size_t base = m_nodes.size();
+
+			if(level.size() > 1){
+				std::vector<box_type> level_boxes;
+				std::vector<std::uint32_t> order(level.size());
+
+				level_boxes.reserve(level.size());
+				for(const auto& child : level)
+					level_boxes.push_back(child.box);
+
+				std::iota(order.begin(), order.end(), 0);
+				sort_tile(order, level_boxes);
+
+				std::vector<box_type> sorted_boxes;
+				sorted_boxes.reserve(level.size());
+				for(auto i : order){
+					m_nodes.push_back(level[i]);
+					sorted_boxes.push_back(level_boxes[i]);
+				}
+
+				level.clear();
+				pack(sorted_boxes, base, level);
+			}else{
+				m_nodes.push_back(level.front());
+				break;
+			}
+		}
+	}
+
+	template<typename predicate, typename visitor>
+	void visit(const predicate& hit, const visitor& f) const
+	{
+		if(m_nodes.empty())
+			return;
+
+		/*
+		 * at most node_capacity - 1 pending siblings per level, and no
+		 * 32-bit tree has more than 8 levels
+		 */
+		size_t stack[8*node_capacity];
+		size_t top = 0;
+
+		if(hit(m_nodes.back().box))
+			stack[top++] = m_nodes.size() - 1;
+
+		while(top){
+			const size_t id = stack[--top];
+			const node& v = m_nodes[id];
+
+			if(id < m_n_leaves){
+				for(size_t i=v.first; i<v.first + v.count; i++)
+					if(hit(m_boxes[i]))
+						f(size_t(m_items[i]));
+			}else{
+				for(size_t i=v.first; i<v.first + v.count; i++)
+					if(hit(m_nodes[i].box))
+						stack[top++] = i;
+			}
+		}
+	}
+};
+
+typedef rtree<double, 2>	rtree2d;
+typedef rtree<double, 3>	rtree3d;
+typedef rtree<int, 2>		rtree2i;
+typedef rtree<int, 3>		rtree3i;
+
+}
@@ -10,12 +10,12 @@ public:
 	point<T, n_dimension> from;
 	point<T, n_dimension> to;
 
-	segment( const point<T, n_dimension>& from,
-		 const point<T, n_dimension>& to)
-		: from(from), to(to)
+	constexpr segment() noexcept
 	{}
 
-	virtual ~segment()
+	constexpr segment( const point<T, n_dimension>& from,
+		 const point<T, n_dimension>& to) noexcept
+		: from(from), to(to)
 	{}
 
 	friend std::ostream& operator<<(
@@ -34,5 +34,10 @@ typedef segment<double, 3>	segment3d;
 typedef segment<int, 2>		segment2i;
 typedef segment<int, 3>		segment3i;
 
+static_assert(std::is_trivially_copyable<segment2d>::value,
+	"segment2d must be trivially copyable");
+static_assert(std::is_standard_layout<segment2d>::value,
+	"segment2d must have standard layout");
+
 
 }
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace gmt {
+
+/**
+  * Balanced binary tree of the status of a sweep line, a treap whose
+  * nodes live in one pool and refer to each other by their positions in
+  * it. The removed nodes are reused, so a sweep allocates only when the
+  * status grows beyond its largest size, and the pool is kept from a
+  * sweep to the next one by `clear`.
+  *
+  * The tree keeps no comparator: the order of the items of a sweep
+  * changes with the position of the line, so each insertion and search
+  * takes a predicate of the items at the current position. A node is a
+  * handle to its item that stays valid until the item is erased.
+  *
+  * @tparam T	type of the items
+  */
+template<typename T>
+class sweep_tree {
+public:
+	typedef std::uint32_t handle;
+
+	static constexpr handle npos = std::numeric_limits<handle>::max();
+
+	/** @brief number of items
+	  */
+	std::size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+	bool empty() const noexcept
+	{
+		return m_size == 0;
+	}
+
+	/** @brief removes every item, the pool is kept
+	  */
+	void clear() noexcept
+	{
+		m_nodes.clear();
+		m_root = npos;
+		m_free = npos;
+		m_size = 0;
+	}
+
+	void reserve(std::size_t n)
+	{
+		m_nodes.reserve(n);
+	}
+
+	T& operator[](handle h) noexcept
+	{
+		return m_nodes[h].item;
+	}
+
+	const T& operator[](handle h) const noexcept
+	{
+		return m_nodes[h].item;
+	}
+
+	/**
+	  * inserts `item` before the first item `x` for which
+	  * `goes_before(x)` is true, the predicate must be false for a
+	  * prefix of the items and true for the rest
+	  *
+	  * @return the handle of the new item
+	  */
+	template<typename predicate>
+	handle insert(const T& item, const predicate& goes_before)
+	{
+		handle h = allocate(item);
+
+		handle parent = npos;
+		bool left = false;
+
+		for(handle i = m_root; i != npos;){
+			parent = i;
+			left = goes_before(m_nodes[i].item);
+			i = left ? m_nodes[i].left : m_nodes[i].right;
+		}
+
+		attach(h, parent, left);
+		return h;
+	}
+
+	/**
+	  * inserts `item` right after the item of `h`, or at the front when
+	  * `h` is `npos`
+	  */
+	handle insert_after(handle h, const T& item)
+	{
+		handle n = allocate(item);
+
+		if(h == npos){
+			handle i = m_root;
+			if(i == npos){
+				attach(n, npos, false);
+			}else{
+				while(m_nodes[i].left != npos)
+					i = m_nodes[i].left;
+				attach(n, i, true);
+			}
+		}else if(m_nodes[h].right == npos){
+			attach(n, h, false);
+		}else{
+			handle i = m_nodes[h].right;
+			while(m_nodes[i].left != npos)
+				i = m_nodes[i].left;
+			attach(n, i, true);
+		}
+
+		return n;
+	}
+
+	/** @brief removes the item of `h`
+	  */
+	void erase(handle h)
+	{
+		/*
+		 * the node goes down by rotations with the child of the higher
+		 * priority until it is a leaf
+		 */
+		while(m_nodes[h].left != npos || m_nodes[h].right != npos){
+			handle l = m_nodes[h].left;
+			handle r = m_nodes[h].right;
+
+			if(r == npos || (l != npos && m_nodes[l].priority > m_nodes[r].priority))
+				rotate_up(l);
+			else
+				rotate_up(r);
+		}
+
+		handle p = m_nodes[h].parent;
+		if(p == npos)
+			m_root = npos;
+		else if(m_nodes[p].left == h)
+			m_nodes[p].left = npos;
+		else
+			m_nodes[p].right = npos;
+
+		m_nodes[h].left = m_free;
+		m_free = h;
+		m_size--;
+	}
+
+	/** @brief handle of the first item, or `npos` if it is empty
+	  */
+	handle first() const noexcept
+	{
+		handle i = m_root;
+		if(i != npos)
+			while(m_nodes[i].left != npos)
+				i = m_nodes[i].left;
+		return i;
+	}
+
+	/** @brief handle of the last item, or `npos` if it is empty
+	  */
+	handle last() const noexcept
+	{
+		handle i = m_root;
+		if(i != npos)
+			while(m_nodes[i].right != npos)
+				i = m_nodes[i].right;
+		return i;
+	}
+
+	/** @brief handle of the item after the one of `h`, or `npos`
+	  */
+	handle next(handle h) const noexcept
+	{
+		if(m_nodes[h].right != npos){
+			h = m_nodes[h].right;
+			while(m_nodes[h].left != npos)
+				h = m_nodes[h].left;
+			return h;
+		}
+
+		handle p = m_nodes[h].parent;
+		while(p != npos && m_nodes[p].right == h){
+			h = p;
+			p = m_nodes[p].parent;
+		}
+
+		return p;
+	}
+
+	/** @brief handle of the item before the one of `h`, or `npos`
+	  */
+	handle prev(handle h) const noexcept
+	{
+		if(m_nodes[h].left != npos){
+			h = m_nodes[h].left;
+			while(m_nodes[h].right != npos)
+				h = m_nodes[h].right;
+			return h;
+		}
+
+		handle p = m_nodes[h].parent;
+		while(p != npos && m_nodes[p].left == h){
+			h = p;
+			p = m_nodes[p].parent;
+		}
+
+		return p;
+	}
+
+	/**
+	  * handle of the last item `x` for which `is_before(x)` is true, or
+	  * `npos` if there is none; the predicate must be true for a prefix
+	  * of the items and false for the rest
+	  */
+	template<typename predicate>
+	handle last_before(const predicate& is_before) const
+	{
+		handle found = npos;
+
+		for(handle i = m_root; i != npos;){
+			if(is_before(m_nodes[i].item)){
+				found = i;
+				i = m_nodes[i].right;
+			}else{
+				i = m_nodes[i].left;
+			}
+		}
+
+		return found;
+	}
+
+	/**
+	  * handle of the first item `x` for which `is_before(x)` is false,
+	  * or `npos` if there is none
+	  *
+	  * @see last_before
+	  */
+	template<typename predicate>
+	handle first_after(const predicate& is_before) const
+	{
+		handle found = npos;
+
+		for(handle i = m_root; i != npos;){
+			if(is_before(m_nodes[i].item)){
+				i = m_nodes[i].right;
+			}else{
+				found = i;
+				i = m_nodes[i].left;
+			}
+		}
+
+		return found;
+	}
+
+private:
+	struct node {
+		T item;
+		handle left;
+		handle right;
+		handle parent;
+		std::uint32_t priority;
+	};
+
+	std::vector<node> m_nodes;
+	handle m_root = npos;
+	handle m_free = npos;
+	std::size_t m_size = 0;
+	std::uint32_t m_seed = 2463534242u;
+
+	handle allocate(const T& item)
+	{
+		/*
+		 * xorshift, the priorities only need to look random
+		 */
+		m_seed ^= m_seed << 13;
+		m_seed ^= m_seed >> 17;
+		m_seed ^= m_seed << 5;
+
+		handle h;
+		if(m_free != npos){
+			h = m_free;
+			m_free = m_nodes[h].left;
+			m_nodes[h] = node{ item, npos, npos, npos, m_seed };
+		}else{
+			h = handle(m_nodes.size());
+			m_nodes.push_back(node{ item, npos, npos, npos, m_seed });
+		}
+
+		m_size++;
+		return h;
+	}
+
+	/*
+	 * hangs the leaf `h` from `parent`, and rotates it up while its
+	 * priority is higher than the one of its parent
+	 */
+	void attach(handle h, handle parent, bool left)
+	{
+		m_nodes[h].parent = parent;
+
+		if(parent == npos)
+			m_root = h;
+		else if(left)
+			m_nodes[parent].left = h;
+		else
+			m_nodes[parent].right = h;
+
+		while(m_nodes[h].parent != npos
+			&& m_nodes[m_nodes[h].parent].priority < m_nodes[h].priority)
+			rotate_up(h);
+	}
+
+	/*
+	 * rotates the child `h` above its parent
+	 */
+	void rotate_up(handle h)
+	{
+		handle p = m_nodes[h].parent;
+		handle g = m_nodes[p].parent;
+
+		if(m_nodes[p].left == h){
+			handle b = m_nodes[h].right;
+			m_nodes[p].left = b;
+			if(b != npos)
+				m_nodes[b].parent = p;
+			m_nodes[h].right = p;
+		}else{
+			handle b = m_nodes[h].left;
+			m_nodes[p].right = b;
+			if(b != npos)
+				m_nodes[b].parent = p;
+			m_nodes[h].left = p;
+		}
+
+		m_nodes[p].parent = h;
+		m_nodes[h].parent = g;
+
+		if(g == npos)
+			m_root = h;
+		else if(m_nodes[g].left == p)
+			m_nodes[g].left = h;
+		else
+			m_nodes[g].right = h;
+	}
+};
+
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gmt/exception.hpp>
+
+namespace gmt {
+
+/**
+  * Fixed set of worker threads for the parallel algorithms. The thread
+  * which calls `parallel_for` runs chunks as well, so a pool without
+  * workers runs everything in the caller.
+  *
+  * The functions given to `parallel_for` must not call `parallel_for` of
+  * the same pool.
+  */
+class thread_pool {
+public:
+	/**
+	  * @param n_workers	number of threads besides the caller, by default
+	  *			one less than the hardware concurrency
+	  */
+	explicit thread_pool(size_t n_workers = default_workers())
+	{
+		m_workers.reserve(n_workers);
+		for(size_t i=0; i<n_workers; i++)
+			m_workers.emplace_back([this]{ work(); });
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	~thread_pool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+
+		m_wake.notify_all();
+		for(auto& w : m_workers)
+			w.join();
+	}
+
+	/**
+	  * @return the number of threads that run the chunks, the workers and
+	  *	   the caller
+	  */
+	size_t size() const noexcept
+	{
+		return m_workers.size() + 1;
+	}
+
+	/**
+	  * Calls `f(begin, end)` for the chunks of at most `grain` indices of
+	  * `[0, n)`, concurrently, and returns when every chunk has run. The
+	  * first exception thrown by `f` is rethrown in the caller, the chunks
+	  * not started yet are skipped.
+	  */
+	template<typename function>
+	void parallel_for(size_t n, size_t grain, const function& f)
+	{
+		if(n == 0)
+			return;
+
+		grain = std::max<size_t>(grain, 1);
+		const size_t n_chunks = (n + grain - 1)/grain;
+		const size_t n_helpers = std::min(m_workers.size(), n_chunks - 1);
+
+		if(n_helpers == 0){
+			f(size_t(0), n);
+			return;
+		}
+
+		std::atomic<size_t> next(0);
+		std::exception_ptr error;
+		std::mutex error_mutex;
+
+		auto run = [&]{
+			size_t c;
+			while((c = next.fetch_add(1, std::memory_order_relaxed)) < n_chunks){
+#ifdef GMT_NO_EXCEPTIONS
+				f(c*grain, std::min(n, (c + 1)*grain));
+#else
+				try{
+					f(c*grain, std::min(n, (c + 1)*grain));
+				}catch(...){
+					std::lock_guard<std::mutex> lock(error_mutex);
+					if(!error)
+						error = std::current_exception();
+					next.store(n_chunks, std::memory_order_relaxed);
+				}
+#endif
+			}
+		};
+
+		std::mutex done_mutex;
+		std::condition_variable done_cv;
+		size_t done = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for(size_t i=0; i<n_helpers; i++){
+				m_tasks.push_back([&]{
+					run();
+
+					std::lock_guard<std::mutex> lock(done_mutex);
+					done++;
+					done_cv.notify_one();
+				});
+			}
+		}
+
+		m_wake.notify_all();
+		run();
+
+		std::unique_lock<std::mutex> lock(done_mutex);
+		done_cv.wait(lock, [&]{ return done == n_helpers; });
+
+#ifndef GMT_NO_EXCEPTIONS
+		if(error)
+			std::rethrow_exception(error);
+#endif
+	}
+
+	static size_t default_workers() noexcept
+	{
+		size_t n = std::thread::hardware_concurrency();
+		return n ? n - 1 : 0;
+	}
+
+private:
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	bool m_stop = false;
+
+	void work()
+	{
+		for(;;){
+			std::function<void()> task;
+
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [this]{
+					return m_stop || !m_tasks.empty();
+				});
+
+				if(m_tasks.empty())
+					return;
+
+				task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+};
+
+/**
+  * pool shared by the parallel algorithms when no pool is given, it is
+  * created in the first use
+  */
+inline thread_pool& default_thread_pool()
+{
+	static thread_pool pool;
+	return pool;
+}
+
+}
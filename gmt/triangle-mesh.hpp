@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <gmt/point.hpp>
+
+namespace gmt {
+
+/**
+  * Mesh of triangles that share their vertices, each triangle is given by
+  * the positions of its three vertices in `vertices`.
+  *
+  * @tparam T		type of the axes
+  * @tparam n_dimension	number of axes of the vertices
+  */
+template<typename T, std::size_t n_dimension = 3>
+class triangle_mesh {
+public:
+	typedef std::array<std::size_t, 3> triangle;
+
+	std::vector<point<T, n_dimension>> vertices;
+	std::vector<triangle> triangles;
+
+	/** @brief number of triangles
+	  */
+	std::size_t size() const noexcept
+	{
+		return triangles.size();
+	}
+
+	bool empty() const noexcept
+	{
+		return triangles.empty();
+	}
+
+	void clear() noexcept
+	{
+		vertices.clear();
+		triangles.clear();
+	}
+
+	/** @brief the three vertices of the triangle `i`
+	  */
+	std::array<point<T, n_dimension>, 3> corners(std::size_t i) const
+	{
+		const triangle& t = triangles[i];
+		return { vertices[t[0]], vertices[t[1]], vertices[t[2]] };
+	}
+};
+
+typedef triangle_mesh<double, 2>	triangle_mesh2d;
+typedef triangle_mesh<float, 2>		triangle_mesh2f;
+typedef triangle_mesh<int, 2>		triangle_mesh2i;
+typedef triangle_mesh<double, 3>	triangle_mesh3d;
+typedef triangle_mesh<float, 3>		triangle_mesh3f;
+typedef triangle_mesh<int, 3>		triangle_mesh3i;
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cmath>
+#include <optional>
 #include <gmt/point.hpp>
 #include <gmt/segment.hpp>
 #include <gmt/exception.hpp>
@@ -19,14 +20,16 @@ public:
 
 	/** @brief Constructor of a `vec`
 	  */
-	vec()
+	constexpr vec() noexcept
 	{}
 
-	vec(const point<T, n_dimension>& p)
+	constexpr vec(const point<T, n_dimension>& p) noexcept
 		: point<T, n_dimension>(p)
 	{}
 
-	vec(const point<T, n_dimension>& p0, const point<T, n_dimension>& p1)
+	constexpr vec(
+		const point<T, n_dimension>& p0,
+		const point<T, n_dimension>& p1) noexcept
 	{
 
 		for(size_t i=0; i<n_dimension; i++)
@@ -34,7 +37,7 @@ public:
 
 	}
 
-	vec(const segment<T, n_dimension>& seg)
+	constexpr vec(const segment<T, n_dimension>& seg) noexcept
 		: vec(seg.from, seg.to)
 	{}
 
@@ -43,13 +46,10 @@ public:
 	  *  arguments is the same of the dimensions, e.g., vec(x, y, z, etc..)
 	  *
 	  */
-	vec(const std::initializer_list<T>& l)
+	constexpr vec(const std::initializer_list<T>& l)
 		: point<T, n_dimension>(l)
 	{}
 
-	virtual ~vec()
-	{}
-
 	template<typename S>
 	vec<T, n_dimension> scalar_product(const S scalar) const
 	{
@@ -57,22 +57,22 @@ public:
 			this->at(i) *= scalar;
 	}
 
-	double dot_product(const vec<T, n_dimension>& v) const
+	constexpr double dot_product(const vec<T, n_dimension>& v) const noexcept
 	{
 		double sum = 0.0;
 
 		for(std::size_t i=0; i<n_dimension; i++)
-			sum += this->at(i)*v[i];
+			sum += (*this)[i]*v[i];
 
 		return sum;
 	}
 
-	double norm_squared() const
+	constexpr double norm_squared() const noexcept
 	{
 		double sum = 0.0;
 
 		for(std::size_t i=0; i<n_dimension; i++){
-			T n = this->at(i);
+			T n = (*this)[i];
 			sum += n*n;
 		}
 
@@ -85,9 +85,20 @@ public:
 	}
 
 	double angle(const vec<T, n_dimension>& v) const
+	{
+		if(std::optional<double> a = try_angle(v))
+			return *a;
+
+		GMT_THROW(exception("The vector must not be zero to calculate the angle"));
+	}
+
+	/** @brief angle between this vector and `v`, or nothing if this
+	  *  vector is zero
+	  */
+	std::optional<double> try_angle(const vec<T, n_dimension>& v) const noexcept
 	{
 		if(this->is_zero())
-			throw exception("The vector must not be zero to calculate the angle");
+			return std::nullopt;
 
 		return std::acos(this->dot_product(v)/(this->norm()*v.norm()));
 	}
@@ -123,10 +134,10 @@ public:
 	vec<T, n_dimension> rotation(double theta) const
 	{
 		if(n_dimension != 2)
-			throw std::runtime_error(
+			GMT_THROW(std::runtime_error(
 				std::string("rotate: Not implemented for ")
 				+ std::to_string(n_dimension)
-				+ " dimensions!");
+				+ " dimensions!"));
 
 		T new_x = cos(theta)*this->x() - sin(theta)*this->y();
 		T new_y = sin(theta)*this->x() + cos(theta)*this->y();
@@ -149,4 +160,11 @@ typedef vec<double,	3> vec3d;
 typedef vec<int,	3> vec3i;
 typedef vec<float,	3> vec3f;
 
+static_assert(std::is_trivially_copyable<vec2d>::value,
+	"vec2d must be trivially copyable");
+static_assert(std::is_standard_layout<vec2d>::value,
+	"vec2d must have standard layout");
+static_assert(sizeof(vec2d) == sizeof(point2d),
+	"vec2d must have the layout of point2d");
+
 }
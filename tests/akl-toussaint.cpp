@@ -0,0 +1,107 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/algorithm/akl-toussaint.hpp>
+#include <gmt/algorithm/convex-hull.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+#include "check.hpp"
+#include "reference-hull.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(18);
+
+constexpr std::size_t no_filter = std::numeric_limits<std::size_t>::max();
+
+template<typename T>
+bool strictly_inside(const polygon<T, 2>& hull, const point<T, 2>& p)
+{
+	const std::size_t h = hull.size();
+	if(h < 3)
+		return false;
+
+	for(std::size_t i=0; i<h; i++)
+		if(robust_direction_in(hull[i], hull[(i + 1)%h], p) != LEFT)
+			return false;
+
+	return true;
+}
+
+/*
+ * the filter keeps the points in their order and discards only points
+ * strictly inside the hull, and the hulls with and without it are the
+ * same
+ */
+template<typename T>
+void check_filter(const std::vector<point<T, 2>>& points)
+{
+	polygon<T, 2> hull = monotone_chain_hull(points, no_filter);
+	std::vector<point<T, 2>> kept = akl_toussaint_filter(points);
+
+	std::size_t k = 0;
+	for(const auto& p : points){
+		if(k < kept.size() && kept[k] == p)
+			k++;
+		else
+			CHECK(strictly_inside(hull, p));
+	}
+
+	CHECK(k == kept.size());
+	CHECK(monotone_chain_hull(kept, no_filter) == hull);
+	CHECK(monotone_chain_hull(points, 1) == hull);
+	CHECK(chan_hull(points, 0, 1) == hull);
+}
+
+int main()
+{
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	for(int t=0; t<600; t++){
+		const int kind = t%5;
+		const std::size_t n = 1 + rng()%3000;
+
+		std::vector<point2d> points;
+		std::vector<point2i> integers;
+
+		for(std::size_t i=0; i<n; i++){
+			if(kind == 0){
+				points.push_back(point2d{ uniform(rng), uniform(rng) });
+			}else if(kind == 1){
+				points.push_back(point2d{ normal(rng), normal(rng) });
+			}else if(kind == 2){
+				double a = 3.2*uniform(rng);
+				points.push_back(point2d{ std::cos(a), std::sin(a) });
+			}else if(kind == 3){
+				integers.push_back(point2i{ int(rng()%9), int(rng()%9) });
+			}else{
+				/*
+				 * coordinates whose differences are not exact in the
+				 * floating-point test of the octagon
+				 */
+				integers.push_back(point2i{
+					int(rng()%2000000000u) - 1000000000,
+					int(rng()%2000000000u) - 1000000000 });
+			}
+		}
+
+		if(kind < 3){
+			check_filter(points);
+
+			point_buffer2d buffer(points);
+			point_buffer2d kept = akl_toussaint_filter(buffer);
+			CHECK(kept.size() == akl_toussaint_filter(points).size());
+			CHECK(monotone_chain_hull(buffer, 1) == monotone_chain_hull(points, no_filter));
+		}else{
+			check_filter(integers);
+		}
+	}
+
+	return gmt_test::exit_code();
+}
@@ -0,0 +1,150 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gmt/pi.hpp>
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-set.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/thread-pool.hpp>
+#include <gmt/algorithm/point-in-polygon.hpp>
+#include <gmt/algorithm/batch-point-in-polygon.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+#include "check.hpp"
+#include "reference-polygons.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(13);
+
+/*
+ * a random star of integer coordinates, its rings may cross themselves,
+ * which the winding number counts as well
+ */
+polygon2d random_ring(std::size_t n, int high)
+{
+	polygon2d ring;
+	for(const auto& p : gmt_test::random_star(rng, n, 1 + high/3, high))
+		ring.push_back(point2d{ double(p.x()), double(p.y()) });
+
+	return ring;
+}
+
+/*
+ * lattice points on the vertices, edges and heights of the ring, and
+ * points of real coordinates, in random order
+ */
+std::vector<point2d> queries(const polygon2d& ring, std::size_t n, int range)
+{
+	std::uniform_real_distribution<double> uniform(-range, range);
+	std::vector<point2d> q;
+
+	for(std::size_t k=0; k<n; k++){
+		switch(rng()%4){
+		case 0:
+			if(!ring.empty()){
+				q.push_back(ring[rng()%ring.size()]);
+				break;
+			}
+			/* fall through */
+		case 1:
+			q.push_back(point2d{ uniform(rng), uniform(rng) });
+			break;
+		default:
+			q.push_back(point2d{ double(int(rng()%(2*range + 1)) - range),
+				double(int(rng()%(2*range + 1)) - range) });
+		}
+	}
+
+	return q;
+}
+
+/*
+ * the three inputs of `side_of_batch`, in a pool without workers, in a
+ * pool of three and in the default one, answer as `side_of`
+ */
+void check_batch(const polygon2d& ring, const std::vector<point2d>& points, thread_pool& inline_pool, thread_pool& pool)
+{
+	std::vector<side> expected;
+	for(const auto& p : points)
+		expected.push_back(side_of(ring, p));
+
+	point_buffer2d buffer(points);
+	ring_view2d view(ring);
+	robust_predicates exact;
+
+	std::vector<side> out(points.size());
+	side_of_batch(view, buffer, out.data(), exact, inline_pool);
+	CHECK(out == expected);
+
+	out.assign(points.size(), ON_BONDARY);
+	side_of_batch(view, points.data(), points.size(), out.data(), exact, pool);
+	CHECK(out == expected);
+
+	out.assign(points.size(), ON_BONDARY);
+	side_of_batch(view, points, out.data());
+	CHECK(out == expected);
+
+	out.assign(points.size(), ON_BONDARY);
+	side_of_batch(view, buffer, out.data());
+	CHECK(out == expected);
+}
+
+void test_random_rings(thread_pool& inline_pool, thread_pool& pool)
+{
+	for(int t=0; t<300; t++){
+		const int high = 4 + rng()%40;
+		const std::size_t n = rng()%60;
+		polygon2d ring = (n < 6 && rng()%2) ? polygon2d() : random_ring(n, high);
+
+		/*
+		 * rings of zero, one and two vertices
+		 */
+		while(n < 3 && ring.size() > n)
+			ring.pop_back();
+
+		check_batch(ring, queries(ring, rng()%1500, high + 2), inline_pool, pool);
+	}
+}
+
+/*
+ * many points in a ring of more than a block of edges, so the points
+ * are split in chunks for the threads, and a ring of real coordinates
+ */
+void test_large_batches(thread_pool& inline_pool, thread_pool& pool)
+{
+	polygon2d ring = random_ring(600, 200);
+	check_batch(ring, queries(ring, 20000, 202), inline_pool, pool);
+
+	std::uniform_real_distribution<double> uniform(0.5, 1.0);
+	polygon2d circle;
+	for(int k=0; k<1000; k++){
+		double a = 2.0*gmt::pi*k/1000.0;
+		double r = uniform(rng);
+		circle.push_back(point2d{ r*std::cos(a), r*std::sin(a) });
+	}
+
+	std::vector<point2d> points = queries(circle, 5000, 1);
+	for(std::size_t i=0; i+1<circle.size(); i += 7)
+		points.push_back(point2d{
+			0.5*(circle[i].x() + circle[i + 1].x()),
+			0.5*(circle[i].y() + circle[i + 1].y()) });
+
+	check_batch(circle, points, inline_pool, pool);
+}
+
+int main()
+{
+	/*
+	 * without workers the caller runs every chunk
+	 */
+	thread_pool inline_pool(0);
+	thread_pool pool(3);
+
+	test_random_rings(inline_pool, pool);
+	test_large_batches(inline_pool, pool);
+
+	return gmt_test::exit_code();
+}
@@ -0,0 +1,326 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gmt/exception.hpp>
+#include <gmt/pi.hpp>
+#include <gmt/point.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-set.hpp>
+#include <gmt/dcel/dcelp.hpp>
+#include <gmt/io/binary.hpp>
+
+#include "check.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(10);
+
+std::string file_path(const char* name)
+{
+	return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<char> read_bytes(const std::string& path)
+{
+	std::ifstream in(path, std::ios::binary);
+	return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void write_bytes(const std::string& path, const std::vector<char>& bytes)
+{
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write(bytes.data(), std::streamsize(bytes.size()));
+}
+
+template<typename T, std::size_t n_dimension>
+point_buffer<T, n_dimension> random_buffer(std::size_t n)
+{
+	point_buffer<T, n_dimension> b;
+
+	for(std::size_t i=0; i<n; i++){
+		point<T, n_dimension> p;
+		for(std::size_t a=0; a<n_dimension; a++)
+			p[a] = T(int(rng()%2001) - 1000)/T(7);
+		b.push_back(p);
+	}
+
+	return b;
+}
+
+/*
+ * polygons of a few rings of random sizes, some of them empty
+ */
+polygon_set2d random_set(std::size_t n)
+{
+	std::uniform_real_distribution<double> uniform(-1e6, 1e6);
+	polygon_set2d set;
+
+	for(std::size_t i=0; i<n; i++){
+		const std::size_t n_rings = rng()%4;
+
+		set.new_polygon();
+		for(std::size_t r=0; r<n_rings; r++){
+			polygon2d ring;
+			for(std::size_t k=rng()%12; k>0; k--)
+				ring.push_back(point2d{ uniform(rng), uniform(rng) });
+
+			if(r == 0)
+				set.add_polygon(ring);
+			else
+				set.add_hole(ring);
+		}
+	}
+
+	return set;
+}
+
+bool same(const polygon_set_view2d& a, const polygon_set2d& b)
+{
+	if(a.size() != b.size() || a.n_rings() != b.n_rings() || a.n_points() != b.n_points())
+		return false;
+
+	for(std::size_t i=0; i<b.n_points(); i++)
+		if(a.points()[i] != b.points()[i])
+			return false;
+
+	for(std::size_t r=0; r<=b.n_rings(); r++)
+		if(a.ring_offsets()[r] != b.ring_offsets()[r])
+			return false;
+
+	for(std::size_t i=0; i<=b.size(); i++)
+		if(a.polygon_offsets()[i] != b.polygon_offsets()[i])
+			return false;
+
+	return true;
+}
+
+template<typename T, std::size_t n_dimension>
+bool same(const point_buffer<T, n_dimension>& a, const point_buffer<T, n_dimension>& b)
+{
+	if(a.size() != b.size())
+		return false;
+
+	for(std::size_t i=0; i<a.size(); i++)
+		if(a[i] != b[i])
+			return false;
+
+	return true;
+}
+
+/*
+ * point buffers of every scalar and polygon sets, written as a whole and
+ * a polygon at a time, read back in place
+ */
+void test_round_trips()
+{
+	const std::string path = file_path("gmt-test-binary-io.bin");
+
+	for(int t=0; t<40; t++){
+		auto doubles = random_buffer<double, 2>(rng()%300);
+		auto floats = random_buffer<float, 3>(rng()%300);
+		auto ints = random_buffer<int, 2>(rng()%300);
+		polygon_set2d set = random_set(rng()%50);
+
+		{
+			io::binary_writer out(path);
+			out.write(doubles);
+			out.write(floats);
+			out.write(ints);
+			out.write(set);
+
+			out.begin_polygon_set<double, 2>();
+			for(const auto& poly : set){
+				if(!poly.n_rings())
+					continue;
+
+				out.add_polygon(poly.boundary());
+				for(std::size_t h=0; h<poly.n_holes(); h++)
+					out.add_hole(poly.hole(h));
+			}
+			out.end_polygon_set();
+			out.flush();
+		}
+
+		io::binary_file in(path);
+		CHECK(in.n_sections() == 5);
+
+		CHECK(same(in.points<double, 2>(0), doubles));
+		CHECK(same(in.points<float, 3>(1), floats));
+		CHECK(same(in.points<int, 2>(2), ints));
+		CHECK(same(in.polygons<double, 2>(3), set));
+
+		/*
+		 * the polygons without rings cannot be streamed, the others
+		 * are the same
+		 */
+		polygon_set2d streamed;
+		for(const auto& poly : set)
+			if(poly.n_rings())
+				streamed.add_polygon(poly.to_polygon_with_holes());
+		CHECK(same(in.polygons<double, 2>(4), streamed));
+
+		/*
+		 * a section is only read as what it is
+		 */
+		CHECK((!in.try_points<float, 2>(0)));
+		CHECK((!in.try_polygons<double, 2>(0)));
+		CHECK((!in.try_dcel<double, 2>(3)));
+		CHECK((!in.try_points<double, 2>(3)));
+	}
+
+	std::filesystem::remove(path);
+}
+
+/*
+ * a fan of triangles in a regular polygon, read back into a DCEL which
+ * is written to the same bytes
+ */
+void test_dcel()
+{
+	const std::string path = file_path("gmt-test-binary-dcel.bin");
+	const std::string again = file_path("gmt-test-binary-dcel-again.bin");
+
+	for(std::size_t n=3; n<40; n += 3){
+		dcel2d d;
+		std::vector<dcel2d::vertex*> v;
+
+		for(std::size_t i=0; i<n; i++){
+			double a = 2.0*gmt::pi*double(i)/double(n);
+			v.push_back(d.add_vertex(point2d{ std::cos(a), std::sin(a) }));
+		}
+
+		for(std::size_t i=0; i<n; i++)
+			d.add_edge(v[i], v[(i + 1)%n]);
+		for(std::size_t i=2; i+1<n; i++)
+			d.add_edge(v[0], v[i]);
+
+		{
+			io::binary_writer out(path);
+			out.write(d);
+		}
+
+		io::binary_file in(path);
+		auto view = in.dcel<double, 2>(0);
+
+		CHECK(view.n_vertex() == d.n_vertex());
+		CHECK(view.n_edge() == d.n_edge());
+		CHECK(view.n_face() == d.n_face() + 1);
+
+		dcel2d loaded;
+		io::load_dcel(view, loaded);
+
+		CHECK(loaded.n_vertex() == d.n_vertex());
+		CHECK(loaded.n_edge() == d.n_edge());
+		CHECK(loaded.n_face() == d.n_face());
+
+		for(std::size_t i=0; i<d.n_vertex() && i<loaded.n_vertex(); i++)
+			CHECK(loaded.vertex_at(i)->data.p == d.vertex_at(i)->data.p);
+
+		for(std::size_t i=0; i<loaded.n_edge(); i++){
+			const auto* e = loaded.edge_at(i);
+			CHECK(e->twin->twin == e);
+			CHECK(e->next->prev == e);
+			CHECK(e->next->origin == e->destination);
+			CHECK(e->next->incident_face == e->incident_face);
+		}
+
+		{
+			io::binary_writer out(again);
+			out.write(loaded);
+		}
+
+		CHECK(read_bytes(path) == read_bytes(again));
+	}
+
+	std::filesystem::remove(path);
+	std::filesystem::remove(again);
+}
+
+/*
+ * truncated files and sections whose counts or offsets were changed are
+ * rejected, not read
+ */
+void test_corrupted_files()
+{
+	const std::string path = file_path("gmt-test-binary-corrupted.bin");
+	const std::string bad = file_path("gmt-test-binary-corrupted-bad.bin");
+
+	polygon_set2d set = random_set(20);
+	{
+		io::binary_writer out(path);
+		out.write(set);
+	}
+
+	const std::vector<char> bytes = read_bytes(path);
+	CHECK(io::binary_file::try_open(path).has_value());
+
+	for(std::size_t size : { std::size_t(0), std::size_t(10), std::size_t(80), std::size_t(100), bytes.size() - 8 }){
+		write_bytes(bad, std::vector<char>(bytes.begin(), bytes.begin() + size));
+		CHECK(!io::binary_file::try_open(bad));
+	}
+
+	auto patch = [&](std::size_t at, std::uint64_t value){
+		std::vector<char> b = bytes;
+		std::memcpy(b.data() + at, &value, sizeof(value));
+		write_bytes(bad, b);
+
+		auto f = io::binary_file::try_open(bad);
+		return !f || !f->try_polygons<double, 2>(0);
+	};
+
+	/*
+	 * the counts of the section header, after kind, scalar, dimension
+	 * and a reserved word
+	 */
+	const std::size_t counts = io::binary_alignment + 16;
+	CHECK(patch(counts, set.size() + 1));
+	CHECK(patch(counts + 8, set.n_rings() + 1));
+	CHECK(patch(counts + 16, set.n_points() + 1));
+	CHECK(patch(counts + 16, ~std::uint64_t(0)));
+	CHECK(patch(counts + 8, ~std::uint64_t(0)/8));
+
+	/*
+	 * the last ring offset past the points, and a polygon offset that
+	 * goes back
+	 */
+	const std::size_t rings_at = 2*io::binary_alignment
+		+ io::padded_size(set.n_points()*sizeof(point2d));
+	const std::size_t polygons_at = rings_at
+		+ io::padded_size((set.n_rings() + 1)*sizeof(std::uint64_t));
+
+	CHECK(patch(rings_at + 8*set.n_rings(), set.n_points() + 1));
+	CHECK(patch(polygons_at + 8, ~std::uint64_t(0)));
+
+	std::vector<char> magic = bytes;
+	magic[0] = 'X';
+	write_bytes(bad, magic);
+	CHECK(!io::binary_file::try_open(bad));
+
+	bool thrown = false;
+	try{
+		io::binary_file f(bad);
+	}catch(const gmt::exception&){
+		thrown = true;
+	}
+	CHECK(thrown);
+
+	std::filesystem::remove(path);
+	std::filesystem::remove(bad);
+}
+
+int main()
+{
+	test_round_trips();
+	test_dcel();
+	test_corrupted_files();
+
+	return gmt_test::exit_code();
+}
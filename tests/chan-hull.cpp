@@ -0,0 +1,98 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/algorithm/convex-hull.hpp>
+
+#include "check.hpp"
+#include "reference-hull.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(19);
+
+constexpr std::size_t no_filter = std::numeric_limits<std::size_t>::max();
+
+/*
+ * a hint smaller than the hull makes the rounds guess again, a larger
+ * one solves it in the first round
+ */
+std::size_t random_hint()
+{
+	return (rng()%3 == 0) ? rng()%20 : 0;
+}
+
+/*
+ * small integer sets: grids, lines with duplicates, and points of a
+ * line with some steps
+ */
+void test_against_gift_wrapping()
+{
+	for(int t=0; t<4000; t++){
+		const int kind = t%3;
+		const std::size_t n = 1 + rng()%60;
+
+		std::vector<point2i> points;
+		for(std::size_t i=0; i<n; i++){
+			if(kind == 0){
+				points.push_back(point2i{ int(rng()%9), int(rng()%9) });
+			}else if(kind == 1){
+				points.push_back(point2i{ int(rng()%5), 2*int(rng()%5) });
+			}else{
+				int x = rng()%20;
+				points.push_back(point2i{ x, 3*x + 1 });
+			}
+		}
+
+		polygon2i reference = gmt_test::gift_wrapping(points);
+
+		CHECK(chan_hull(points, random_hint(), no_filter) == reference);
+		CHECK(chan_hull(points, random_hint()) == reference);
+	}
+}
+
+/*
+ * real sets of many hull sizes, a few vertices for uniform points, more
+ * for normal ones and all of them on a circle, against the monotone
+ * chain
+ */
+void test_real_sets()
+{
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	for(int t=0; t<300; t++){
+		const int kind = t%3;
+		const std::size_t n = 1 + rng()%((t%7 == 0) ? 5000 : 200);
+
+		std::vector<point2d> points;
+		for(std::size_t i=0; i<n; i++){
+			if(kind == 0){
+				points.push_back(point2d{ uniform(rng), uniform(rng) });
+			}else if(kind == 1){
+				points.push_back(point2d{ normal(rng), normal(rng) });
+			}else{
+				double a = 3.2*uniform(rng);
+				points.push_back(point2d{ std::cos(a), std::sin(a) });
+			}
+		}
+
+		polygon2d hull = monotone_chain_hull(points, no_filter);
+
+		CHECK(chan_hull(points, random_hint(), no_filter) == hull);
+		CHECK(chan_hull(points, hull.size()) == hull);
+		CHECK(chan_hull(point_buffer2d(points), random_hint()) == hull);
+	}
+}
+
+int main()
+{
+	test_against_gift_wrapping();
+	test_real_sets();
+
+	return gmt_test::exit_code();
+}
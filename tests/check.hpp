@@ -0,0 +1,41 @@
+#pragma once
+
+#include <iostream>
+
+/**
+  * Checks of the tests: a failed check prints its condition and place,
+  * and the test exits with the number of failures.
+  */
+namespace gmt_test {
+
+inline std::size_t& failures()
+{
+	static std::size_t n = 0;
+	return n;
+}
+
+inline void check(bool ok, const char* what, const char* file, int line)
+{
+	if(ok)
+		return;
+
+	/*
+	 * a broken invariant usually fails in every iteration, the first
+	 * failures are enough
+	 */
+	if(failures()++ < 16)
+		std::cerr << file << ":" << line << ": failed " << what << std::endl;
+}
+
+inline int exit_code()
+{
+	if(failures() > 0)
+		std::cerr << failures() << " checks failed" << std::endl;
+
+	return failures() > 0 ? 1 : 0;
+}
+
+}
+
+#define CHECK(condition) \
+	gmt_test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cmath>
+#include <list>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/triangle-mesh.hpp>
+#include <gmt/thread-pool.hpp>
+#include <gmt/algorithm/convex-hull-3d.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+#include "check.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(20);
+
+template<typename T>
+point3d to_double(const point<T, 3>& p)
+{
+	return point3d{ double(p.x()), double(p.y()), double(p.z()) };
+}
+
+point2d project(const point3d& p, int i, int j)
+{
+	return point2d{ p[i], p[j] };
+}
+
+/*
+ * three points are collinear when their projections on the planes of
+ * the axes are
+ */
+bool collinear(const point3d& a, const point3d& b, const point3d& c)
+{
+	for(int axis=0; axis<3; axis++){
+		int i = (axis + 1)%3, j = (axis + 2)%3;
+
+		if(robust_direction_in(project(a, i, j), project(b, i, j), project(c, i, j)) != ON)
+			return false;
+	}
+
+	return true;
+}
+
+template<typename T>
+bool spans_volume(const std::vector<point<T, 3>>& points)
+{
+	for(const auto& b : points){
+		if(b == points[0])
+			continue;
+
+		for(const auto& c : points){
+			if(collinear(to_double(points[0]), to_double(b), to_double(c)))
+				continue;
+
+			for(const auto& d : points)
+				if(orient3d(to_double(points[0]), to_double(b), to_double(c), to_double(d)) != 0.0)
+					return true;
+
+			return false;
+		}
+
+		return false;
+	}
+
+	return false;
+}
+
+/*
+ * the mesh is the hull when its vertices are points of the set, its
+ * faces are triangles with area, every half-edge has its opposite once,
+ * the surface is a sphere by Euler's formula, and no point is outside
+ * the plane of a face
+ */
+template<typename T>
+void check_hull(const std::vector<point<T, 3>>& points, const triangle_mesh<T, 3>& mesh)
+{
+	if(!spans_volume(points)){
+		CHECK(mesh.empty());
+		return;
+	}
+
+	CHECK(!mesh.empty());
+
+	for(const auto& v : mesh.vertices)
+		CHECK(std::find(points.begin(), points.end(), v) != points.end());
+
+	std::map<std::pair<std::size_t, std::size_t>, int> half_edges;
+
+	for(std::size_t f=0; f<mesh.size(); f++){
+		const auto& t = mesh.triangles[f];
+		for(int k=0; k<3; k++)
+			half_edges[{ t[k], t[(k + 1)%3] }]++;
+
+		auto corners = mesh.corners(f);
+		point3d a = to_double(corners[0]);
+		point3d b = to_double(corners[1]);
+		point3d c = to_double(corners[2]);
+
+		CHECK(!collinear(a, b, c));
+
+		for(const auto& p : points)
+			CHECK(orient3d(a, b, c, to_double(p)) >= 0.0);
+	}
+
+	for(const auto& [edge, count] : half_edges){
+		CHECK(count == 1);
+		CHECK(half_edges.count({ edge.second, edge.first }) == 1);
+	}
+
+	long vertices = long(mesh.vertices.size());
+	long edges = long(half_edges.size()/2);
+	long faces = long(mesh.size());
+	CHECK(vertices - edges + faces == 2);
+}
+
+/*
+ * small grids, planes and cubes of integers, full of coplanar and
+ * repeated points, and real points in a cube or on a sphere
+ */
+void test_random_sets()
+{
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	for(int t=0; t<600; t++){
+		const int kind = t%5;
+		const std::size_t n = 1 + rng()%150;
+
+		std::vector<point3i> integers;
+		std::vector<point3d> reals;
+
+		for(std::size_t i=0; i<n; i++){
+			if(kind == 0){
+				integers.push_back(point3i{ int(rng()%4), int(rng()%4), int(rng()%4) });
+			}else if(kind == 1){
+				integers.push_back(point3i{ int(rng()%5), int(rng()%5), 0 });
+			}else if(kind == 2){
+				integers.push_back(point3i{ 5*int(rng()%3), 5*int(rng()%3), 5*int(rng()%3) });
+			}else if(kind == 3){
+				reals.push_back(point3d{ uniform(rng), uniform(rng), uniform(rng) });
+			}else{
+				double x = normal(rng), y = normal(rng), z = normal(rng);
+				double r = std::sqrt(x*x + y*y + z*z);
+				reals.push_back(point3d{ x/r, y/r, z/r });
+			}
+		}
+
+		if(kind < 3){
+			check_hull(integers, quickhull(integers));
+
+			std::list<point3i> list(integers.begin(), integers.end());
+			CHECK(quickhull(list).triangles == quickhull(integers).triangles);
+		}else{
+			check_hull(reals, quickhull(reals));
+		}
+	}
+}
+
+/*
+ * the first assignment of the points runs in the threads of the pool
+ * and gives the same hull
+ */
+void test_parallel()
+{
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	std::vector<point3d> points;
+	for(int i=0; i<3*int(quickhull_grain); i++)
+		points.push_back(point3d{ normal(rng), normal(rng), normal(rng) });
+
+	thread_pool pool(3);
+
+	triangle_mesh3d mesh = quickhull(points);
+	triangle_mesh3d parallel = quickhull(points, pool);
+
+	CHECK(parallel.vertices == mesh.vertices);
+	CHECK(parallel.triangles == mesh.triangles);
+
+	std::vector<point3d> some(points.begin(), points.begin() + 2000);
+	check_hull(some, quickhull(some));
+}
+
+int main()
+{
+	test_random_sets();
+	test_parallel();
+
+	return gmt_test::exit_code();
+}
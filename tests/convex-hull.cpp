@@ -0,0 +1,95 @@
+#include <cmath>
+#include <list>
+#include <random>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/algorithm/convex-hull.hpp>
+
+#include "check.hpp"
+#include "reference-hull.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(15);
+
+/*
+ * small integer sets with duplicates and collinear points
+ */
+template<typename T>
+std::vector<point<T, 2>> degenerate_points()
+{
+	const int n = rng()%40;
+	const int range = 1 + rng()%12;
+
+	return gmt_test::degenerate_points<T>(rng, n, range);
+}
+
+template<typename T>
+void test_against_gift_wrapping()
+{
+	for(int t=0; t<5000; t++){
+		std::vector<point<T, 2>> points = degenerate_points<T>();
+		polygon<T, 2> reference = gmt_test::gift_wrapping(points);
+
+		CHECK(monotone_chain_hull(points) == reference);
+		CHECK(merge_hull(points) == reference);
+
+		std::list<point<T, 2>> list(points.begin(), points.end());
+		CHECK(monotone_chain_hull(list) == reference);
+	}
+}
+
+void test_point_buffer()
+{
+	for(int t=0; t<2000; t++){
+		std::vector<point2d> points = degenerate_points<double>();
+		point_buffer2d buffer(points);
+
+		CHECK(monotone_chain_hull(buffer) == gmt_test::gift_wrapping(points));
+	}
+}
+
+/*
+ * large sets of real coordinates, with and without the Akl-Toussaint
+ * filter before the sort
+ */
+void test_large_sets()
+{
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	std::normal_distribution<double> normal(0.0, 1.0);
+
+	for(int kind=0; kind<3; kind++){
+		std::vector<point2d> points;
+
+		for(int i=0; i<20000; i++){
+			if(kind == 0){
+				points.push_back(point2d{ uniform(rng), uniform(rng) });
+			}else if(kind == 1){
+				points.push_back(point2d{ normal(rng), normal(rng) });
+			}else if(i < 2000){
+				double a = 4.0*uniform(rng);
+				points.push_back(point2d{ std::cos(a), std::sin(a) });
+			}
+		}
+
+		polygon2d hull = monotone_chain_hull(points);
+
+		CHECK(gmt_test::is_hull_of(hull, points));
+		CHECK(hull[0] == *std::min_element(points.begin(), points.end(), axis_comparator()));
+		CHECK(monotone_chain_hull(points, points.size() + 1) == hull);
+		CHECK(monotone_chain_hull(point_buffer2d(points)) == hull);
+	}
+}
+
+int main()
+{
+	test_against_gift_wrapping<double>();
+	test_against_gift_wrapping<int>();
+	test_point_buffer();
+	test_large_sets();
+
+	return gmt_test::exit_code();
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/vec.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/algorithm/convex-hull.hpp>
+#include <gmt/algorithm/dynamic-hull.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+#include "check.hpp"
+#include "reference-hull.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(17);
+
+/*
+ * the tangents from `q` by walking the hull: the first and the last
+ * vertex of the run of edges that have `q` on their right
+ */
+template<typename T>
+std::optional<std::pair<point<T, 2>, point<T, 2>>> walk_tangents(
+	const polygon<T, 2>& hull,
+	const point<T, 2>& q)
+{
+	const std::size_t n = hull.size();
+	if(n < 2)
+		return std::nullopt;
+
+	std::vector<bool> seen(n);
+	bool any = false;
+
+	for(std::size_t i=0; i<n; i++){
+		seen[i] = robust_direction_in(hull[i], hull[(i + 1)%n], q) == RIGHT;
+		any = any || seen[i];
+	}
+
+	if(!any)
+		return std::nullopt;
+
+	std::size_t first = 0;
+	for(std::size_t i=0; i<n; i++)
+		if(seen[i] && !seen[(i + n - 1)%n])
+			first = i;
+
+	std::size_t last = first;
+	while(seen[last%n])
+		last++;
+
+	return std::make_pair(hull[first], hull[last%n]);
+}
+
+/*
+ * random insertions and removals, after each one the hull, the extreme
+ * vertices and the tangents are compared with the ones of the points
+ * kept aside
+ */
+template<typename T, typename generator, typename reference>
+void test_operations(const generator& random_point, const reference& hull_of, int runs)
+{
+	for(int run=0; run<runs; run++){
+		dynamic_hull<T> dynamic;
+		std::vector<point<T, 2>> points;
+
+		const int operations = 1 + rng()%60;
+		for(int op=0; op<operations; op++){
+			if(!points.empty() && rng()%3 == 0){
+				std::size_t k = rng()%points.size();
+				CHECK(dynamic.erase(points[k]));
+				points.erase(points.begin() + k);
+			}else{
+				points.push_back(random_point());
+				dynamic.insert(points.back());
+			}
+
+			polygon<T, 2> hull = hull_of(points);
+
+			CHECK(dynamic.hull() == hull);
+			CHECK(dynamic.n_vertices() == hull.size());
+			CHECK(dynamic.size() == points.size());
+
+			for(int k=0; k<5; k++){
+				vec<T, 2> u({ T(int(rng()%7) - 3), T(int(rng()%7) - 3) });
+				std::optional<point<T, 2>> extreme = dynamic.extreme(u);
+
+				if(hull.empty()){
+					CHECK(!extreme);
+					continue;
+				}
+
+				double best = double(u.x())*double(hull[0].x()) + double(u.y())*double(hull[0].y());
+				for(const auto& v : hull)
+					best = std::max(best, double(u.x())*double(v.x()) + double(u.y())*double(v.y()));
+
+				CHECK(extreme && double(u.x())*double(extreme->x())
+					+ double(u.y())*double(extreme->y()) == best);
+
+				point<T, 2> q = random_point();
+				CHECK(dynamic.tangents(q) == walk_tangents(hull, q));
+			}
+		}
+	}
+}
+
+int main()
+{
+	auto gift_wrapping = [](const auto& points){
+		return gmt_test::gift_wrapping(points);
+	};
+
+	/*
+	 * a small grid has many duplicates and collinear points
+	 */
+	test_operations<int>(
+		[]{ return point2i{ int(rng()%7), int(rng()%7) }; },
+		gift_wrapping, 2000);
+
+	test_operations<int>(
+		[]{ return point2i{ int(rng()%100), int(rng()%100) }; },
+		gift_wrapping, 500);
+
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	test_operations<double>(
+		[&]{ return point2d{ uniform(rng), uniform(rng) }; },
+		[](const auto& points){ return monotone_chain_hull(points); }, 500);
+
+	return gmt_test::exit_code();
+}
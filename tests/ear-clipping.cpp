@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gmt/pi.hpp>
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/triangle-mesh.hpp>
+#include <gmt/algorithm/ear-clipping.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+#include "check.hpp"
+#include "reference-polygons.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(21);
+
+/*
+ * a comb of thin teeth on a base, every pass of the clipper cuts a few
+ */
+polygon2i comb(int teeth)
+{
+	polygon2i ring;
+	for(int i=0; i<teeth; i++){
+		ring.push_back(point2i{ 4*i, 0 });
+		ring.push_back(point2i{ 4*i + 1, 40 + int(rng()%20) });
+		ring.push_back(point2i{ 4*i + 2, 1 + int(rng()%3) });
+	}
+
+	ring.push_back(point2i{ 4*teeth, -5 });
+	ring.push_back(point2i{ 0, -5 });
+
+	return ring;
+}
+
+void test_integer_polygons()
+{
+	for(int t=0; t<3000; t++){
+		const int radius = 5 + rng()%60;
+		polygon2i ring = (t%10 == 0) ? comb(1 + rng()%20)
+			: gmt_test::random_star(rng, 3 + rng()%40, radius/4, radius/4 + radius - 1);
+		if(!gmt_test::are_simple(std::vector<polygon2i>{ ring }))
+			continue;
+
+		triangle_mesh2i mesh = ear_clipping_triangulation(ring);
+
+		CHECK(mesh.vertices.size() == ring.size());
+		CHECK(mesh.size() <= ring.size() - 2);
+		CHECK(gmt_test::is_triangulation_of(mesh, std::vector<polygon2i>{ ring }));
+	}
+}
+
+/*
+ * noisy circles of real coordinates have no collinear vertices, and
+ * give `n - 2` triangles whose areas add up to the one of the polygon
+ */
+void test_real_polygons()
+{
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+	for(int t=0; t<200; t++){
+		const std::size_t n = 3 + rng()%((t%20 == 0) ? 20000 : 300);
+		const double noise = 0.45*double(t%3);
+
+		polygon2d ring;
+		double area = 0.0;
+
+		for(std::size_t i=0; i<n; i++){
+			double a = 2.0*gmt::pi*double(i)/double(n);
+			double r = 1.0 - noise*uniform(rng);
+			ring.push_back(point2d{ r*std::cos(a), r*std::sin(a) });
+		}
+
+		for(std::size_t i=0; i<n; i++){
+			const point2d& p = ring[i];
+			const point2d& q = ring[(i + 1)%n];
+			area += (p.x()*q.y() - q.x()*p.y())/2.0;
+		}
+
+		triangle_mesh2d mesh = ear_clipping_triangulation(ring);
+		CHECK(mesh.size() == n - 2);
+
+		double sum = 0.0;
+		for(std::size_t f=0; f<mesh.size(); f++){
+			auto c = mesh.corners(f);
+			double twice = orient2d(c[0], c[1], c[2]);
+
+			CHECK(twice > 0.0);
+			sum += twice/2.0;
+		}
+
+		CHECK(std::fabs(sum - area) <= 1e-9*area);
+	}
+}
+
+/*
+ * with small budgets the clipper stops at some point and the ring left
+ * is triangulated by the monotone partition, the triangles of both are
+ * a triangulation of the polygon
+ */
+void test_fallback()
+{
+	for(std::size_t work : { 0, 1, 2 }){
+		ear_clipper<int> clipper(work);
+
+		for(int t=0; t<1000; t++){
+			const int radius = 5 + rng()%60;
+			polygon2i ring = (t%10 == 0) ? comb(1 + rng()%20)
+				: gmt_test::random_star(rng, 3 + rng()%60, radius/4, radius/4 + radius - 1);
+			if(!gmt_test::are_simple(std::vector<polygon2i>{ ring }))
+				continue;
+
+			triangle_mesh2i mesh;
+			mesh.vertices.assign(ring.begin(), ring.end());
+			clipper.triangulate(ring.data(), ring.size(), mesh.triangles);
+
+			CHECK(mesh.size() <= ring.size() - 2);
+			CHECK(gmt_test::is_triangulation_of(mesh, std::vector<polygon2i>{ ring }));
+		}
+	}
+}
+
+int main()
+{
+	test_integer_polygons();
+	test_real_polygons();
+	test_fallback();
+
+	return gmt_test::exit_code();
+}
@@ -0,0 +1,358 @@
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <gmt/exception.hpp>
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/polygon-set.hpp>
+#include <gmt/io/text.hpp>
+
+#include "check.hpp"
+
+using namespace gmt;
+
+std::mt19937_64 rng(11);
+
+/*
+ * coordinates of every magnitude, so the shortest forms of the writer
+ * have all lengths and exponents
+ */
+double random_coordinate()
+{
+	std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+	std::uniform_int_distribution<int> exponent(-40, 40);
+
+	return std::ldexp(mantissa(rng), exponent(rng));
+}
+
+polygon2d random_ring()
+{
+	polygon2d ring;
+
+	std::size_t n = 3 + rng()%10;
+	for(std::size_t i=0; i<n; i++)
+		ring.push_back(point2d{ random_coordinate(), random_coordinate() });
+
+	return ring;
+}
+
+/*
+ * enough polygons for the text to span many chunks
+ */
+polygon_set2d random_set()
+{
+	polygon_set2d set;
+
+	for(int i=0; i<3000; i++){
+		set.add_polygon(random_ring());
+
+		for(std::size_t h = rng()%3; h > 0; h--)
+			set.add_hole(random_ring());
+	}
+
+	return set;
+}
+
+bool same(const polygon_set2d& a, const polygon_set2d& b)
+{
+	return a.points() == b.points()
+		&& a.ring_offsets() == b.ring_offsets()
+		&& a.polygon_offsets() == b.polygon_offsets();
+}
+
+void test_round_trips()
+{
+	polygon_set2d set = random_set();
+
+	std::ostringstream wkt;
+	io::write_wkt(wkt, set);
+
+	std::istringstream wkt_in(wkt.str());
+	polygon_set2d from_wkt;
+	CHECK(io::read_wkt(wkt_in, from_wkt) == set.size());
+	CHECK(same(set, from_wkt));
+
+	std::ostringstream geojson;
+	io::write_geojson(geojson, set);
+
+	std::istringstream geojson_in(geojson.str());
+	polygon_set2d from_geojson;
+	CHECK(io::read_geojson(geojson_in, from_geojson) == set.size());
+	CHECK(same(set, from_geojson));
+
+	point_buffer2d points;
+	for(int i=0; i<20000; i++)
+		points.push_back(point2d{ random_coordinate(), random_coordinate() });
+
+	std::ostringstream csv;
+	io::write_csv(csv, points);
+
+	std::istringstream csv_in(csv.str());
+	point_buffer2d from_csv;
+	CHECK(io::read_csv(csv_in, from_csv) == points.size());
+	CHECK(from_csv.size() == points.size());
+
+	for(std::size_t i=0; i<points.size() && i<from_csv.size(); i++)
+		CHECK(from_csv[i] == points[i]);
+}
+
+/*
+ * the numbers that end right at the end of a chunk or cross it, with
+ * exponents that the part in the chunk would misread
+ */
+void test_chunk_boundaries()
+{
+	const char* tokens[] = { "1e5", "1e-5", "-1.25E+3", "12345.678", "1.5e10" };
+	const double values[] = { 1e5, 1e-5, -1.25e3, 12345.678, 1.5e10 };
+
+	for(int k=0; k<5; k++){
+		const std::string token = tokens[k];
+
+		for(std::size_t offset=0; offset<40; offset++){
+			const std::string padding(io::text_chunk_size - 20 + offset, ' ');
+
+			std::istringstream wkt(padding + "POINT (3 " + token + ") POINT (" + token + " 2)");
+			polygon_set2d set;
+			point_buffer2d points;
+
+			std::optional<std::size_t> n = io::try_read_wkt(wkt, set, &points);
+			CHECK(n && *n == 2);
+			CHECK(points.size() == 2 && points[0].y() == values[k] && points[1].x() == values[k]);
+
+			std::istringstream geojson(padding
+				+ "{\"type\":\"Point\",\"coordinates\":[" + token + "," + token + "]}");
+			point_buffer2d geojson_points;
+
+			CHECK(io::try_read_geojson(geojson, set, &geojson_points));
+			CHECK(geojson_points.size() == 1 && geojson_points[0].x() == values[k]);
+
+			std::istringstream csv(padding + "\n" + token + "," + token + "\n");
+			point_buffer2d csv_points;
+
+			CHECK(io::try_read_csv(csv, csv_points));
+			CHECK(csv_points.size() == 1 && csv_points[0].y() == values[k]);
+		}
+	}
+}
+
+void test_invalid_input()
+{
+	for(const char* text : { "POINT (inf 2)", "POINT (nan 2)", "POINT (-inf 2)", "POINT (1 infinity)" }){
+		std::istringstream in(text);
+		polygon_set2d set;
+		point_buffer2d points;
+
+		CHECK(!io::try_read_wkt(in, set, &points));
+	}
+
+	/*
+	 * a failed reader leaves the containers as they were
+	 */
+	polygon_set2d set;
+	set.add_polygon(polygon2d{ point2d{ 0, 0 }, point2d{ 1, 0 }, point2d{ 0, 1 } });
+	point_buffer2d points;
+	points.push_back(point2d{ 7, 7 });
+
+	const polygon_set2d before = set;
+
+	std::istringstream wkt("POLYGON ((0 0, 1 0, 1 1, 0 0)) POINT (1 2) POLYGON ((5 5, 6 5, x");
+	CHECK(!io::try_read_wkt(wkt, set, &points));
+	CHECK(same(set, before));
+	CHECK(points.size() == 1);
+
+	std::istringstream geojson(
+		"{\"type\":\"Polygon\",\"coordinates\":[[[0,0],[1,0],[1,1]]]}"
+		"{\"type\":\"MultiPoint\",\"coordinates\":[[1,2],[3,]]}");
+	CHECK(!io::try_read_geojson(geojson, set, &points));
+	CHECK(same(set, before));
+	CHECK(points.size() == 1);
+
+	/*
+	 * the ring grows after the rollback as if nothing was read
+	 */
+	set.add_polygon(polygon2d{ point2d{ 0, 0 }, point2d{ 2, 0 }, point2d{ 2, 2 } });
+	CHECK(set.size() == 2 && set[1].boundary().size() == 3);
+}
+
+/*
+ * the members of a GeoJSON object come in any order, the coordinates
+ * of a line read before its type are taken back
+ */
+void test_geojson_member_order()
+{
+	struct {
+		const char* text;
+		std::size_t polygons;
+		std::size_t points;
+	} cases[] = {
+		{ "{\"coordinates\":[[[0,0],[1,0]],[[2,2],[3,3],[4,4]]],\"type\":\"MultiLineString\"}", 0, 0 },
+		{ "{\"coordinates\":[[0,0],[1,0]],\"type\":\"LineString\"}", 0, 0 },
+		{ "{\"coordinates\":[[[0,0],[1,0],[1,1]]],\"type\":\"Polygon\"}", 1, 0 },
+		{ "{\"coordinates\":[[0,0],[1,0]],\"type\":\"MultiPoint\"}", 0, 2 },
+		{ "{\"type\":\"MultiLineString\",\"coordinates\":[[[0,0],[1,0]]]}", 0, 0 },
+		{ "{\"type\":\"FeatureCollection\",\"features\":["
+			"{\"type\":\"Feature\",\"geometry\":{\"coordinates\":[[0,0],[1,0]],\"type\":\"LineString\"}},"
+			"{\"type\":\"Feature\",\"geometry\":{\"coordinates\":[[[0,0],[1,0],[1,1]]],\"type\":\"Polygon\"}}]}", 1, 0 }
+	};
+
+	for(const auto& c : cases){
+		std::istringstream in(c.text);
+		polygon_set2d set;
+		point_buffer2d points;
+
+		std::optional<std::size_t> n = io::try_read_geojson(in, set, &points);
+		CHECK(n && *n == c.polygons + c.points);
+		CHECK(set.size() == c.polygons);
+		CHECK(points.size() == c.points);
+	}
+}
+
+/*
+ * empty polygons read back as empty polygons, and empty rings are not
+ * written
+ */
+void test_empty_polygons()
+{
+	polygon_set2d set;
+	set.new_polygon();
+	set.add_polygon(polygon2d{ point2d{ 0, 0 }, point2d{ 1, 0 }, point2d{ 0, 1 } });
+	set.add_hole(polygon2d{});
+	set.new_polygon();
+	set.add_hole(polygon2d{});
+	set.add_polygon(polygon2d{ point2d{ 5, 5 }, point2d{ 6, 5 }, point2d{ 5, 6 } });
+
+	polygon_set2d expected;
+	expected.new_polygon();
+	expected.add_polygon(polygon2d{ point2d{ 0, 0 }, point2d{ 1, 0 }, point2d{ 0, 1 } });
+	expected.new_polygon();
+	expected.add_polygon(polygon2d{ point2d{ 5, 5 }, point2d{ 6, 5 }, point2d{ 5, 6 } });
+
+	std::ostringstream wkt;
+	io::write_wkt(wkt, set);
+	std::istringstream wkt_in(wkt.str());
+	polygon_set2d from_wkt;
+	CHECK(io::try_read_wkt(wkt_in, from_wkt) == std::optional<std::size_t>(4));
+	CHECK(same(expected, from_wkt));
+
+	std::ostringstream geojson;
+	io::write_geojson(geojson, set);
+	std::istringstream geojson_in(geojson.str());
+	polygon_set2d from_geojson;
+	CHECK(io::try_read_geojson(geojson_in, from_geojson) == std::optional<std::size_t>(4));
+	CHECK(same(expected, from_geojson));
+
+	for(std::size_t i=0; i<set.size(); i++){
+		std::ostringstream one_wkt, one_geojson;
+		io::write_wkt(one_wkt, set[i]);
+		io::write_geojson(one_geojson, set[i]);
+
+		std::istringstream one_wkt_in(one_wkt.str()), one_geojson_in(one_geojson.str());
+		polygon_set2d a, b;
+		CHECK(io::try_read_wkt(one_wkt_in, a) == std::optional<std::size_t>(1));
+		CHECK(io::try_read_geojson(one_geojson_in, b) == std::optional<std::size_t>(1));
+		CHECK(a.size() == 1 && a[0].n_rings() == expected[i].n_rings());
+		CHECK(b.size() == 1 && b[0].n_rings() == expected[i].n_rings());
+	}
+
+	std::ostringstream empty_ring;
+	io::write_wkt(empty_ring, polygon2d{});
+	std::istringstream empty_ring_in(empty_ring.str());
+	polygon_set2d from_empty_ring;
+	CHECK(io::try_read_wkt(empty_ring_in, from_empty_ring) == std::optional<std::size_t>(1));
+}
+
+/*
+ * the writers refuse the coordinates the readers would refuse, and
+ * write nothing
+ */
+void test_non_finite_output()
+{
+	const double bad[] = {
+		std::numeric_limits<double>::infinity(),
+		-std::numeric_limits<double>::infinity(),
+		std::numeric_limits<double>::quiet_NaN()
+	};
+
+	for(double v : bad){
+		polygon2d ring{ point2d{ 0, 0 }, point2d{ v, 0 }, point2d{ 0, 1 } };
+		polygon_set2d set;
+		set.add_polygon(ring);
+		point_buffer2d points;
+		points.push_back(point2d{ 1, v });
+
+		auto throws = [](auto write){
+			std::ostringstream out;
+			try{
+				write(out);
+			}catch(const gmt::exception&){
+				return out.str().empty();
+			}
+			return false;
+		};
+
+		CHECK(throws([&](std::ostream& out){ io::write_wkt(out, ring); }));
+		CHECK(throws([&](std::ostream& out){ io::write_wkt(out, set); }));
+		CHECK(throws([&](std::ostream& out){ io::write_wkt(out, point2d{ v, 0 }); }));
+		CHECK(throws([&](std::ostream& out){ io::write_geojson(out, ring); }));
+		CHECK(throws([&](std::ostream& out){ io::write_geojson(out, set); }));
+		CHECK(throws([&](std::ostream& out){ io::write_csv(out, points); }));
+	}
+}
+
+/*
+ * nesting past `text_max_depth` fails the parse instead of the stack,
+ * and nesting below it is read
+ */
+void test_deep_nesting()
+{
+	const std::size_t deep = 1000000;
+
+	std::istringstream arrays(std::string(deep, '['));
+	polygon_set2d set;
+	CHECK(!io::try_read_geojson(arrays, set));
+
+	std::string objects;
+	for(std::size_t i=0; i<deep/8; i++)
+		objects += "{\"a\":";
+	std::istringstream objects_in(objects);
+	CHECK(!io::try_read_geojson(objects_in, set));
+
+	std::string collections;
+	for(std::size_t i=0; i<deep/20; i++)
+		collections += "GEOMETRYCOLLECTION (";
+	std::istringstream collections_in(collections);
+	CHECK(!io::try_read_wkt(collections_in, set));
+
+	const std::size_t shallow = io::text_max_depth - 2;
+
+	std::string nested = "{\"type\":\"Feature\",\"properties\":" + std::string(shallow, '[')
+		+ std::string(shallow, ']') + ",\"geometry\":{\"type\":\"Point\",\"coordinates\":[1,2]}}";
+	std::istringstream nested_in(nested);
+	point_buffer2d points;
+	CHECK(io::try_read_geojson(nested_in, set, &points) == std::optional<std::size_t>(1));
+
+	std::string wkt = "POINT (1 2)";
+	for(std::size_t i=0; i<shallow; i++)
+		wkt = "GEOMETRYCOLLECTION (" + wkt + ")";
+	std::istringstream wkt_in(wkt);
+	CHECK(io::try_read_wkt(wkt_in, set, &points) == std::optional<std::size_t>(1));
+	CHECK(set.empty() && points.size() == 2);
+}
+
+int main()
+{
+	test_round_trips();
+	test_chunk_boundaries();
+	test_invalid_input();
+	test_geojson_member_order();
+	test_empty_polygons();
+	test_non_finite_output();
+	test_deep_nesting();
+
+	return gmt_test::exit_code();
+}
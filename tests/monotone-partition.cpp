@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gmt/pi.hpp>
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-with-holes.hpp>
+#include <gmt/segment.hpp>
+#include <gmt/triangle-mesh.hpp>
+#include <gmt/algorithm/direction.hpp>
+#include <gmt/algorithm/monotone-partition.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+#include "check.hpp"
+#include "reference-polygons.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(22);
+
+/*
+ * a piece is y-monotone when its ring has a single highest turn
+ */
+template<typename T>
+bool is_monotone(const std::vector<point<T, 2>>& points, const std::size_t* first, const std::size_t* last)
+{
+	const std::size_t k = last - first;
+	std::size_t maxima = 0;
+
+	for(std::size_t i=0; i<k; i++){
+		const auto& a = points[first[(i + k - 1)%k]];
+		const auto& b = points[first[i]];
+		const auto& c = points[first[(i + 1)%k]];
+
+		if(is_below(a, b) && is_below(c, b))
+			maxima++;
+	}
+
+	return k >= 3 && maxima == 1;
+}
+
+/*
+ * the diagonals join two vertices and cross no edge, the pieces are
+ * monotone, the triangles tile the polygon and the half-edges of the
+ * dcel are linked
+ */
+void check_partition(const polygon_with_holes2i& poly)
+{
+	std::vector<polygon2i> rings{ poly.boundary() };
+	rings.insert(rings.end(), poly.holes().begin(), poly.holes().end());
+
+	std::vector<segment2i> edges = gmt_test::edges_of(rings);
+
+	monotone_partitioner<int> partitioner;
+	partitioner.partition(poly);
+
+	const auto& points = partitioner.vertices();
+
+	for(const auto& d : partitioner.diagonals()){
+		CHECK(points[d.first] != points[d.second]);
+
+		segment2i diagonal(points[d.first], points[d.second]);
+		for(const auto& e : edges)
+			CHECK(gmt_test::contact(diagonal, e) != intersection::PROPER);
+	}
+
+	std::size_t n_pieces = 0;
+	partitioner.pieces([&](const std::size_t* first, const std::size_t* last){
+		CHECK(is_monotone(points, first, last));
+		n_pieces++;
+	});
+
+	CHECK(gmt_test::is_triangulation_of(monotone_triangulation(poly), rings));
+
+	auto d = monotone_partition(poly);
+	CHECK(d->n_face() == n_pieces);
+
+	for(std::size_t i=0; i<d->n_edge(); i++){
+		const auto* e = d->edge_at(i);
+
+		CHECK(e->twin->twin == e);
+		CHECK(e->next->prev == e);
+		CHECK(e->next->origin == e->destination);
+		CHECK(e->next->incident_face == e->incident_face);
+	}
+}
+
+/*
+ * a star boundary around holes in the cells of a grid, the sets whose
+ * rings meet after rounding are skipped
+ */
+void test_integer_polygons()
+{
+	for(int t=0; t<2000; t++){
+		polygon_with_holes2i poly;
+		poly.boundary() = gmt_test::random_star(rng, 6 + rng()%40, 60, 120);
+
+		const int holes = (t%4 == 0) ? 0 : rng()%9;
+		for(int h=0; h<holes; h++){
+			point2i center{ 20*(h%3 - 1), 20*(h/3 - 1) };
+			poly.add_hole(gmt_test::random_star(rng, 3 + rng()%10, 2, 8, center));
+		}
+
+		std::vector<polygon2i> rings{ poly.boundary() };
+		rings.insert(rings.end(), poly.holes().begin(), poly.holes().end());
+		if(!gmt_test::are_simple(rings))
+			continue;
+
+		check_partition(poly);
+	}
+}
+
+/*
+ * noisy circles of real coordinates with triangular holes: no vertex is
+ * dropped, so there are `v + 2h - 2` triangles for `v` vertices and `h`
+ * holes, and their areas add up to the one of the polygon
+ */
+void test_real_polygons()
+{
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+	auto signed_area = [](const polygon2d& ring){
+		double a = 0.0;
+		for(std::size_t i=0; i<ring.size(); i++){
+			const point2d& p = ring[i];
+			const point2d& q = ring[(i + 1)%ring.size()];
+			a += (p.x()*q.y() - q.x()*p.y())/2.0;
+		}
+		return a;
+	};
+
+	for(int t=0; t<200; t++){
+		const std::size_t n = 3 + rng()%((t%20 == 0) ? 100000 : 300);
+		const double noise = 0.2*double(t%3);
+
+		polygon_with_holes2d poly;
+		for(std::size_t i=0; i<n; i++){
+			double a = 2.0*gmt::pi*double(i)/double(n);
+			double r = 1.0 - noise*uniform(rng);
+			poly.boundary().push_back(point2d{ r*std::cos(a), r*std::sin(a) });
+		}
+
+		const std::size_t holes = rng()%5;
+		for(std::size_t h=0; h<holes; h++){
+			double x = 0.2*double(h) - 0.4, y = 0.1*uniform(rng);
+			polygon2d hole;
+			hole.push_back(point2d{ x, y });
+			hole.push_back(point2d{ x + 0.05*uniform(rng), y + 0.05 });
+			hole.push_back(point2d{ x + 0.1, y });
+			poly.add_hole(hole);
+		}
+
+		double area = std::fabs(signed_area(poly.boundary()));
+		for(const auto& hole : poly.holes())
+			area -= std::fabs(signed_area(hole));
+
+		triangle_mesh2d mesh = monotone_triangulation(poly);
+		CHECK(mesh.size() == n + 3*holes + 2*holes - 2);
+
+		double sum = 0.0;
+		for(std::size_t f=0; f<mesh.size(); f++){
+			auto c = mesh.corners(f);
+			double twice = orient2d(c[0], c[1], c[2]);
+
+			CHECK(twice > 0.0);
+			sum += twice/2.0;
+		}
+
+		CHECK(std::fabs(sum - area) <= 1e-9*area);
+	}
+}
+
+int main()
+{
+	test_integer_polygons();
+	test_real_polygons();
+
+	return gmt_test::exit_code();
+}
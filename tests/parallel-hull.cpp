@@ -0,0 +1,75 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/thread-pool.hpp>
+#include <gmt/algorithm/convex-hull.hpp>
+
+#include "check.hpp"
+#include "reference-hull.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(16);
+
+/*
+ * integer sets with duplicates and collinear points, the slices of a
+ * few points make every merge of the reduction tree run
+ */
+template<typename T>
+std::vector<point<T, 2>> degenerate_points()
+{
+	const int n = rng()%120;
+	const int range = 1 + rng()%30;
+
+	return gmt_test::degenerate_points<T>(rng, n, range);
+}
+
+template<typename T>
+void test_small_slices(thread_pool& pool)
+{
+	for(int t=0; t<3000; t++){
+		std::vector<point<T, 2>> points = degenerate_points<T>();
+		std::size_t cutoff = 3 + rng()%10;
+
+		CHECK(parallel_hull(points, pool, cutoff) == gmt_test::gift_wrapping(points));
+	}
+}
+
+/*
+ * a set larger than the default slices, through the default pool
+ */
+void test_large_set(thread_pool& pool)
+{
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+	std::vector<point2d> points;
+	for(int i=0; i<300000; i++)
+		points.push_back(point2d{ uniform(rng), uniform(rng) });
+
+	polygon2d hull = monotone_chain_hull(points);
+
+	CHECK(gmt_test::is_hull_of(hull, points));
+	CHECK(parallel_hull(points) == hull);
+	CHECK(parallel_hull(points, pool, 1000) == hull);
+	CHECK(parallel_hull(point_buffer2d(points), pool, 1000) == hull);
+}
+
+int main()
+{
+	/*
+	 * without workers the caller runs every task
+	 */
+	thread_pool inline_pool(0);
+	thread_pool pool(3);
+
+	test_small_slices<double>(inline_pool);
+	test_small_slices<double>(pool);
+	test_small_slices<int>(pool);
+	test_large_set(pool);
+
+	return gmt_test::exit_code();
+}
@@ -0,0 +1,149 @@
+#include <random>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-set.hpp>
+#include <gmt/polygon-with-holes.hpp>
+#include <gmt/algorithm/point-in-polygon.hpp>
+#include <gmt/algorithm/point-locator.hpp>
+
+#include "check.hpp"
+#include "reference-polygons.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(12);
+
+polygon2d to_double(const polygon2i& ring)
+{
+	polygon2d d;
+	for(const auto& p : ring)
+		d.push_back(point2d{ double(p.x()), double(p.y()) });
+
+	return d;
+}
+
+/*
+ * points of the lattice around the rings, which fall on their vertices,
+ * on their edges and on the heights of their vertices, the midpoints of
+ * the edges and points of real coordinates
+ */
+std::vector<point2d> queries(const std::vector<polygon2i>& rings, int range)
+{
+	std::uniform_real_distribution<double> uniform(-range, range);
+	std::vector<point2d> q;
+
+	for(int k=0; k<300; k++)
+		q.push_back(point2d{ double(int(rng()%(2*range + 1)) - range),
+			double(int(rng()%(2*range + 1)) - range) });
+
+	for(int k=0; k<100; k++)
+		q.push_back(point2d{ uniform(rng), uniform(rng) });
+
+	for(const auto& ring : rings){
+		for(std::size_t i=0; i<ring.size(); i++){
+			const auto& a = ring[i];
+			const auto& b = ring[(i + 1)%ring.size()];
+
+			q.push_back(point2d{ double(a.x()), double(a.y()) });
+			q.push_back(point2d{ 0.5*(a.x() + b.x()), 0.5*(a.y() + b.y()) });
+			q.push_back(point2d{ double(a.x()) + 0.5, double(a.y()) });
+		}
+	}
+
+	return q;
+}
+
+/*
+ * a star around the origin with up to two stars as holes, the locators
+ * of the polygon, of the polygon with holes and of its view in a set
+ * answer as `side_of`
+ */
+void test_random_polygons()
+{
+	for(int t=0; t<400; t++){
+		const int high = 6 + rng()%20;
+		const int low = high/2 + 1;
+		const std::size_t n = 6 + rng()%30;
+
+		std::vector<polygon2i> rings{ gmt_test::random_star(rng, n, low, high) };
+
+		/*
+		 * the holes are in the disc of radius `low*cos(30)` which the
+		 * boundary holds, one around the center or two beside it
+		 */
+		const int room = (low*3)/4;
+		if(room >= 4){
+			if(rng()%2){
+				rings.push_back(gmt_test::random_star(rng, 3 + rng()%10, 1, room - 1));
+			}else{
+				const int r = room/2;
+				rings.push_back(gmt_test::random_star(rng, 3 + rng()%6, 1, r - 1, point2i{ -r, 0 }));
+				rings.push_back(gmt_test::random_star(rng, 3 + rng()%6, 1, r - 1, point2i{ r, 0 }));
+			}
+		}
+
+		if(!gmt_test::are_simple(rings))
+			continue;
+
+		polygon2d boundary = to_double(rings[0]);
+		polygon_with_holes2d with_holes;
+		with_holes.boundary() = boundary;
+		for(std::size_t r=1; r<rings.size(); r++)
+			with_holes.add_hole(to_double(rings[r]));
+
+		polygon_set2d set;
+		set.add_polygon(with_holes);
+
+		prepared_polygon_locator plain(boundary);
+		prepared_polygon_locator holes(with_holes);
+		prepared_polygon_locator view(set[0]);
+
+		CHECK(plain.stats().n_slabs > 0);
+		CHECK(holes.stats().memory_bytes > 0);
+
+		for(const auto& p : queries(rings, 2*high + 2)){
+			CHECK(plain.locate(p) == side_of(boundary, p));
+			CHECK(holes.locate(p) == side_of(with_holes, p));
+			CHECK(view.locate(p) == side_of(set[0], p));
+		}
+	}
+}
+
+/*
+ * rings of horizontal edges and collinear vertices, a rectangle with a
+ * notch, where the levels of the vertices hold whole edges
+ */
+void test_horizontal_edges()
+{
+	polygon2d ring{
+		point2d{ 0, 0 }, point2d{ 2, 0 }, point2d{ 4, 0 }, point2d{ 4, 2 },
+		point2d{ 3, 2 }, point2d{ 3, 1 }, point2d{ 1, 1 }, point2d{ 1, 2 },
+		point2d{ 0, 2 }, point2d{ 0, 1 } };
+
+	prepared_polygon_locator locator(ring);
+
+	for(int x=-2; x<=10; x++){
+		for(int y=-2; y<=6; y++){
+			point2d p{ 0.5*x, 0.5*y };
+			CHECK(locator.locate(p) == side_of(ring, p));
+		}
+	}
+
+	CHECK(locator.locate(point2d{ 2, 1 }) == ON_BONDARY);
+	CHECK(locator.locate(point2d{ 2, 1.5 }) == OUTSIDE);
+	CHECK(locator.locate(point2d{ 0.5, 1.5 }) == INSIDE);
+	CHECK(side_of(locator, point2d{ 4, 2 }) == ON_BONDARY);
+
+	prepared_polygon_locator none(polygon2d{});
+	CHECK(none.locate(point2d{ 0, 0 }) == OUTSIDE);
+}
+
+int main()
+{
+	test_random_polygons();
+	test_horizontal_edges();
+
+	return gmt_test::exit_code();
+}
@@ -0,0 +1,154 @@
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gmt/pi.hpp>
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-with-holes.hpp>
+#include <gmt/prepared-polygon.hpp>
+#include <gmt/segment.hpp>
+#include <gmt/algorithm/intersection.hpp>
+#include <gmt/algorithm/polygon-simplicity.hpp>
+
+#include "check.hpp"
+#include "reference-polygons.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(24);
+
+polygon2i random_ring(int range, std::size_t n)
+{
+	polygon2i ring;
+	for(std::size_t i=0; i<n; i++)
+		ring.push_back(point2i{ int(rng()%range), int(rng()%range) });
+
+	return ring;
+}
+
+/*
+ * rings of a few points of a small grid, simple or not in every way:
+ * repeated vertices, spikes, edges through vertices and overlaps
+ */
+void test_rings()
+{
+	for(int t=0; t<100000; t++){
+		polygon2i ring = random_ring(2 + rng()%6, 1 + rng()%9);
+		std::vector<polygon2i> rings{ ring };
+
+		bool simple = gmt_test::are_simple(rings);
+		auto found = first_self_intersection(ring);
+
+		CHECK(is_simple(ring) == simple);
+		CHECK(prepared_polygon2i(ring).is_simple() == simple);
+		if(ring.size() >= 3)
+			CHECK(simple == !found);
+
+		/*
+		 * the edge of a ring of one vertex is a point, and its own
+		 * next edge
+		 */
+		if(found){
+			std::vector<segment2i> edges = gmt_test::edges_of(rings);
+			CHECK(found->first < found->second || (ring.size() == 1 && found->first == 0));
+			CHECK(found->second < edges.size());
+			CHECK(gmt_test::contact(edges[found->first], edges[found->second]) != intersection::NONE);
+		}
+	}
+}
+
+/*
+ * a boundary and holes of a small grid, which are simple when every
+ * ring is and no two of them meet
+ */
+void test_polygons_with_holes()
+{
+	for(int t=0; t<30000; t++){
+		const int range = 3 + rng()%6;
+
+		polygon_with_holes2i poly;
+		poly.boundary() = random_ring(range, 3 + rng()%5);
+
+		const int holes = rng()%3;
+		for(int h=0; h<holes; h++)
+			poly.add_hole(random_ring(range, 3 + rng()%4));
+
+		std::vector<polygon2i> rings{ poly.boundary() };
+		rings.insert(rings.end(), poly.holes().begin(), poly.holes().end());
+
+		CHECK(is_simple(poly) == gmt_test::are_simple(rings));
+		CHECK(!first_self_intersection(poly) == gmt_test::are_simple(rings));
+	}
+}
+
+/*
+ * rings of real vertices a few representable points apart, whose edges
+ * cross or touch closer to each other than any rounding: the tests of
+ * the sweep are exact
+ */
+void test_clustered_rings()
+{
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+
+	for(int t=0; t<20000; t++){
+		const std::size_t n = 3 + rng()%8;
+
+		polygon2d ring;
+		for(std::size_t i=0; i<n; i++)
+			ring.push_back(point2d{ 0.5 + 1e-15*std::round(8.0*uniform(rng)), 0.5 + 1e-14*uniform(rng) });
+
+		std::vector<polygon2d> rings{ ring };
+		auto found = first_self_intersection(ring);
+
+		CHECK(!found == gmt_test::are_simple(rings));
+		if(found){
+			std::vector<segment2d> edges = gmt_test::edges_of(rings);
+			CHECK(found->first < found->second);
+			CHECK(gmt_test::contact(edges[found->first], edges[found->second]) != intersection::NONE);
+		}
+	}
+}
+
+/*
+ * a large noisy circle is simple, and two of its vertices swapped make
+ * edges that cross
+ */
+void test_large_ring()
+{
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+	const std::size_t n = 100000;
+
+	polygon2d ring;
+	for(std::size_t i=0; i<n; i++){
+		double a = 2.0*gmt::pi*double(i)/double(n);
+		double r = 1.0 - 0.5*uniform(rng);
+		ring.push_back(point2d{ r*std::cos(a), r*std::sin(a) });
+	}
+
+	CHECK(is_simple(ring));
+
+	std::swap(ring[n/3], ring[n/2]);
+	auto found = first_self_intersection(ring);
+
+	CHECK(!is_simple(ring));
+	CHECK(found && found->first < found->second);
+
+	if(found){
+		segment2d s(ring[found->first], ring[(found->first + 1)%n]);
+		segment2d t(ring[found->second], ring[(found->second + 1)%n]);
+		CHECK(gmt_test::contact(s, t) != intersection::NONE);
+	}
+}
+
+int main()
+{
+	test_rings();
+	test_polygons_with_holes();
+	test_clustered_rings();
+	test_large_ring();
+
+	return gmt_test::exit_code();
+}
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gmt/pi.hpp>
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/segment.hpp>
+#include <gmt/algorithm/distance.hpp>
+#include <gmt/algorithm/intersection.hpp>
+#include <gmt/algorithm/point-in-polygon.hpp>
+#include <gmt/algorithm/polygon-visibility.hpp>
+
+#include "check.hpp"
+#include "reference-polygons.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(25);
+
+/*
+ * random points of the scene are inside the visibility polygon exactly
+ * when no edge meets their segment from `p`. The points are in general
+ * position, so their segments pass through no vertex, and the ones near
+ * the rounded boundary of the polygon are skipped.
+ */
+void check_samples(
+	const point2d& p,
+	const std::vector<polygon2d>& rings,
+	const polygon2d& visibility,
+	double low,
+	double high)
+{
+	std::uniform_real_distribution<double> uniform(low, high);
+	std::vector<segment2d> edges = gmt_test::edges_of(rings);
+
+	for(int k=0; k<30; k++){
+		point2d q{ uniform(rng), uniform(rng) };
+
+		bool near = false;
+		for(std::size_t i=0; i<visibility.size() && !near; i++){
+			segment2d side(visibility[i], visibility[(i + 1)%visibility.size()]);
+			near = distance(q, side) < 1e-6;
+		}
+
+		if(near)
+			continue;
+
+		segment2d ray(p, q);
+		bool visible = std::none_of(edges.begin(), edges.end(), [&](const segment2d& e){
+			return gmt_test::contact(ray, e) != intersection::NONE;
+		});
+
+		CHECK(visible == (side_of(visibility, q) == INSIDE));
+	}
+}
+
+/*
+ * the point is strictly inside the boundary, the first ring, and out of
+ * the others
+ */
+bool is_free(const point2d& p, const std::vector<polygon2d>& rings)
+{
+	if(side_of(rings[0], p) != INSIDE)
+		return false;
+
+	for(std::size_t r=1; r<rings.size(); r++)
+		if(side_of(rings[r], p) != OUTSIDE)
+			return false;
+
+	return true;
+}
+
+/*
+ * a ring of points of the lattice around `center`, one for each
+ * direction, which makes many vertices and edges in line with each other
+ * and with the points of half coordinates
+ */
+polygon2d lattice_star(const point2d& center, int radius)
+{
+	std::map<double, point2d> by_angle;
+
+	for(int dx=-radius; dx<=radius; dx++){
+		for(int dy=-radius; dy<=radius; dy++){
+			if((dx == 0 && dy == 0) || rng()%3 != 0)
+				continue;
+
+			by_angle.emplace(std::atan2(double(dy), double(dx)),
+				point2d{ center.x() + dx, center.y() + dy });
+		}
+	}
+
+	polygon2d star;
+	for(const auto& [angle, q] : by_angle)
+		star.push_back(q);
+
+	if(rng()%2)
+		std::reverse(star.begin(), star.end());
+
+	return star;
+}
+
+/*
+ * stars of the lattice in the cells of a grid, in a square, seen from a
+ * point of integer or half coordinates; the scenes whose rings cross
+ * after all are skipped
+ */
+void test_lattice_scenes()
+{
+	visibility_sweep<double> sweep;
+	polygon2d visibility;
+
+	for(int t=0; t<3000; t++){
+		const int cells = 1 + rng()%3;
+		const int radius = 1 + rng()%3;
+		const int width = (2*radius + 2)*cells;
+		const double w = double(width);
+
+		std::vector<polygon2d> rings{
+			polygon2d{ point2d{ -1, -1 }, point2d{ w, -1 }, point2d{ w, w }, point2d{ -1, w } } };
+
+		for(int i=0; i<cells; i++){
+			for(int j=0; j<cells; j++){
+				if(rng()%4 == 0)
+					continue;
+
+				point2d center{ double(radius + (2*radius + 2)*i), double(radius + (2*radius + 2)*j) };
+				polygon2d star = lattice_star(center, radius);
+
+				if(star.size() >= 3)
+					rings.push_back(star);
+			}
+		}
+
+		point2d p{
+			double(rng()%(width + 1)) - 0.5*double(rng()%2),
+			double(rng()%(width + 1)) - 0.5*double(rng()%2) };
+
+		if(!gmt_test::are_simple(rings) || !is_free(p, rings))
+			continue;
+
+		sweep.compute(p, rings, visibility);
+
+		CHECK(gmt_test::are_simple(std::vector<polygon2d>{ visibility }));
+		CHECK(visibility == polygon_visibility_sweep(p, rings));
+
+		check_samples(p, rings, visibility, -1.0, w);
+	}
+}
+
+/*
+ * the polygons of the rotational sweep and of the ray casting of
+ * `polygon_visibility` have the same points, once the repeated points
+ * of the latter are merged
+ */
+bool same_points(const polygon2d& rays, const polygon2d& sweep)
+{
+	polygon2d merged;
+	for(const auto& q : rays)
+		if(merged.empty() || distance(merged.back(), q) > 1e-9)
+			merged.push_back(q);
+
+	while(merged.size() > 1 && distance(merged.back(), merged.front()) < 1e-9)
+		merged.pop_back();
+
+	if(merged.size() != sweep.size())
+		return false;
+
+	auto rounded_less = [](const point2d& a, const point2d& b){
+		return std::make_pair(std::round(a.x()*1e7), std::round(a.y()*1e7))
+			< std::make_pair(std::round(b.x()*1e7), std::round(b.y()*1e7));
+	};
+
+	polygon2d sorted = sweep;
+	std::sort(merged.begin(), merged.end(), rounded_less);
+	std::sort(sorted.begin(), sorted.end(), rounded_less);
+
+	for(std::size_t i=0; i<sorted.size(); i++)
+		if(distance(merged[i], sorted[i]) > 1e-7)
+			return false;
+
+	return true;
+}
+
+/*
+ * noisy stars of real coordinates in the cells of a grid, in general
+ * position, against the ray casting
+ */
+void test_real_scenes()
+{
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+	for(int t=0; t<300; t++){
+		const int cells = 1 + rng()%5;
+		const std::size_t n = 3 + rng()%8;
+		const double w = double(cells);
+
+		std::vector<polygon2d> rings{
+			polygon2d{ point2d{ -0.1, -0.1 }, point2d{ w + 0.1, -0.1 },
+				point2d{ w + 0.1, w + 0.1 }, point2d{ -0.1, w + 0.1 } } };
+
+		for(int i=0; i<cells; i++){
+			for(int j=0; j<cells; j++){
+				if(uniform(rng) > 0.6)
+					continue;
+
+				polygon2d star;
+				for(std::size_t k=0; k<n; k++){
+					double a = 2.0*gmt::pi*(double(k) + 0.3*uniform(rng))/double(n);
+					double r = 0.35*(1.0 - 0.6*uniform(rng));
+					star.push_back(point2d{ i + 0.5 + r*std::cos(a), j + 0.5 + r*std::sin(a) });
+				}
+
+				if(rng()%2)
+					std::reverse(star.begin(), star.end());
+
+				rings.push_back(star);
+			}
+		}
+
+		/*
+		 * a corner of a cell, out of its star
+		 */
+		point2d p{
+			double(rng()%cells) + 0.5 + ((uniform(rng) > 0.5) ? 0.49 : -0.49),
+			double(rng()%cells) + 0.5 + ((uniform(rng) > 0.5) ? 0.49 : -0.49) };
+
+		polygon2d visibility = polygon_visibility_sweep(p, rings);
+
+		CHECK(same_points(polygon_visibility(p, rings), visibility));
+		CHECK(gmt_test::are_simple(std::vector<polygon2d>{ visibility }));
+
+		check_samples(p, rings, visibility, -0.1, w + 0.1);
+	}
+}
+
+int main()
+{
+	test_lattice_scenes();
+	test_real_scenes();
+
+	return gmt_test::exit_code();
+}
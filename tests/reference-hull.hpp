@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gmt/pi.hpp>
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/algorithm/comparators.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+/**
+  * Slow and simple hulls the hull algorithms are checked against.
+  */
+namespace gmt_test {
+
+/*
+ * twice the signed area of `a`, `b` and `c`, exact for integer
+ * coordinates of up to 30 bits
+ */
+template<typename T>
+long long cross(
+	const gmt::point<T, 2>& a,
+	const gmt::point<T, 2>& b,
+	const gmt::point<T, 2>& c)
+{
+	long long abx = (long long)(b.x()) - (long long)(a.x());
+	long long aby = (long long)(b.y()) - (long long)(a.y());
+	long long acx = (long long)(c.x()) - (long long)(a.x());
+	long long acy = (long long)(c.y()) - (long long)(a.y());
+
+	return abx*acy - aby*acx;
+}
+
+template<typename T>
+long long squared_distance(const gmt::point<T, 2>& a, const gmt::point<T, 2>& b)
+{
+	long long dx = (long long)(b.x()) - (long long)(a.x());
+	long long dy = (long long)(b.y()) - (long long)(a.y());
+
+	return dx*dx + dy*dy;
+}
+
+/**
+  * `n` integer points of the grid `[0, range)` with duplicates and
+  * collinear points: the whole grid, a line, a horizontal line or a
+  * circle rounded to the grid, chosen at random.
+  */
+template<typename T, typename generator>
+std::vector<gmt::point<T, 2>> degenerate_points(generator& rng, int n, int range)
+{
+	const int kind = rng()%4;
+
+	std::vector<gmt::point<T, 2>> points;
+
+	for(int i=0; i<n; i++){
+		int x = rng()%range;
+		int y = rng()%range;
+
+		if(kind == 1){
+			y = 2*x + 1;
+		}else if(kind == 2){
+			y = 3;
+		}else if(kind == 3){
+			double a = double(rng()%360)*gmt::pi/180.0;
+			x = int(std::lround(100.0*std::cos(a)));
+			y = int(std::lround(100.0*std::sin(a)));
+		}
+
+		points.push_back(gmt::point<T, 2>{ T(x), T(y) });
+	}
+
+	return points;
+}
+
+/**
+  * Hull of points of integer coordinates by gift wrapping in O(nh), in
+  * counterclockwise order from the lowest of the leftmost points and
+  * without collinear vertices, as the hulls of the library.
+  */
+template<typename T>
+gmt::polygon<T, 2> gift_wrapping(std::vector<gmt::point<T, 2>> points)
+{
+	std::sort(points.begin(), points.end(), gmt::axis_comparator());
+	points.erase(std::unique(points.begin(), points.end()), points.end());
+
+	gmt::polygon<T, 2> hull;
+	if(points.size() <= 1){
+		hull.assign(points.begin(), points.end());
+		return hull;
+	}
+
+	std::size_t current = 0;
+	do{
+		hull.push_back(points[current]);
+
+		/*
+		 * the next vertex has every point on its left, the farthest
+		 * one of the collinear candidates
+		 */
+		std::size_t next = (current == 0) ? 1 : 0;
+		for(std::size_t i=0; i<points.size(); i++){
+			long long c = cross(points[current], points[next], points[i]);
+
+			if(c < 0 || (c == 0 && squared_distance(points[current], points[i])
+					> squared_distance(points[current], points[next])))
+				next = i;
+		}
+
+		current = next;
+	}while(current != 0);
+
+	return hull;
+}
+
+/**
+  * Whether `hull` is the hull of `points` of any coordinates: its
+  * vertices are points, every turn is to the left and no point is on the
+  * right of an edge. The tests are exact.
+  */
+template<typename T>
+bool is_hull_of(const gmt::polygon<T, 2>& hull, const std::vector<gmt::point<T, 2>>& points)
+{
+	const std::size_t h = hull.size();
+
+	if(points.empty())
+		return h == 0;
+	if(h == 0)
+		return false;
+
+	for(const auto& v : hull)
+		if(std::find(points.begin(), points.end(), v) == points.end())
+			return false;
+
+	if(h == 1)
+		return std::all_of(points.begin(), points.end(),
+			[&](const gmt::point<T, 2>& p){ return p == hull[0]; });
+
+	for(std::size_t i=0; i<h; i++){
+		const auto& a = hull[i];
+		const auto& b = hull[(i + 1)%h];
+
+		if(h > 2 && gmt::robust_direction_in(a, b, hull[(i + 2)%h]) != gmt::LEFT)
+			return false;
+
+		for(const auto& p : points)
+			if(gmt::robust_direction_in(a, b, p) == gmt::RIGHT)
+				return false;
+	}
+
+	/*
+	 * two vertices: every point is on their segment
+	 */
+	if(h == 2)
+		return std::all_of(points.begin(), points.end(),
+			[&](const gmt::point<T, 2>& p){
+				return gmt::robust_direction_in(hull[0], hull[1], p) == gmt::ON;
+			});
+
+	return true;
+}
+
+}
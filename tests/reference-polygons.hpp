@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <gmt/pi.hpp>
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/polygon-with-holes.hpp>
+#include <gmt/segment.hpp>
+#include <gmt/triangle-mesh.hpp>
+#include <gmt/algorithm/intersection.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+#include "reference-hull.hpp"
+
+/**
+  * Slow and simple checks of segments, rings and triangulations, by
+  * testing every pair, and random rings to check.
+  */
+namespace gmt_test {
+
+/**
+  * Ring of about `n` vertices of even integer coordinates around
+  * `center`, at increasing angles and radii from `low` to `high`, which
+  * makes many reflex vertices. Some edges get their midpoint, a collinear
+  * vertex, and the ring is in either order. With `n >= 6` there is a
+  * vertex every 60 degrees at least, so the ring holds the disc of
+  * radius `low*cos(30)` around its center. The rounding may still make
+  * a ring that is not simple.
+  */
+template<typename generator>
+gmt::polygon2i random_star(
+	generator& rng,
+	std::size_t n,
+	int low,
+	int high,
+	const gmt::point2i& center = gmt::point2i{ 0, 0 })
+{
+	std::vector<int> angles;
+	if(n >= 6)
+		angles = { 0, 120, 240, 360, 480, 600 };
+
+	while(angles.size() < n){
+		angles.push_back(rng()%720);
+		std::sort(angles.begin(), angles.end());
+		angles.erase(std::unique(angles.begin(), angles.end()), angles.end());
+	}
+
+	gmt::polygon2i star;
+	for(int a : angles){
+		double t = double(a)*gmt::pi/360.0;
+		double r = double(low + int(rng()%(high - low + 1)));
+		star.push_back(gmt::point2i{
+			2*(center.x() + int(std::lround(r*std::cos(t)))),
+			2*(center.y() + int(std::lround(r*std::sin(t)))) });
+	}
+
+	gmt::polygon2i ring;
+	for(std::size_t i=0; i<star.size(); i++){
+		const gmt::point2i& p = star[i];
+		const gmt::point2i& q = star[(i + 1)%star.size()];
+
+		ring.push_back(p);
+		if(rng()%4 == 0)
+			ring.push_back(gmt::point2i{ (p.x() + q.x())/2, (p.y() + q.y())/2 });
+	}
+
+	if(rng()%2)
+		std::reverse(ring.begin(), ring.end());
+
+	return ring;
+}
+
+/*
+ * whether `c`, collinear with `a` and `b`, is on their segment
+ */
+template<typename T>
+bool on_segment(const gmt::point<T, 2>& a, const gmt::point<T, 2>& b, const gmt::point<T, 2>& c)
+{
+	return std::min(a.x(), b.x()) <= c.x() && c.x() <= std::max(a.x(), b.x())
+		&& std::min(a.y(), b.y()) <= c.y() && c.y() <= std::max(a.y(), b.y());
+}
+
+/**
+  * How the closed segments `s` and `t` meet, by exact orientations: they
+  * cross at an interior point of both, they touch or overlap, or they do
+  * not meet. A segment may be a point.
+  */
+template<typename T>
+gmt::intersection::type contact(const gmt::segment<T, 2>& s, const gmt::segment<T, 2>& t)
+{
+	using gmt::ON;
+
+	auto d0 = gmt::robust_direction_in(s.from, s.to, t.from);
+	auto d1 = gmt::robust_direction_in(s.from, s.to, t.to);
+	auto d2 = gmt::robust_direction_in(t.from, t.to, s.from);
+	auto d3 = gmt::robust_direction_in(t.from, t.to, s.to);
+
+	if(d0 != ON && d1 != ON && d2 != ON && d3 != ON && d0 != d1 && d2 != d3)
+		return gmt::intersection::PROPER;
+
+	bool s_point = s.from == s.to;
+	bool t_point = t.from == t.to;
+
+	bool touch;
+	if(s_point && t_point)
+		touch = s.from == t.from;
+	else if(s_point)
+		touch = d2 == ON && on_segment(t.from, t.to, s.from);
+	else if(t_point)
+		touch = d0 == ON && on_segment(s.from, s.to, t.from);
+	else
+		touch = (d0 == ON && on_segment(s.from, s.to, t.from))
+			|| (d1 == ON && on_segment(s.from, s.to, t.to))
+			|| (d2 == ON && on_segment(t.from, t.to, s.from))
+			|| (d3 == ON && on_segment(t.from, t.to, s.to));
+
+	return touch ? gmt::intersection::IMPROPER : gmt::intersection::NONE;
+}
+
+/*
+ * the edges of the rings, in the order of their vertices
+ */
+template<typename T>
+std::vector<gmt::segment<T, 2>> edges_of(const std::vector<gmt::polygon<T, 2>>& rings)
+{
+	std::vector<gmt::segment<T, 2>> edges;
+
+	for(const auto& ring : rings)
+		for(std::size_t i=0; i<ring.size(); i++)
+			edges.emplace_back(ring[i], ring[(i + 1)%ring.size()]);
+
+	return edges;
+}
+
+/**
+  * Whether the rings are simple and do not meet, in O(n^2): every ring
+  * has three vertices, two edges that are not consecutive in a ring do
+  * not meet, and two consecutive ones meet only in their shared vertex.
+  */
+template<typename T>
+bool are_simple(const std::vector<gmt::polygon<T, 2>>& rings)
+{
+	std::vector<gmt::segment<T, 2>> edges = edges_of(rings);
+	std::vector<std::size_t> next;
+
+	for(const auto& ring : rings){
+		if(ring.size() < 3)
+			return false;
+
+		std::size_t offset = next.size();
+		for(std::size_t i=0; i<ring.size(); i++)
+			next.push_back(offset + (i + 1)%ring.size());
+	}
+
+	for(std::size_t i=0; i<edges.size(); i++){
+		for(std::size_t j=i+1; j<edges.size(); j++){
+			auto type = contact(edges[i], edges[j]);
+
+			if(type == gmt::intersection::NONE)
+				continue;
+			if(type == gmt::intersection::PROPER || (next[i] != j && next[j] != i))
+				return false;
+
+			/*
+			 * consecutive edges: one of them is a point, or they go
+			 * back over each other
+			 */
+			const auto& s = (next[i] == j) ? edges[i] : edges[j];
+			const auto& t = (next[i] == j) ? edges[j] : edges[i];
+
+			if(s.from == s.to || t.from == t.to)
+				return false;
+			if(gmt::robust_direction_in(s.from, s.to, t.to) == gmt::ON
+				&& (on_segment(s.from, s.to, t.to) || on_segment(t.from, t.to, s.from)))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * twice the signed area of a ring of integer coordinates, exactly
+ */
+template<typename T>
+long long twice_area(const gmt::polygon<T, 2>& ring)
+{
+	long long a = 0;
+	for(std::size_t i=1; i+1<ring.size(); i++)
+		a += cross(ring[0], ring[i], ring[i + 1]);
+
+	return a;
+}
+
+/**
+  * Whether the triangles of `mesh` tile the polygon of integer
+  * coordinates bounded by the `rings`, the first one the boundary, the
+  * others its holes: every triangle has its vertices among the ones of
+  * the rings, turns counterclockwise and crosses no edge, and their
+  * areas add up to the one of the polygon, exactly.
+  */
+template<typename T>
+bool is_triangulation_of(
+	const gmt::triangle_mesh<T, 2>& mesh,
+	const std::vector<gmt::polygon<T, 2>>& rings)
+{
+	std::vector<gmt::segment<T, 2>> edges = edges_of(rings);
+
+	long long area = std::llabs(twice_area(rings[0]));
+	for(std::size_t r=1; r<rings.size(); r++)
+		area -= std::llabs(twice_area(rings[r]));
+
+	long long sum = 0;
+	for(std::size_t f=0; f<mesh.size(); f++){
+		for(std::size_t v : mesh.triangles[f])
+			if(v >= mesh.vertices.size())
+				return false;
+
+		auto corners = mesh.corners(f);
+
+		for(const auto& p : corners)
+			if(std::none_of(rings.begin(), rings.end(), [&](const gmt::polygon<T, 2>& ring){
+					return std::find(ring.begin(), ring.end(), p) != ring.end(); }))
+				return false;
+
+		long long c = cross(corners[0], corners[1], corners[2]);
+		if(c <= 0)
+			return false;
+		sum += c;
+
+		for(int k=0; k<3; k++){
+			gmt::segment<T, 2> side(corners[k], corners[(k + 1)%3]);
+
+			for(const auto& e : edges)
+				if(contact(side, e) == gmt::intersection::PROPER)
+					return false;
+		}
+	}
+
+	return sum == area;
+}
+
+}
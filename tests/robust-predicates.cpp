@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/polygon.hpp>
+#include <gmt/point-buffer.hpp>
+#include <gmt/algorithm/misc.hpp>
+#include <gmt/algorithm/robust-predicates.hpp>
+
+#include "check.hpp"
+
+using namespace gmt;
+
+/*
+ * the signs are checked against determinants of integer coordinates,
+ * which are exact in `wide_int`
+ */
+constexpr int coordinate_bits = sizeof(wide_int) > 8 ? 50 : 29;
+constexpr int circle_bits = sizeof(wide_int) > 8 ? 20 : 12;
+
+template<typename V>
+int sign(V v)
+{
+	return (v > 0) - (v < 0);
+}
+
+std::mt19937_64 rng(7);
+
+long long random_in(long long range)
+{
+	return (long long)(rng() % std::uint64_t(2*range)) - range;
+}
+
+/*
+ * near-collinear points of large integer coordinates: `c` is on the line
+ * of `a` and `b` or one unit off it
+ */
+void test_orient2d()
+{
+	const long long range = 1LL << (coordinate_bits - 1);
+
+	for(int t=0; t<100000; t++){
+		long long ax = random_in(range/2), ay = random_in(range/2);
+		long long dx = random_in(500), dy = random_in(500);
+		long long k = rng()%1000000, m = rng()%1000000;
+
+		long long bx = ax + dx*k, by = ay + dy*k;
+		long long cx = ax + dx*m, cy = ay + dy*m;
+
+		if(t%3 != 0){
+			cx += random_in(2);
+			cy += random_in(2);
+		}
+
+		point2d a{ double(ax), double(ay) };
+		point2d b{ double(bx), double(by) };
+		point2d c{ double(cx), double(cy) };
+
+		wide_int exact = wide_int(bx - ax)*(cy - ay) - wide_int(by - ay)*(cx - ax);
+
+		CHECK(sign(orient2d(a, b, c)) == sign(exact));
+		CHECK(robust_direction_in(a, b, c)
+			== (exact > 0 ? LEFT : (exact < 0 ? RIGHT : ON)));
+	}
+}
+
+/*
+ * points of a line whose coordinates are not exact: the sign must change
+ * with the parity of the permutation
+ */
+void test_orient2d_permutations()
+{
+	for(int t=0; t<100000; t++){
+		double x0 = double(rng()%1000)/7.0;
+		double x1 = x0 + double(rng()%1000 + 1)/3.0;
+		double x2 = x0 + double(rng()%1000)/11.0;
+
+		point2d a{ x0, 0.1*x0 + 0.3 };
+		point2d b{ x1, 0.1*x1 + 0.3 };
+		point2d c{ x2, 0.1*x2 + 0.3 };
+
+		int s = sign(orient2d(a, b, c));
+
+		CHECK(sign(orient2d(b, c, a)) == s);
+		CHECK(sign(orient2d(c, a, b)) == s);
+		CHECK(sign(orient2d(b, a, c)) == -s);
+	}
+}
+
+/*
+ * random and cocircular integer points, from the Pythagorean points of
+ * a circle of radius 25 scaled and moved
+ */
+void test_incircle()
+{
+	static const int circle[12][2] = {
+		{ 25, 0 }, { 0, 25 }, { -25, 0 }, { 0, -25 },
+		{ 7, 24 }, { 24, 7 }, { -7, 24 }, { -24, -7 },
+		{ 15, 20 }, { 20, -15 }, { -15, -20 }, { -20, 15 }
+	};
+
+	const long long range = 1LL << circle_bits;
+
+	for(int t=0; t<100000; t++){
+		long long p[4][2];
+
+		if(t%2 == 0){
+			long long s = rng()%(range/64) + 1;
+			long long ox = random_in(range/4), oy = random_in(range/4);
+
+			for(int i=0; i<4; i++){
+				int j = rng()%12;
+				p[i][0] = ox + circle[j][0]*s;
+				p[i][1] = oy + circle[j][1]*s;
+			}
+
+			if(t%4 == 0)
+				p[3][0] += random_in(2);
+		}else{
+			for(int i=0; i<4; i++){
+				p[i][0] = random_in(range);
+				p[i][1] = random_in(range);
+			}
+		}
+
+		point2d q[4];
+		for(int i=0; i<4; i++)
+			q[i] = point2d{ double(p[i][0]), double(p[i][1]) };
+
+		wide_int adx = p[0][0] - p[3][0], ady = p[0][1] - p[3][1];
+		wide_int bdx = p[1][0] - p[3][0], bdy = p[1][1] - p[3][1];
+		wide_int cdx = p[2][0] - p[3][0], cdy = p[2][1] - p[3][1];
+
+		wide_int exact = (adx*adx + ady*ady)*(bdx*cdy - cdx*bdy)
+			+ (bdx*bdx + bdy*bdy)*(cdx*ady - adx*cdy)
+			+ (cdx*cdx + cdy*cdy)*(adx*bdy - bdx*ady);
+
+		CHECK(sign(incircle(q[0], q[1], q[2], q[3])) == sign(exact));
+	}
+}
+
+/*
+ * the batches must give the answers of the scalar predicate with every
+ * kernel, on points of a line with inexact coordinates
+ */
+void test_batches()
+{
+	const simd_isa isas[] = { SCALAR, SSE2, AVX2, AVX512 };
+
+	/*
+	 * an instruction set the processor lacks falls back to one it has
+	 */
+	for(simd_isa isa : isas){
+		set_direction_batch_isa(isa);
+
+		for(int t=0; t<200; t++){
+			const std::size_t n = 1 + rng()%600;
+
+			point2d p0{ 0.1*double(rng()%100), 0.3 };
+			point2d p1{ p0.x() + 1.0/3.0, 0.4 };
+
+			polygon2d poly;
+			point_buffer2d buffer;
+
+			for(std::size_t i=0; i<n; i++){
+				double x = double(rng()%1000)/7.0;
+				point2d p{ x, 0.3 + (x - p0.x())*(0.1/(1.0/3.0)) };
+
+				if(rng()%4 == 0)
+					p.y() += 1e-15;
+				if(rng()%3 == 0)
+					p = point2d{ double(rng()%50), double(rng()%50) };
+
+				poly.push_back(p);
+				buffer.push_back(p);
+			}
+
+			robust_predicates predicates;
+			std::vector<packed_direction> out(n), out_buffer(n);
+
+			predicates.orientation_batch(p0, p1, poly.data(), n, out.data());
+			predicates.orientation_batch(p0, p1, buffer, out_buffer.data());
+
+			for(std::size_t i=0; i<n; i++){
+				direction d = robust_direction_in(p0, p1, poly[i]);
+				CHECK(out[i] == d);
+				CHECK(out_buffer[i] == d);
+			}
+
+			/*
+			 * the windows of the ring wrap around its closing edge
+			 */
+			for(std::size_t first=0; first<n; first += direction_block){
+				std::size_t count = std::min(direction_block, n - first);
+
+				predicates.ring_orientation_batch(poly.data(), n, first, count, p0, out.data());
+				predicates.ring_orientation_batch(buffer, first, count, p0, out_buffer.data());
+
+				for(std::size_t k=0; k<count; k++){
+					direction d = robust_direction_in(
+						poly[first + k], poly[(first + k + 1)%n], p0);
+					CHECK(out[k] == d);
+					CHECK(out_buffer[k] == d);
+				}
+			}
+		}
+	}
+}
+
+int main()
+{
+	test_orient2d();
+	test_orient2d_permutations();
+	test_incircle();
+	test_batches();
+
+	return gmt_test::exit_code();
+}
@@ -0,0 +1,170 @@
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gmt/point.hpp>
+#include <gmt/segment.hpp>
+#include <gmt/algorithm/intersection.hpp>
+#include <gmt/algorithm/segment-intersections.hpp>
+
+#include "check.hpp"
+#include "reference-polygons.hpp"
+
+using namespace gmt;
+
+std::mt19937 rng(23);
+
+/*
+ * every pair is found once, with its type, and no other: the pairs of
+ * the sweep are compared with the ones of all the pairs of segments
+ */
+template<typename T>
+void check_pairs(segment_intersector<T>& sweep, const std::vector<segment<T, 2>>& segments)
+{
+	std::map<std::pair<std::size_t, std::size_t>, intersection::type> found;
+
+	bool done = sweep.find(segments, [&](std::size_t i, std::size_t j, intersection::type type){
+		CHECK(i < j);
+		CHECK(found.count({ i, j }) == 0);
+		found[{ i, j }] = type;
+	});
+
+	CHECK(done);
+
+	std::size_t n_pairs = 0;
+	for(std::size_t i=0; i<segments.size(); i++){
+		for(std::size_t j=i+1; j<segments.size(); j++){
+			auto type = gmt_test::contact(segments[i], segments[j]);
+			if(type == intersection::NONE)
+				continue;
+
+			n_pairs++;
+
+			auto it = found.find({ i, j });
+			CHECK(it != found.end() && it->second == type);
+		}
+	}
+
+	CHECK(found.size() == n_pairs);
+	CHECK(segment_intersections(segments).size() == n_pairs);
+
+	/*
+	 * the search stops at the first pair when `report` says so
+	 */
+	std::size_t calls = 0;
+	bool stopped = !for_each_intersection(segments, [&](std::size_t, std::size_t, intersection::type){
+		calls++;
+		return false;
+	});
+
+	CHECK(stopped == (n_pairs > 0));
+	CHECK(calls == (n_pairs > 0 ? 1 : 0));
+}
+
+/*
+ * segments of a small grid: shared endpoints, points, overlaps and
+ * several segments through a point, found by the same sweep in turn
+ */
+void test_grid_segments()
+{
+	segment_intersector<int> sweep;
+
+	for(int t=0; t<20000; t++){
+		const int range = 2 + rng()%8;
+		const std::size_t n = 1 + rng()%25;
+
+		std::vector<segment2i> segments;
+		for(std::size_t i=0; i<n; i++){
+			point2i a{ int(rng()%range), int(rng()%range) };
+			point2i b{ int(rng()%range), int(rng()%range) };
+
+			if(rng()%8 == 0)
+				b = a;
+
+			segments.emplace_back(a, b);
+		}
+
+		check_pairs(sweep, segments);
+	}
+}
+
+/*
+ * short real segments in the unit square, whose crossings are
+ * approximated to order their events
+ */
+void test_real_segments()
+{
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	segment_intersector<double> sweep;
+
+	for(int t=0; t<2000; t++){
+		const std::size_t n = 2 + rng()%((t%50 == 0) ? 1000 : 60);
+		const double length = 0.3*uniform(rng);
+
+		std::vector<segment2d> segments;
+		for(std::size_t i=0; i<n; i++){
+			point2d a{ uniform(rng), uniform(rng) };
+			double angle = 6.3*uniform(rng);
+			double l = length*uniform(rng);
+
+			/*
+			 * some vertical segments, and some that start on the
+			 * previous one
+			 */
+			if(rng()%10 == 0)
+				segments.emplace_back(a, point2d{ a.x(), a.y() + l });
+			else if(!segments.empty() && rng()%10 == 0)
+				segments.emplace_back(segments.back().from, point2d{ a.x(), a.y() });
+			else
+				segments.emplace_back(a, point2d{ a.x() + l*std::cos(angle), a.y() + l*std::sin(angle) });
+		}
+
+		check_pairs(sweep, segments);
+	}
+}
+
+/*
+ * segments in a square of a few hundred representable points, whose
+ * crossings are closer to each other and to the endpoints than their
+ * rounding: their events are ordered exactly
+ */
+void test_clustered_segments()
+{
+	std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+	segment_intersector<double> sweep;
+
+	auto near = [&](){
+		return point2d{ 0.5 + 1e-14*uniform(rng), 0.5 + 1e-14*uniform(rng) };
+	};
+
+	for(int t=0; t<3000; t++){
+		const std::size_t n = 2 + rng()%12;
+
+		std::vector<segment2d> segments;
+		for(std::size_t i=0; i<n; i++)
+			segments.emplace_back(near(), near());
+
+		check_pairs(sweep, segments);
+	}
+
+	/*
+	 * the crossing of the last two segments was taken after the
+	 * endpoint events past it by its rounded point, and lost
+	 */
+	check_pairs(sweep, std::vector<segment2d>{
+		segment2d(point2d{ .50000000000000366, .50000000000000389 }, point2d{ .49999999999999878, .500000000000006 }),
+		segment2d(point2d{ .50000000000000278, .50000000000000833 }, point2d{ .50000000000000377, .50000000000000588 }),
+		segment2d(point2d{ .50000000000000344, .50000000000000666 }, point2d{ .50000000000000633, .50000000000000644 }),
+		segment2d(point2d{ .50000000000000466, .50000000000000822 }, point2d{ .50000000000000266, .50000000000000555 }) });
+}
+
+int main()
+{
+	test_grid_segments();
+	test_real_segments();
+	test_clustered_segments();
+
+	return gmt_test::exit_code();
+}